@@ -1,12 +1,15 @@
 #include "attributes.hpp"
 
+#include <stdexcept>
+
+#include "byte_reader.hpp"
 #include "class_file_parser.h"
 
 namespace jvm::class_loader {
 
 void GenericAttribute::readInfo(ClassFileParser& parser) {
-  // Read the raw bytes based on the attribute_length set by the factory
-  info = parser.getReader().readBytes(length);
+  // Refer to the raw bytes based on the attribute_length set by the factory, without copying
+  info = parser.getReader().readSpan(length);
 }
 
 void ConstantValueAttribute::readInfo(ClassFileParser& parser) {
@@ -38,22 +41,61 @@ void BootstrapMethodsAttribute::readInfo(ClassFileParser& parser) {
   }
 }
 
+namespace {
+
+// Whether `info` holds a whole Code attribute body (JVMS §4.7.3): code of 1 to 65535 bytes,
+// then the exception table and the nested attributes, ending exactly where the body does
+bool isWellFormedCode(std::span<const U1> info) {
+  constexpr U4 kMaxCodeLength = 65535;
+  constexpr U4 kHandlerSize   = 8;
+  ByteReader   reader(info);
+  try {
+    reader.read<U2>();  // max_stack
+    reader.read<U2>();  // max_locals
+    U4 code_length = reader.read<U4>();
+    if (code_length == 0 || code_length > kMaxCodeLength) {
+      return false;
+    }
+    reader.readSpan(code_length);
+    reader.readSpan(size_t{reader.read<U2>()} * kHandlerSize);
+    for (U2 count = reader.read<U2>(); count > 0; count--) {
+      reader.read<U2>();  // attribute_name_index
+      reader.readSpan(reader.read<U4>());
+    }
+  } catch (const std::out_of_range&) {
+    return false;
+  }
+  return reader.remaining() == 0;
+}
+
+}  // namespace
+
 void CodeAttribute::readInfo(ClassFileParser& parser) {
-  max_stack           = parser.getReader().read<U2>();
-  max_locals          = parser.getReader().read<U2>();
-  code_length         = parser.getReader().read<U4>();
-  code                = parser.getReader().readBytes(code_length);
-  num_exception_table = parser.getReader().read<U2>();
-  exception_table     = std::vector<ExceptionTableEntry>(num_exception_table);
-  for (int i = 0; i < num_exception_table; ++i) {
-    exception_table[i] = {
-      .start_pc   = parser.getReader().read<U2>(),
-      .end_pc     = parser.getReader().read<U2>(),
-      .handler_pc = parser.getReader().read<U2>(),
-      .catch_type = parser.getReader().read<U2>(),
+  info = parser.getReader().readSpan(length);
+  // checked here so that a malformed method fails its class at load rather than at its first
+  // invocation, when decode() reads the body
+  if (!isWellFormedCode(info)) {
+    throw std::runtime_error("Malformed Code attribute");
+  }
+}
+
+CodeAttribute::Body CodeAttribute::decode(std::span<const U1> info) {
+  ByteReader reader(info);
+  Body       body{};
+  body.max_stack  = reader.read<U2>();
+  body.max_locals = reader.read<U2>();
+  body.code       = reader.readSpan(reader.read<U4>());
+  body.exception_table.resize(reader.read<U2>());
+  for (auto& entry : body.exception_table) {
+    entry = {
+      .start_pc   = reader.read<U2>(),
+      .end_pc     = reader.read<U2>(),
+      .handler_pc = reader.read<U2>(),
+      .catch_type = reader.read<U2>(),
     };
   }
-  attributes = parser.parseAttributes();
+  // the nested attributes (LineNumberTable, StackMapTable, ...) are not used at run time
+  return body;
 }
 
 }  // namespace jvm::class_loader
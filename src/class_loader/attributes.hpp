@@ -11,6 +11,9 @@
  */
 #pragma once
 
+#include <memory>
+#include <span>
+#include <string>
 #include <vector>
 
 #include "common/types.h"
@@ -66,8 +69,9 @@ class AttributeTable {
 
 class GenericAttribute : public AttributeInfo {
  public:
-  void            readInfo(ClassFileParser& parser) override;
-  std::vector<U1> info;
+  void readInfo(ClassFileParser& parser) override;
+  // A view into the parser's input, which the ClassFile keeps alive (see ClassFile::source)
+  std::span<const U1> info;
 };
 
 // The ConstantValueAttribute class
@@ -108,24 +112,31 @@ struct ExceptionTableEntry {
   U2 catch_type;
 };
 
+// Parsing a Code attribute only records where its body is: most methods of a loaded class
+// never run, so their code is neither copied nor decoded. The runtime decodes the body with
+// decode() when the method is first invoked (see runtime::Method).
 class CodeAttribute : public AttributeInfo {
  public:
-  void readInfo(ClassFileParser& parser) override;
-
-  // --- Member Variables ---
-  U2 max_stack;   // Maximum depth of the operand stack
-  U2 max_locals;  // Number of local variables
+  // A decoded body; `code` views the same bytes as `info`
+  struct Body {
+    U2                               max_stack;   // Maximum depth of the operand stack
+    U2                               max_locals;  // Number of local variables
+    std::span<const U1>              code;
+    std::vector<ExceptionTableEntry> exception_table;
+  };
 
-  // The actual bytecode
-  U4              code_length;
-  std::vector<U1> code;
+  // @throws std::runtime_error if the lengths in the body do not add up to the attribute's
+  void readInfo(ClassFileParser& parser) override;
 
-  // The exception handler table
-  U2                               num_exception_table;
-  std::vector<ExceptionTableEntry> exception_table;
+  /**
+   * @brief Decodes a body recorded by readInfo, which checked its lengths; nested attributes
+   * are not decoded
+   * @throws std::out_of_range if the body is truncated
+   */
+  static Body decode(std::span<const U1> info);
 
-  // Nested attributes
-  AttributeTable attributes;
+  // The attribute body, a view into the parsed bytes (see ClassFile::source)
+  std::span<const U1> info;
 };
 
 }  // namespace jvm::class_loader
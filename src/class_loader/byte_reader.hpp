@@ -10,7 +10,10 @@
  */
 #pragma once
 
+#include <cstring>
 #include <span>
+#include <stdexcept>
+#include <vector>
 
 #include "common/endian.hpp"
 
@@ -21,7 +24,7 @@ class ByteReader {
    * @brief Construct a new ByteReader object
    * @param data Data to read from, not owned by the ByteReader
    */
-  explicit ByteReader(std::span<U1> data) : data_(data) {}
+  explicit ByteReader(std::span<const U1> data) : data_(data) {}
 
   /**
    * @brief Read a value of type T
@@ -51,6 +54,18 @@ class ByteReader {
     pos_ += count;
   }
 
+  /**
+   * @brief Read bytes without copying them
+   * @param count Number of bytes to read
+   * @return View into the data being read, valid as long as that data is
+   */
+  std::span<const U1> readSpan(size_t count) {
+    checkBounds(count);
+    auto span = data_.subspan(pos_, count);
+    pos_ += count;
+    return span;
+  }
+
   /**
    * @brief Read bytes into a vector
    * @param count Number of bytes to read
@@ -64,6 +79,9 @@ class ByteReader {
     return buffer;
   }
 
+  // Bytes left to read
+  size_t remaining() const { return data_.size() - pos_; }
+
  private:
   void checkBounds(size_t n) {
     if (pos_ + n > data_.size()) {
@@ -72,8 +90,8 @@ class ByteReader {
   }
 
   // stateful parsing
-  std::span<U1> data_;
-  size_t        pos_{};
+  std::span<const U1> data_;
+  size_t              pos_{};
 };
 
 }  // namespace jvm::class_loader
\ No newline at end of file
@@ -14,6 +14,7 @@
 #include "common/access_flags.hpp"
 #include "common/types.h"
 #include "constant_pool.h"
+#include "mapped_file.h"
 #include "members.h"
 #include "version.h"
 
@@ -43,6 +44,19 @@ class ClassFile {
   ClassFile& operator=(ClassFile&&)      = default;
   ~ClassFile()                           = default;
 
+  /**
+   * @brief Frees the member and attribute tables, once the class is prepared and its Klass
+   * holds its members. What stays is what a linked class still reads: the header fields, the
+   * constant pool (a tag and 8 bytes per entry, nothing of the file), and `source`, which the
+   * Code attributes of methods not run yet view. The Klass releases `source` once the last of
+   * them is decoded.
+   */
+  void compact() {
+    fields     = MemberTable({});
+    methods    = MemberTable({});
+    attributes = AttributeTable();
+  }
+
   Version                   version;
   ConstantPool              constant_pool;
   AccessFlags<flags::Class> access_flags;
@@ -53,6 +67,10 @@ class ClassFile {
   MemberTable               fields;
   MemberTable               methods;
   AttributeTable            attributes;
+
+  // The bytes the class file was parsed from when the class loader read it; views such as
+  // GenericAttribute::info point into them. Empty when the caller parsed a buffer it owns.
+  ClassBytes source;
 };
 
 }  // namespace jvm::class_loader
\ No newline at end of file
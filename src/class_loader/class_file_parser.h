@@ -23,7 +23,7 @@ class ClassFileParser {
    * @brief Construct a new ClassFileParser object
    * @param data Data to parse, not owned by the ClassFileParser
    */
-  explicit ClassFileParser(std::span<U1> data) : reader_(data) {}
+  explicit ClassFileParser(std::span<const U1> data) : reader_(data) {}
 
   /**
    * @brief A factory method to parse the class file
@@ -43,7 +43,6 @@ class ClassFileParser {
   MemberTable               parseMethods();
   AttributeTable            parseAttributes();
 
-  std::unique_ptr<ConstantInfo>  createConstantInfo();
   std::unique_ptr<AttributeInfo> createAttributeInfo();
   std::unique_ptr<FieldInfo>     createFieldInfo();
   std::unique_ptr<MethodInfo>    createMethodInfo();
@@ -1,8 +1,6 @@
 #include "class_loader.h"
 
 #include <algorithm>
-#include <filesystem>
-#include <fstream>
 #include <iostream>
 #include <optional>
 #include <span>
@@ -11,50 +9,84 @@
 #include "class_file_parser.h"
 #include "runtime/klass.h"
 #include "runtime/method_area.h"
+#include "runtime/vm_options.h"
+#include "runtime/well_known_classes.h"
 
 namespace jvm::class_loader {
 
+ClassLoader::ClassLoader(ClassLoader* parent, std::vector<std::string> classpaths)
+  : parent_(parent), classpaths_(std::move(classpaths)), classpath_(classpaths_) {
+  // constructed first, the method area is destroyed last, even after static class loaders
+  runtime::MethodArea::getInstance();
+  openSharedArchive();
+}
+
+ClassLoader::~ClassLoader() {
+  const auto& options = runtime::VMOptions::getInstance();
+  if (options.share_mode == runtime::ShareMode::kDump && !options.shared_archive_file.empty() &&
+      !classpaths_.empty()) {
+    // the application's loader writes what the run loaded; a failed dump must not abort exit
+    try {
+      dumpSharedArchive(options.shared_archive_file);
+    } catch (const std::runtime_error& error) {
+      std::cerr << error.what() << '\n';
+    }
+  }
+  // no worker may still be parsing for this loader
+  prefetcher_.reset();
+  runtime::MethodArea::getInstance().unloadClasses(this);
+}
+
+void ClassLoader::openSharedArchive() {
+  const auto& options = runtime::VMOptions::getInstance();
+  if (options.shared_archive_file.empty() ||
+      (options.share_mode != runtime::ShareMode::kAuto &&
+       options.share_mode != runtime::ShareMode::kOn)) {
+    return;
+  }
+
+  const bool required = options.share_mode == runtime::ShareMode::kOn;
+  try {
+    auto archive = SharedArchive::open(options.shared_archive_file);
+    if (archive == nullptr) {
+      throw std::runtime_error("Shared archive " + options.shared_archive_file + " not found");
+    }
+    if (!archive->matchesClasspath(classpaths_)) {
+      // another application's archive, or one whose classes have changed since; the bootstrap
+      // loader's classpath never matches an application's either
+      if (required && !classpaths_.empty()) {
+        throw std::runtime_error("Shared archive " + options.shared_archive_file +
+                                 " does not match the classpath");
+      }
+      return;
+    }
+    archive_ = std::move(archive);
+  } catch (const std::runtime_error&) {
+    if (required) {
+      throw;
+    }
+  }
+}
+
 /**
  * @brief Reads a class file from the classpath and returns its binary content
  *
  * This method searches for a class file by converting the class name to a file path
  * (replacing dots with forward slashes and appending .class extension) and looking
- * through all configured classpath directories.
+ * through all configured classpath directories and JAR files.
  *
  * @param name The fully qualified class name (e.g., "java.lang.String")
- * @return std::optional<std::vector<std::byte>> The binary content of the class file if found,
- *         std::nullopt if the class file could not be located or read
+ * @return std::optional<ClassBytes> The class file if found, mapped into memory or inflated
+ *         from its JAR, std::nullopt if the class file could not be located or read
  *
  * @note The method searches through classpaths in order and returns the first match found
  * @note Class names are converted to file paths by replacing '.' with '/' and adding '.class'
+ * @note Lookups go through the classpath index: the first class of a package lists that
+ *       package once per classpath entry, later ones and misses cost a hash lookup
+ * @note The file is mapped rather than read, so a hit costs no copy unless it is compressed
  */
-std::optional<std::vector<std::byte>> ClassLoader::readClassFile(const std::string& name) {
-  // Convert class name to file path (e.g., "java.lang.String" -> "java/lang/String.class")
-  std::string relative_path = name;
-  std::ranges::replace(relative_path, '.', '/');
-  relative_path.append(".class");
-
-  // Search through all configured classpath directories
-  for (const auto& classpath : classpaths_) {
-    std::filesystem::path full_path = std::filesystem::path(classpath) / relative_path;
-    if (std::filesystem::exists(full_path) && std::filesystem::is_regular_file(full_path)) {
-      // Open file in binary mode and get file size
-      std::ifstream file(full_path, std::ios::binary | std::ios::ate);
-      if (!file) {
-        continue;
-      }
-      std::streamsize size = file.tellg();
-      if (size < 0) {
-        continue;
-      }
-      file.seekg(0, std::ios::beg);
-      std::vector<std::byte> buffer(static_cast<size_t>(size));
-      if (file.read(std::bit_cast<char*>(buffer.data()), size)) {
-        return buffer;
-      }
-    }
-  }
-  return std::nullopt;
+std::optional<ClassBytes> ClassLoader::readClassFile(const std::string& name) {
+  return classpath_.read(name);
 }
 
 /**
@@ -75,17 +107,20 @@ std::optional<std::vector<std::byte>> ClassLoader::readClassFile(const std::stri
 // NOLINTNEXTLINE(misc-no-recursion)
 runtime::Klass* ClassLoader::defineClass(std::unique_ptr<class_loader::ClassFile> class_file,
                                          const std::string&                       name) {
-  // Create new Klass object from the parsed class file
-  auto            klass     = std::make_unique<runtime::Klass>(class_file.get(), this);
-  runtime::Klass* klass_ptr = klass.get();
+  // Create new Klass object from the parsed class file, in this loader's metaspace
+  auto* klass = metaspace_.create<runtime::Klass>(class_file.get(), this);
 
-  linkSuperClass(klass_ptr);
-  linkInterfaces(klass_ptr);
+  linkSuperClass(klass);
+  linkInterfaces(klass);
+  klass->linkSupertypes();
 
-  // Register the class in the method area with this class loader
-  runtime::MethodArea::getInstance().addClass(
-    std::make_pair(this, name), std::make_pair(std::move(klass), std::move(class_file)));
-  return klass_ptr;
+  // Register the class in the method area with this class loader. The caller holds the
+  // placeholder of `name`, so another definition means the loader lost track of it.
+  if (!runtime::MethodArea::getInstance().addClass(
+        std::make_pair(this, name), std::make_pair(klass, std::move(class_file)))) {
+    throw std::runtime_error("Class " + name + " is already defined by this loader");
+  }
+  return klass;
 }
 
 // NOLINTNEXTLINE(misc-no-recursion)
@@ -115,14 +150,47 @@ void ClassLoader::linkSuperClass(runtime::Klass* klass) {
 
 // NOLINTNEXTLINE(misc-no-recursion)
 void ClassLoader::linkInterfaces(runtime::Klass* klass) {
-  auto        interfaces = klass->getClassFile()->interfaces;
+  const auto& interfaces = klass->getClassFile()->interfaces;
   const auto& cp         = klass->getClassFile()->constant_pool;
-  for (auto& interface_index : interfaces) {
-    std::string interface_name = cp.getClassName(interface_index);
+  for (U2 i = 0; i < interfaces.size(); i++) {
+    std::string interface_name = cp.getClassName(interfaces[i]);
     std::replace(interface_name.begin(), interface_name.end(), '/', '.');
     auto* interface_klass = loadClass(interface_name);
-    klass->setInterface(interface_index, interface_klass);
+    klass->setInterface(i, interface_klass);
+  }
+}
+
+/**
+ * @brief Reads and parses the class file of `name`
+ * @return nullptr if the class file could not be located
+ */
+std::unique_ptr<ClassFile> ClassLoader::fetchClassFile(const std::string& name) {
+  auto class_file_data = readClassFile(name);
+  if (!class_file_data) {
+    return nullptr;
   }
+  auto parser     = ClassFileParser(class_file_data->getBytes());
+  auto class_file = parser.parse();
+  // keep the mapping alive for the views the parser left into it
+  class_file->source = std::move(class_file_data.value());
+  return class_file;
+}
+
+/**
+ * @brief The worker pool that parses referenced classes ahead of their loading, started on
+ * first use
+ * @return nullptr if parallel class loading is disabled
+ */
+ClassPrefetcher* ClassLoader::getPrefetcher() {
+  std::call_once(prefetcher_once_, [this] {
+    const auto& options = runtime::VMOptions::getInstance();
+    if (!options.parallel_class_loading) {
+      return;
+    }
+    prefetcher_ = std::make_unique<ClassPrefetcher>(
+      [this](const std::string& name) { return fetchClassFile(name); });
+  });
+  return prefetcher_.get();
 }
 
 /**
@@ -134,43 +202,165 @@ void ClassLoader::linkInterfaces(runtime::Klass* klass) {
  * access.
  *
  * @param fully_qualified_name The fully qualified class name to load (e.g., "java.lang.String")
- * @return runtime::Klass* A pointer to the loaded Klass object, or nullptr if the
- *         class could not be found or loaded
+ * @return runtime::Klass* A pointer to the loaded Klass object
+ * @throws std::runtime_error if the class cannot be found, or is its own superclass or
+ *         superinterface
  *
  * @note This method implements caching - subsequent calls with the same name return
  *       the cached Klass object without re-parsing the class file
- * @note If the class file cannot be found, an error message is printed to stderr
- * @note The method handles the complete class loading process: file reading, parsing,
- *       and Klass object creation
+ * @note Safe to call from several threads: a class is defined once, by the first thread to
+ *       ask for it, and the others wait for it
  */
 // NOLINTNEXTLINE(misc-no-recursion)
 runtime::Klass* ClassLoader::loadClass(const std::string& fully_qualified_name) {
-  // Check cache first to avoid re-loading already loaded classes
-  if (cache_.find(fully_qualified_name) != cache_.end()) {
-    return cache_[fully_qualified_name];
+  {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      // Check cache first to avoid re-loading already loaded classes
+      if (auto it = cache_.find(fully_qualified_name); it != cache_.end()) {
+        return it->second;
+      }
+      auto loading = loading_.find(fully_qualified_name);
+      if (loading == loading_.end()) {
+        break;
+      }
+      if (loading->second == std::this_thread::get_id()) {
+        // linking reached the class being loaded again
+        throw std::runtime_error("Class circularity: " + fully_qualified_name);
+      }
+      loaded_.wait(lock);
+    }
+    loading_.emplace(fully_qualified_name, std::this_thread::get_id());
   }
 
-  // Read class file from classpath
-  auto class_file_data = readClassFile(fully_qualified_name);
-  if (!class_file_data) {
-    throw std::runtime_error("Class " + fully_qualified_name + " not found");
+  runtime::Klass* klass = nullptr;
+  try {
+    klass = defineAndPrepare(fully_qualified_name);
+  } catch (...) {
+    // a class defined but not prepared is dropped with its class file, so that loading it
+    // again starts over instead of finding the half-built class
+    runtime::MethodArea::getInstance().removeClass(this, fully_qualified_name);
+    finishLoading(fully_qualified_name, nullptr);
+    throw;
   }
 
-  // Parse the class file and create Klass object
-  auto parser = ClassFileParser(std::span<U1>(std::bit_cast<U1*>(class_file_data.value().data()),
-                                              class_file_data.value().size()));
-  auto class_file = parser.parse();
+  // Cache the loaded class for future access
+  finishLoading(fully_qualified_name, klass);
+  return klass;
+}
+
+/**
+ * @brief Removes the placeholder of `name`, caching `klass` unless the load failed, and wakes
+ * the threads waiting for it. Once the outermost load of this thread is done, what the
+ * prefetcher parsed for it and nobody took is dropped.
+ */
+void ClassLoader::finishLoading(const std::string& name, runtime::Klass* klass) {
+  bool outermost = false;
+  {
+    std::lock_guard lock(mutex_);
+    if (klass != nullptr) {
+      cache_.emplace(name, klass);
+    }
+    loading_.erase(name);
+    outermost = std::ranges::none_of(loading_, [](const auto& placeholder) {
+      return placeholder.second == std::this_thread::get_id();
+    });
+  }
+  loaded_.notify_all();
+  if (auto* prefetcher = getPrefetcher(); outermost && prefetcher != nullptr) {
+    prefetcher->release();
+  }
+}
+
+/**
+ * @brief Does the work of loadClass for a class this thread holds the placeholder of
+ */
+// NOLINTNEXTLINE(misc-no-recursion)
+runtime::Klass* ClassLoader::defineAndPrepare(const std::string& name) {
+  // The bootstrap loader defines the classes the VM throws itself, so that handlers in user
+  // code resolve their catch types to the same Klass the interpreter instantiates
+  if (parent_ == nullptr) {
+    if (auto* klass = runtime::findWellKnownClass(name); klass != nullptr) {
+      return klass;
+    }
+  }
+
+  // Archived classes are defined from their linked form, without a class file
+  if (archive_ != nullptr) {
+    std::string internal_name = name;
+    std::ranges::replace(internal_name, '.', '/');
+    if (auto archived = archive_->restore(internal_name); archived.has_value()) {
+      return defineArchived(std::move(*archived), name);
+    }
+  }
 
-  auto* klass = defineClass(std::move(class_file), fully_qualified_name);
+  // Take the class file from the prefetcher if a worker parsed it already, otherwise read
+  // and parse it here and let the workers start on the classes it refers to
+  auto*                      prefetcher = getPrefetcher();
+  std::unique_ptr<ClassFile> class_file;
+  if (prefetcher != nullptr) {
+    class_file = prefetcher->take(name);
+  }
+  if (class_file == nullptr) {
+    class_file = fetchClassFile(name);
+    if (class_file == nullptr) {
+      throw std::runtime_error("Class " + name + " not found");
+    }
+    if (prefetcher != nullptr) {
+      prefetcher->submit(*class_file);
+    }
+  }
+
+  auto* klass = defineClass(std::move(class_file), name);
 
   // Prepare the class
+  klass->allocateMembers(klass->getClassFile()->methods.getMembers().size(),
+                         klass->getClassFile()->fields.getMembers().size());
   klass->prepareRuntimeConstantPool(klass->getClassFile());
   klass->prepareMethods(klass->getClassFile());
   klass->prepareFieldsAndStatics(klass->getClassFile());
+  klass->buildMemberTables();
+  klass->getClassFile()->compact();
+  klass->releaseClassBytes();
+  klass->markLinked();
+  return klass;
+}
 
-  // Cache the loaded class for future access
-  cache_[fully_qualified_name] = klass;
+/**
+ * @brief Defines a class restored from the shared archive; linking is the same as for a
+ * parsed class, but its members are taken as archived instead of being prepared
+ */
+// NOLINTNEXTLINE(misc-no-recursion)
+runtime::Klass* ClassLoader::defineArchived(ArchivedClass archived, const std::string& name) {
+  auto* klass = defineClass(std::move(archived.class_file), name);
+
+  klass->allocateMembers(archived.methods.size(), archived.fields.size());
+  klass->prepareRuntimeConstantPool(klass->getClassFile());
+  for (auto& method : archived.methods) {
+    klass->addMethod(method.access_flags, method.name, method.descriptor, method.max_stack,
+                     method.max_locals, method.code, method.handlers);
+  }
+  for (const auto& field : archived.fields) {
+    klass->addField(field.access_flags, field.name, field.descriptor);
+  }
+  klass->allocateStatics();
+  klass->buildMemberTables();
+  klass->markLinked();
   return klass;
 }
 
-}  // namespace jvm::class_loader
\ No newline at end of file
+void ClassLoader::dumpSharedArchive(const std::string& path) {
+  std::vector<runtime::Klass*> classes;
+  {
+    std::lock_guard lock(mutex_);
+    for (const auto& [name, klass] : cache_) {
+      // well-known classes are synthetic and defined by every VM anyway
+      if (klass->getClassLoader() == this && klass->getClassFile() != nullptr) {
+        classes.push_back(klass);
+      }
+    }
+  }
+  SharedArchive::dump(path, classpaths_, classes);
+}
+
+}  // namespace jvm::class_loader
@@ -1,11 +1,20 @@
 #pragma once
 
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
 #include "class_file.h"
+#include "class_prefetcher.h"
+#include "classpath_index.h"
+#include "mapped_file.h"
+#include "runtime/metaspace.h"
+#include "shared_archive.h"
 
 namespace jvm::runtime {
 class Klass;
@@ -17,21 +26,62 @@ namespace jvm::class_loader {
 
 class ClassLoader {
  private:
-  ClassLoader*                                     parent_;
-  std::vector<std::string>                         classpaths_;
+  // declared first so that it goes last, after everything that refers to the classes in it
+  runtime::Metaspace metaspace_;
+
+  ClassLoader*                   parent_;
+  std::vector<std::string>       classpaths_;
+  ClasspathIndex                 classpath_;
+  std::unique_ptr<SharedArchive> archive_;  // nullptr unless it matches classpaths_
+
+  // Loading may happen on several threads at once. A class being loaded has a placeholder in
+  // loading_ naming the thread that loads it; other threads asking for it wait on loaded_
+  // until it is in cache_, so each class is defined exactly once.
+  std::mutex                                       mutex_;  // guards cache_ and loading_
+  std::condition_variable                          loaded_;
   std::unordered_map<std::string, runtime::Klass*> cache_;
+  std::unordered_map<std::string, std::thread::id> loading_;
+
+  std::once_flag                   prefetcher_once_;
+  std::unique_ptr<ClassPrefetcher> prefetcher_;  // nullptr when parallel loading is off
 
-  std::optional<std::vector<std::byte>> readClassFile(const std::string& name);
-  runtime::Klass* defineClass(std::unique_ptr<class_loader::ClassFile> class_file,
-                              const std::string&                       name);
-  void            linkSuperClass(runtime::Klass* klass);
-  void            linkInterfaces(runtime::Klass* klass);
+  std::optional<ClassBytes>  readClassFile(const std::string& name);
+  std::unique_ptr<ClassFile> fetchClassFile(const std::string& name);
+  ClassPrefetcher*           getPrefetcher();
+  runtime::Klass*            defineAndPrepare(const std::string& name);
+  void                       finishLoading(const std::string& name, runtime::Klass* klass);
+  runtime::Klass*            defineArchived(ArchivedClass archived, const std::string& name);
+  void                       openSharedArchive();
+  runtime::Klass*            defineClass(std::unique_ptr<class_loader::ClassFile> class_file,
+                                         const std::string&                       name);
+  void                       linkSuperClass(runtime::Klass* klass);
+  void                       linkInterfaces(runtime::Klass* klass);
 
  public:
-  explicit ClassLoader(ClassLoader* parent = nullptr, std::vector<std::string> classpaths = {})
-    : parent_(parent), classpaths_(std::move(classpaths)) {}
+  /**
+   * @brief Each classpath entry is a directory of .class files or a JAR file. The shared
+   * archive named by VMOptions is opened here if it was dumped with the same classpath.
+   * @throws std::runtime_error with -Xshare:on if the archive cannot be used
+   */
+  explicit ClassLoader(ClassLoader* parent = nullptr, std::vector<std::string> classpaths = {});
+  ClassLoader(const ClassLoader&)            = delete;
+  ClassLoader(ClassLoader&&)                 = delete;
+  ClassLoader& operator=(const ClassLoader&) = delete;
+  ClassLoader& operator=(ClassLoader&&)      = delete;
+  // Unloads every class this loader defined (see runtime::MethodArea::unloadClasses). Under
+  // -Xshare:dump, a loader with a classpath first writes its classes to the shared archive file.
+  ~ClassLoader();
 
   runtime::Klass* loadClass(const std::string& name);
+
+  // The arena the classes this loader defines are allocated from
+  runtime::Metaspace& getMetaspace() { return metaspace_; }
+
+  /**
+   * @brief Writes the classes this loader has loaded from class files to a shared archive at
+   * `path`; under -Xshare:dump the destructor calls it
+   */
+  void dumpSharedArchive(const std::string& path);
 };
 
 }  // namespace jvm::class_loader
\ No newline at end of file
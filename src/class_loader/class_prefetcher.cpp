@@ -0,0 +1,217 @@
+#include "class_prefetcher.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <vector>
+
+#include "runtime/vm_options.h"
+
+namespace jvm::class_loader {
+
+namespace {
+
+// "java/lang/String" -> "java.lang.String"; array classes have no class file
+std::optional<std::string> loadableName(const ConstantPool& cp, U2 class_index) {
+  auto name = cp.getClassName(class_index);
+  if (name.empty() || name.front() == '[') {
+    return std::nullopt;
+  }
+  std::string dotted(name);
+  std::ranges::replace(dotted, '/', '.');
+  return dotted;
+}
+
+// The workers of every prefetcher, started on first use and stopped at exit
+class WorkerPool {
+ public:
+  static WorkerPool& getInstance() {
+    static WorkerPool instance;
+    return instance;
+  }
+
+  WorkerPool(const WorkerPool&)            = delete;
+  WorkerPool(WorkerPool&&)                 = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+  WorkerPool& operator=(WorkerPool&&)      = delete;
+
+  void post(std::function<void()> task) {
+    {
+      std::lock_guard lock(mutex_);
+      tasks_.push_back(std::move(task));
+    }
+    queued_.notify_one();
+  }
+
+ private:
+  WorkerPool() {
+    size_t threads = runtime::VMOptions::getInstance().class_loading_threads;
+    if (threads == 0) {
+      threads = std::max(1U, std::thread::hardware_concurrency());
+    }
+    workers_.reserve(threads);
+    for (size_t i = 0; i < threads; i++) {
+      workers_.emplace_back([this] { work(); });
+    }
+  }
+
+  ~WorkerPool() {
+    {
+      std::lock_guard lock(mutex_);
+      stopping_ = true;
+    }
+    queued_.notify_all();
+    for (auto& worker : workers_) {
+      worker.join();
+    }
+  }
+
+  void work() {
+    std::unique_lock lock(mutex_);
+    while (true) {
+      queued_.wait(lock, [this] { return stopping_ || !tasks_.empty(); });
+      // the queue is drained first: a prefetcher waits for its tasks when destroyed
+      if (tasks_.empty()) {
+        return;
+      }
+      auto task = std::move(tasks_.front());
+      tasks_.pop_front();
+      lock.unlock();
+      task();
+      lock.lock();
+    }
+  }
+
+  std::mutex                        mutex_;
+  std::condition_variable           queued_;  // a task was posted, or stopping_ was set
+  std::deque<std::function<void()>> tasks_;
+  bool                              stopping_{false};
+  std::vector<std::thread>          workers_;
+};
+
+}  // namespace
+
+ClassPrefetcher::ClassPrefetcher(Fetch fetch) : fetch_(std::move(fetch)) {}
+
+ClassPrefetcher::~ClassPrefetcher() {
+  // tasks still in the pool's queue refer to this prefetcher; they end at once when they see
+  // stopping_
+  std::unique_lock lock(mutex_);
+  stopping_ = true;
+  parsed_.wait(lock, [this] { return tasks_ == 0; });
+}
+
+void ClassPrefetcher::submit(const ClassFile& class_file) {
+  std::lock_guard lock(mutex_);
+  enqueueSupertypes(class_file, std::this_thread::get_id());
+}
+
+void ClassPrefetcher::enqueueSupertypes(const ClassFile& class_file, std::thread::id owner) {
+  const auto& cp = class_file.constant_pool;
+  if (class_file.super_class_index != 0) {
+    if (auto name = loadableName(cp, class_file.super_class_index); name.has_value()) {
+      enqueue(std::move(*name), owner);
+    }
+  }
+  for (auto interface_index : class_file.interfaces) {
+    if (auto name = loadableName(cp, interface_index); name.has_value()) {
+      enqueue(std::move(*name), owner);
+    }
+  }
+}
+
+void ClassPrefetcher::enqueue(std::string name, std::thread::id owner) {
+  if (stopping_ || pending_ >= kMaxPendingClasses || slots_.contains(name)) {
+    return;
+  }
+  slots_.try_emplace(name, Slot{.state = State::kQueued, .class_file = nullptr, .owner = owner});
+  pending_++;
+  tasks_++;
+  WorkerPool::getInstance().post([this, name = std::move(name)] { parse(name); });
+}
+
+std::unique_ptr<ClassFile> ClassPrefetcher::take(const std::string& name) {
+  std::unique_lock lock(mutex_);
+  auto             it = slots_.find(name);
+  if (it == slots_.end()) {
+    // an unknown name is marked taken so that no worker parses it later
+    slots_.try_emplace(name, Slot{.state      = State::kTaken,
+                                  .class_file = nullptr,
+                                  .owner      = std::this_thread::get_id()});
+    return nullptr;
+  }
+  // a released slot goes away when its parse ends, so it is looked up again
+  parsed_.wait(lock, [this, &it, &name] {
+    it = slots_.find(name);
+    return it == slots_.end() || it->second.state != State::kParsing;
+  });
+  if (it == slots_.end()) {
+    return nullptr;
+  }
+  auto& slot = it->second;
+  if (slot.state != State::kTaken) {
+    // a queued slot stays in the pool's queue; its task sees it taken and skips it
+    slot.state = State::kTaken;
+    pending_--;
+  }
+  return std::move(slot.class_file);
+}
+
+void ClassPrefetcher::release() {
+  std::lock_guard lock(mutex_);
+  auto            self = std::this_thread::get_id();
+  for (auto it = slots_.begin(); it != slots_.end();) {
+    auto& slot = it->second;
+    if (slot.owner != self || slot.released) {
+      ++it;
+    } else if (slot.state == State::kParsing) {
+      slot.released = true;  // the worker frees it
+      ++it;
+    } else {
+      if (slot.state != State::kTaken) {
+        pending_--;
+      }
+      it = slots_.erase(it);
+    }
+  }
+}
+
+size_t ClassPrefetcher::getPendingCount() {
+  std::lock_guard lock(mutex_);
+  return pending_;
+}
+
+void ClassPrefetcher::parse(const std::string& name) {
+  std::unique_lock lock(mutex_);
+  auto             it = slots_.find(name);
+  if (!stopping_ && it != slots_.end() && it->second.state == State::kQueued) {
+    // slots in kParsing are never erased, so `slot` stays valid while the lock is released
+    auto& slot = it->second;
+    slot.state = State::kParsing;
+
+    lock.unlock();
+    std::unique_ptr<ClassFile> class_file;
+    try {
+      class_file = fetch_(name);
+    } catch (const std::exception&) {
+      // the loader fetches it again itself and reports the error where it belongs
+    }
+    lock.lock();
+
+    if (slot.released) {
+      pending_--;
+      slots_.erase(name);
+    } else {
+      if (class_file != nullptr) {
+        // linking the class loads its supertypes next
+        enqueueSupertypes(*class_file, slot.owner);
+      }
+      slot.class_file = std::move(class_file);
+      slot.state      = State::kParsed;
+    }
+  }
+  tasks_--;
+  parsed_.notify_all();
+}
+
+}  // namespace jvm::class_loader
@@ -0,0 +1,97 @@
+/**
+ * @file class_prefetcher.h
+ * @author Rive Chen
+ * @brief Speculative reading and parsing of class files on a worker pool
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+#include "class_file.h"
+
+namespace jvm::class_loader {
+
+// Reads and parses class files ahead of their loading. When the loader submits a class file,
+// its superclass and interfaces are queued once; a worker fetches and parses each, then queues
+// its supertypes in turn. Linking loads every one of them before the load that submitted them
+// returns, so the file I/O and parsing of a class hierarchy proceed on the workers while the
+// loading thread links and prepares.
+//
+// Only parsing is speculative, and it is bounded: no other class a class file refers to is
+// queued (those are resolved lazily, long after the load), at most kMaxPendingClasses parsed
+// class files wait to be taken, and release() drops what the calling thread's load left
+// behind. The workers are one VM-wide pool of -XX:ClassLoadingThreads threads, shared by every
+// prefetcher.
+class ClassPrefetcher {
+ public:
+  // Reads and parses the class `name` ("java.lang.String"); nullptr if it is not found
+  using Fetch = std::function<std::unique_ptr<ClassFile>(const std::string& name)>;
+
+  static constexpr size_t kMaxPendingClasses = 64;
+
+  explicit ClassPrefetcher(Fetch fetch);
+  ClassPrefetcher(const ClassPrefetcher&)            = delete;
+  ClassPrefetcher(ClassPrefetcher&&)                 = delete;
+  ClassPrefetcher& operator=(const ClassPrefetcher&) = delete;
+  ClassPrefetcher& operator=(ClassPrefetcher&&)      = delete;
+  // Waits for the workers to finish the tasks of this prefetcher
+  ~ClassPrefetcher();
+
+  /**
+   * @brief Queues the supertypes of `class_file` that have not been queued yet, on behalf of
+   * the calling thread
+   */
+  void submit(const ClassFile& class_file);
+
+  /**
+   * @brief Hands over the parsed class `name`, waiting if a worker is parsing it
+   * @return nullptr if it was never queued, is still queued (it is dropped from the queue),
+   * was taken already, or could not be fetched or parsed; the caller then fetches it itself
+   */
+  std::unique_ptr<ClassFile> take(const std::string& name);
+
+  /**
+   * @brief Forgets the classes queued on behalf of the calling thread, once its load is done:
+   * queued ones are not parsed, parsed ones not taken are freed
+   */
+  void release();
+
+  // Classes queued, being parsed or parsed and not taken yet
+  size_t getPendingCount();
+
+ private:
+  enum class State : U1 { kQueued, kParsing, kParsed, kTaken };
+
+  struct Slot {
+    State                      state{State::kQueued};
+    std::unique_ptr<ClassFile> class_file;
+    std::thread::id            owner;            // the thread whose load queued it
+    bool                       released{false};  // while kParsing; freed when the parse ends
+  };
+
+  // caller holds mutex_
+  void enqueueSupertypes(const ClassFile& class_file, std::thread::id owner);
+  void enqueue(std::string name, std::thread::id owner);
+  void parse(const std::string& name);
+
+  Fetch                                 fetch_;
+  std::mutex                            mutex_;
+  std::condition_variable               parsed_;  // a slot left State::kParsing, or a task ended
+  std::unordered_map<std::string, Slot> slots_;
+  size_t                                pending_{0};  // slots neither taken nor released
+  size_t                                tasks_{0};    // posted to the pool and not done yet
+  bool                                  stopping_{false};
+};
+
+}  // namespace jvm::class_loader
@@ -0,0 +1,117 @@
+#include "classpath_index.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <limits>
+#include <stdexcept>
+
+namespace jvm::class_loader {
+
+namespace {
+
+constexpr std::string_view kClassSuffix = ".class";
+
+}  // namespace
+
+ClasspathIndex::ClasspathIndex(const std::vector<std::string>& roots) {
+  if (roots.size() > std::numeric_limits<U2>::max()) {
+    throw std::runtime_error("Too many classpath entries");
+  }
+  roots_.reserve(roots.size());
+  for (const auto& root : roots) {
+    std::error_code error;
+    bool            is_file = std::filesystem::is_regular_file(root, error);
+    roots_.push_back({.path = root, .jar = is_file ? JarFile::open(root) : nullptr});
+  }
+}
+
+std::optional<ClassBytes> ClasspathIndex::read(std::string_view class_name) {
+  // "java.lang.String" -> package "java/lang", simple name "String"
+  std::string path(class_name);
+  std::ranges::replace(path, '.', '/');
+  auto        slash       = path.rfind('/');
+  std::string package     = slash == std::string::npos ? "" : path.substr(0, slash);
+  std::string simple_name = slash == std::string::npos ? path : path.substr(slash + 1);
+  path.append(kClassSuffix);
+
+  std::optional<U2> root_index;
+  {
+    std::lock_guard lock(mutex_);
+    if (absent_.contains(path)) {
+      return std::nullopt;
+    }
+    root_index = findRoot(package, simple_name);
+    if (!root_index.has_value()) {
+      absent_.insert(std::move(path));
+      return std::nullopt;
+    }
+  }
+
+  const auto& root = roots_[root_index.value()];
+  if (root.jar != nullptr) {
+    return root.jar->read(path);
+  }
+  auto file = MappedFile::open((std::filesystem::path(root.path) / path).string());
+  if (!file.has_value()) {
+    // removed since the package was indexed
+    std::lock_guard lock(mutex_);
+    absent_.insert(std::move(path));
+    return std::nullopt;
+  }
+  auto bytes = file->getBytes();
+  return ClassBytes(std::make_shared<const MappedFile>(std::move(*file)), bytes);
+}
+
+std::optional<U2> ClasspathIndex::findRoot(const std::string& package,
+                                           const std::string& simple_name) {
+  auto it = packages_.find(package);
+  if (it == packages_.end()) {
+    it = packages_.emplace(package, indexPackage(package)).first;
+  }
+  auto found = it->second.find(simple_name);
+  if (found == it->second.end()) {
+    return std::nullopt;
+  }
+  return found->second;
+}
+
+ClasspathIndex::Package ClasspathIndex::indexPackage(const std::string& package) const {
+  Package classes;
+  auto    add = [&classes](std::string_view file_name, U2 root_index) {
+    if (file_name.ends_with(kClassSuffix)) {
+      file_name.remove_suffix(kClassSuffix.size());
+      // earlier roots win
+      classes.try_emplace(std::string(file_name), root_index);
+    }
+  };
+
+  for (U2 i = 0; i < roots_.size(); i++) {
+    if (roots_[i].jar != nullptr) {
+      for (auto file_name : roots_[i].jar->list(package)) {
+        add(file_name, i);
+      }
+      continue;
+    }
+    // one listing per root and package; a root without the package fails here cheaply
+    std::error_code                     error;
+    std::filesystem::directory_iterator it(std::filesystem::path(roots_[i].path) / package, error);
+    for (; !error && it != std::filesystem::directory_iterator(); it.increment(error)) {
+      if (it->is_regular_file(error)) {
+        add(it->path().filename().string(), i);
+      }
+    }
+  }
+  return classes;
+}
+
+size_t ClasspathIndex::getIndexedPackageCount() {
+  std::lock_guard lock(mutex_);
+  return packages_.size();
+}
+
+size_t ClasspathIndex::getNegativeCacheSize() {
+  std::lock_guard lock(mutex_);
+  return absent_.size();
+}
+
+}  // namespace jvm::class_loader
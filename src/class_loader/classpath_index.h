@@ -0,0 +1,82 @@
+/**
+ * @file classpath_index.h
+ * @author Rive Chen
+ * @brief Lazily built index of the classes on a classpath
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "common/types.h"
+#include "jar_file.h"
+#include "mapped_file.h"
+
+namespace jvm::class_loader {
+
+// The classes on a classpath of directories and JAR files. A package is indexed the first
+// time a class in it is looked up: each directory root is listed once and each JAR consulted
+// once, recording which root comes first for every class file in the package. After that a
+// lookup is a hash probe instead of one filesystem probe per root, and a class the index does
+// not have is answered without touching the filesystem at all. Names found absent are kept in
+// a negative cache, which also covers packages no root has.
+//
+// The index is a snapshot: class files added to an already indexed package afterwards are not
+// seen, as with the central directory of a JAR. Lookups may come from several threads.
+class ClasspathIndex {
+ public:
+  /**
+   * @brief Each root is a directory of .class files or a JAR file; JARs are opened and their
+   * central directories read here, directories are not touched until a lookup needs them
+   */
+  explicit ClasspathIndex(const std::vector<std::string>& roots);
+  ClasspathIndex(const ClasspathIndex&)            = delete;
+  ClasspathIndex(ClasspathIndex&&)                 = delete;
+  ClasspathIndex& operator=(const ClasspathIndex&) = delete;
+  ClasspathIndex& operator=(ClasspathIndex&&)      = delete;
+  ~ClasspathIndex()                                = default;
+
+  /**
+   * @brief Reads the class file for `class_name` (e.g. "java.lang.String") from the first
+   * root that has it
+   * @return std::nullopt if no root has it
+   */
+  std::optional<ClassBytes> read(std::string_view class_name);
+
+  size_t getIndexedPackageCount();
+  size_t getNegativeCacheSize();
+
+ private:
+  struct Root {
+    std::string              path;
+    std::unique_ptr<JarFile> jar;  // nullptr for a directory
+  };
+
+  // class file name without ".class" -> index of the first root that has it
+  using Package = std::unordered_map<std::string, U2>;
+
+  /**
+   * @brief Finds which root has `simple_name` in `package` ("java/lang"), indexing the package
+   * on first use; the caller holds mutex_
+   */
+  std::optional<U2> findRoot(const std::string& package, const std::string& simple_name);
+  Package           indexPackage(const std::string& package) const;
+
+  std::vector<Root>                        roots_;
+  std::mutex                               mutex_;  // guards packages_ and absent_
+  std::unordered_map<std::string, Package> packages_;
+  std::unordered_set<std::string>          absent_;  // class file paths known to be missing
+};
+
+}  // namespace jvm::class_loader
@@ -1,130 +1,197 @@
 #include "constant_pool.h"
 
 #include <bit>
+#include <stdexcept>
+#include <string>
+#include <utility>
 
 #include "byte_reader.hpp"
 #include "common/types.h"
+#include "modified_utf8.h"
+#include "runtime/symbol.h"
 
 namespace jvm::class_loader {
 
-// Utf8Info::readInfo() - reads a UTF-8 string
-void Utf8Info::readInfo(ByteReader& reader) {
-  U2 length = reader.read<U2>();
-  value.resize(length);
-  // TODO: implement Modified UTF-8 decoding
-  reader.readBytes(value.data(), length);
-}
+namespace {
 
-// IntegerInfo::readInfo() - reads a 32-bit signed integer
-void IntegerInfo::readInfo(ByteReader& reader) {
-  U4 bits = reader.read<U4>();
-  value   = std::bit_cast<Jint>(bits);
-}
+// two indices (or a kind and an index) packed in one value
+U8 pack(U2 high, U2 low) { return (static_cast<U8>(high) << 16) | low; }
+U2 highOf(U8 value) { return static_cast<U2>(value >> 16); }
+U2 lowOf(U8 value) { return static_cast<U2>(value); }
 
-// FloatInfo::readInfo() - reads a 32-bit IEEE 754 float
-void FloatInfo::readInfo(ByteReader& reader) {
-  U4 bits = reader.read<U4>();
-  value   = std::bit_cast<Jfloat>(bits);
-}
+}  // namespace
 
-// LongInfo::readInfo() - reads a 64-bit signed integer
-void LongInfo::readInfo(ByteReader& reader) {
-  U8 bits = reader.read<U8>();
-  value   = std::bit_cast<Jlong>(bits);
-}
+ConstantPool::ConstantPool(ConstantPool&& other) noexcept
+  : tags_(std::exchange(other.tags_, {})), values_(std::exchange(other.values_, {})) {}
 
-// DoubleInfo::readInfo() - reads a 64-bit IEEE 754 double
-void DoubleInfo::readInfo(ByteReader& reader) {
-  U8 bits = reader.read<U8>();
-  value   = std::bit_cast<Jdouble>(bits);
+ConstantPool& ConstantPool::operator=(ConstantPool&& other) noexcept {
+  if (this != &other) {
+    releaseSymbols();
+    tags_   = std::exchange(other.tags_, {});
+    values_ = std::exchange(other.values_, {});
+  }
+  return *this;
 }
 
-// ClassInfo::readInfo() - reads a class reference
-void ClassInfo::readInfo(ByteReader& reader) { name_index = reader.read<U2>(); }
+ConstantPool::~ConstantPool() { releaseSymbols(); }
 
-// StringInfo::readInfo() - reads a string reference
-void StringInfo::readInfo(ByteReader& reader) { string_index = reader.read<U2>(); }
-
-// MemberrefInfo::readInfo() - reads a member reference (field/method/interface
-// method)
-void MemberrefInfo::readInfo(ByteReader& reader) {
-  class_index         = reader.read<U2>();
-  name_and_type_index = reader.read<U2>();
+void ConstantPool::releaseSymbols() {
+  for (size_t i = 0; i < tags_.size(); i++) {
+    if (tags_[i] == ConstantTag::kUtf8) {
+      runtime::SymbolTable::release(std::bit_cast<const runtime::Symbol*>(values_[i]));
+    }
+  }
 }
 
-// NameAndTypeInfo::readInfo() - reads a name and type descriptor
-void NameAndTypeInfo::readInfo(ByteReader& reader) {
-  name_index       = reader.read<U2>();
-  descriptor_index = reader.read<U2>();
+ConstantTag ConstantPool::readEntry(U2 index, ByteReader& reader) {
+  auto tag_byte = reader.read<U1>();
+  auto tag      = static_cast<ConstantTag>(tag_byte);
+
+  U8 value = 0;
+  switch (tag) {
+    case ConstantTag::kUtf8: {
+      U2   length = reader.read<U2>();
+      auto bytes  = reader.readSpan(length);
+      if (!isValidModifiedUtf8(bytes)) {
+        throw std::runtime_error("Malformed Modified UTF-8 in constant pool entry " +
+                                 std::to_string(index));
+      }
+      // interned straight from the class file bytes, still Modified UTF-8; the symbol is the
+      // only copy
+      auto string =
+        std::string_view(reinterpret_cast<const char*>(bytes.data()), bytes.size());  // NOLINT
+      value = std::bit_cast<U8>(runtime::SymbolTable::getInstance().intern(string));
+    } break;
+    case ConstantTag::kInteger:
+    case ConstantTag::kFloat:
+      // the raw bits, reinterpreted by getInteger() and getFloat()
+      value = reader.read<U4>();
+      break;
+    case ConstantTag::kLong:
+    case ConstantTag::kDouble:
+      value = reader.read<U8>();
+      break;
+    case ConstantTag::kClass:
+    case ConstantTag::kString:
+    case ConstantTag::kMethodType:
+      value = reader.read<U2>();
+      break;
+    case ConstantTag::kFieldref:
+    case ConstantTag::kMethodref:
+    case ConstantTag::kInterfaceMethodref:
+    case ConstantTag::kNameAndType:
+    case ConstantTag::kInvokeDynamic: {
+      U2 first = reader.read<U2>();
+      value    = pack(first, reader.read<U2>());
+    } break;
+    case ConstantTag::kMethodHandle: {
+      U1 reference_kind = reader.read<U1>();
+      value             = pack(reference_kind, reader.read<U2>());
+    } break;
+    default:
+      throw std::runtime_error("Unknown constant pool tag: " + std::to_string(tag_byte));
+  }
+
+  tags_[index]   = tag;
+  values_[index] = value;
+  return tag;
 }
 
-// MethodHandleInfo::readInfo() - reads a method handle reference
-void MethodHandleInfo::readInfo(ByteReader& reader) {
-  reference_kind  = reader.read<U1>();
-  reference_index = reader.read<U2>();
+U8 ConstantPool::getRawValue(U2 index) const {
+  if (index >= values_.size()) {
+    throw std::invalid_argument("Invalid constant pool index: " + std::to_string(index));
+  }
+  return values_[index];
 }
 
-// MethodTypeInfo::readInfo() - reads a method type descriptor
-void MethodTypeInfo::readInfo(ByteReader& reader) { descriptor_index = reader.read<U2>(); }
+void ConstantPool::setEntry(U2 index, ConstantTag tag, U8 value) {
+  if (index >= tags_.size()) {
+    throw std::invalid_argument("Invalid constant pool index: " + std::to_string(index));
+  }
+  if (tag == ConstantTag::kUtf8) {
+    runtime::SymbolTable::retain(std::bit_cast<const runtime::Symbol*>(value));
+  }
+  tags_[index]   = tag;
+  values_[index] = value;
+}
 
-// InvokeDynamicInfo::readInfo() - reads an invoke dynamic reference
-void InvokeDynamicInfo::readInfo(ByteReader& reader) {
-  bootstrap_method_attr_index = reader.read<U2>();
-  name_and_type_index         = reader.read<U2>();
+ConstantTag ConstantPool::getTag(U2 index) const {
+  if (index == 0 || index >= tags_.size()) {
+    throw std::invalid_argument("Invalid constant pool index: " + std::to_string(index));
+  }
+  return tags_[index];
 }
 
-// ConstantPool methods
-std::string ConstantPool::getUtf8String(U2 index) const {
-  if (index == 0 || index >= pool_.size()) {
+U8 ConstantPool::getValue(U2 index, ConstantTag expected, const char* expected_name) const {
+  if (index == 0 || index >= tags_.size()) {
     throw std::runtime_error("Invalid constant pool index: " + std::to_string(index));
   }
-
-  const auto* utf8_info = dynamic_cast<const Utf8Info*>(getConstantInfo(index));
-  if (utf8_info == nullptr) {
-    throw std::runtime_error("Constant pool entry at index " + std::to_string(index) +
-                             " is not a UTF-8 string");
+  if (tags_[index] != expected) {
+    throw std::runtime_error("Constant pool entry at index " + std::to_string(index) + " is not " +
+                             expected_name);
   }
+  return values_[index];
+}
 
-  return utf8_info->value;
+// ConstantPool methods
+std::string_view ConstantPool::getUtf8String(U2 index) const {
+  return getUtf8Symbol(index)->view();
 }
 
-std::string ConstantPool::getClassName(U2 class_index) const {
-  if (class_index == 0 || class_index >= pool_.size()) {
-    throw std::runtime_error("Invalid constant pool index: " + std::to_string(class_index));
-  }
+const runtime::Symbol* ConstantPool::getUtf8Symbol(U2 index) const {
+  auto value = getValue(index, ConstantTag::kUtf8, "a UTF-8 string");
+  return std::bit_cast<const runtime::Symbol*>(value);
+}
 
-  const auto* class_info = dynamic_cast<const ClassInfo*>(getConstantInfo(class_index));
-  if (class_info == nullptr) {
-    throw std::runtime_error("Constant pool entry at index " + std::to_string(class_index) +
-                             " is not a class reference");
-  }
+std::string ConstantPool::getClassName(U2 class_index) const {
+  return std::string(getUtf8String(getClassNameIndex(class_index)));
+}
 
-  return getUtf8String(class_info->name_index);
+U2 ConstantPool::getClassNameIndex(U2 class_index) const {
+  return static_cast<U2>(getValue(class_index, ConstantTag::kClass, "a class reference"));
 }
 
 std::pair<std::string, std::string> ConstantPool::getNameAndType(U2 index) const {
-  if (index == 0 || index >= pool_.size()) {
-    throw std::runtime_error("Invalid constant pool index: " + std::to_string(index));
-  }
+  auto [name_index, descriptor_index] = getNameAndTypeRef(index);
+  return std::make_pair(std::string(getUtf8String(name_index)),
+                        std::string(getUtf8String(descriptor_index)));
+}
 
-  const auto* name_and_type_info = dynamic_cast<const NameAndTypeInfo*>(getConstantInfo(index));
-  if (name_and_type_info == nullptr) {
-    throw std::runtime_error("Constant pool entry at index " + std::to_string(index) +
-                             " is not a name and type");
+NameAndTypeRef ConstantPool::getNameAndTypeRef(U2 index) const {
+  auto value = getValue(index, ConstantTag::kNameAndType, "a name and type");
+  return {.name_index = highOf(value), .descriptor_index = lowOf(value)};
+}
+
+MemberRef ConstantPool::getMemberRef(U2 index) const {
+  switch (getTag(index)) {
+    case ConstantTag::kFieldref:
+    case ConstantTag::kMethodref:
+    case ConstantTag::kInterfaceMethodref:
+      return {.class_index = highOf(values_[index]), .name_and_type_index = lowOf(values_[index])};
+    default:
+      throw std::runtime_error("Constant pool entry at index " + std::to_string(index) +
+                               " is not a member reference");
   }
+}
 
-  std::string name       = getUtf8String(name_and_type_info->name_index);
-  std::string descriptor = getUtf8String(name_and_type_info->descriptor_index);
+Jint ConstantPool::getInteger(U2 index) const {
+  return std::bit_cast<Jint>(static_cast<U4>(getValue(index, ConstantTag::kInteger, "an integer")));
+}
 
-  return std::make_pair(name, descriptor);
+Jfloat ConstantPool::getFloat(U2 index) const {
+  return std::bit_cast<Jfloat>(static_cast<U4>(getValue(index, ConstantTag::kFloat, "a float")));
 }
 
-const ConstantInfo* ConstantPool::getConstantInfo(U2 index) const {
-  if (index == 0 || index >= pool_.size()) {
-    throw std::invalid_argument("Invalid constant pool index: " + std::to_string(index));
-  }
+Jlong ConstantPool::getLong(U2 index) const {
+  return std::bit_cast<Jlong>(getValue(index, ConstantTag::kLong, "a long"));
+}
+
+Jdouble ConstantPool::getDouble(U2 index) const {
+  return std::bit_cast<Jdouble>(getValue(index, ConstantTag::kDouble, "a double"));
+}
 
-  return pool_[index].get();
+U2 ConstantPool::getStringIndex(U2 index) const {
+  return static_cast<U2>(getValue(index, ConstantTag::kString, "a string"));
 }
 
-}  // namespace jvm::class_loader
\ No newline at end of file
+}  // namespace jvm::class_loader
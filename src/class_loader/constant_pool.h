@@ -10,18 +10,24 @@
  */
 #pragma once
 
-#include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "common/types.h"
 
+namespace jvm::runtime {
+class Symbol;
+}  // namespace jvm::runtime
+
 namespace jvm::class_loader {
 
 class ByteReader;
 
 // JVM Spec §4.4. The Constant Pool
 enum class ConstantTag : U1 {
+  kEmpty              = 0,  // index 0 and the second slot of a Long or Double, not a JVM tag
   kUtf8               = 1,
   kInteger            = 3,
   kFloat              = 4,
@@ -38,130 +44,67 @@ enum class ConstantTag : U1 {
   kInvokeDynamic      = 18,
 };
 
-// Abstract base class for all constant pool entries
-class ConstantInfo {
- public:
-  ConstantInfo()                               = default;
-  ConstantInfo(const ConstantInfo&)            = default;
-  ConstantInfo(ConstantInfo&&)                 = default;
-  ConstantInfo& operator=(const ConstantInfo&) = default;
-  ConstantInfo& operator=(ConstantInfo&&)      = default;
-  virtual ~ConstantInfo()                      = default;
-  // Each concrete type must know how to read its own data from the stream
-  virtual void readInfo(ByteReader& reader) = 0;
-
-  ConstantTag tag{};
-};
-
-// CONSTANT_Utf8_info
-class Utf8Info : public ConstantInfo {
- public:
-  void        readInfo(ByteReader& reader) override;
-  std::string value;
-};
-
-// CONSTANT_Integer_info
-class IntegerInfo : public ConstantInfo {
- public:
-  void readInfo(ByteReader& reader) override;
-  Jint value;
+// CONSTANT_Fieldref_info, CONSTANT_Methodref_info and CONSTANT_InterfaceMethodref_info
+struct MemberRef {
+  U2 class_index;
+  U2 name_and_type_index;
 };
 
-// CONSTANT_Float_info
-class FloatInfo : public ConstantInfo {
- public:
-  void   readInfo(ByteReader& reader) override;
-  Jfloat value;
-};
-
-// CONSTANT_Long_info
-class LongInfo : public ConstantInfo {
- public:
-  void  readInfo(ByteReader& reader) override;
-  Jlong value;
-};
-
-// CONSTANT_Double_info
-class DoubleInfo : public ConstantInfo {
- public:
-  void    readInfo(ByteReader& reader) override;
-  Jdouble value;
-};
-
-// CONSTANT_Class_info
-class ClassInfo : public ConstantInfo {
- public:
-  void readInfo(ByteReader& reader) override;
-  U2   name_index;
-};
-
-// CONSTANT_String_info
-class StringInfo : public ConstantInfo {
- public:
-  void readInfo(ByteReader& reader) override;
-  U2   string_index;
-};
-
-// A common base for Fieldref, Methodref, and InterfaceMethodref
-class MemberrefInfo : public ConstantInfo {
- public:
-  void readInfo(ByteReader& reader) override;
-  U2   class_index;
-  U2   name_and_type_index;
-};
-
-class FieldrefInfo : public MemberrefInfo {};
-class MethodrefInfo : public MemberrefInfo {};
-class InterfaceMethodrefInfo : public MemberrefInfo {};
-
 // CONSTANT_NameAndType_info
-class NameAndTypeInfo : public ConstantInfo {
- public:
-  void readInfo(ByteReader& reader) override;
-  U2   name_index;
-  U2   descriptor_index;
+struct NameAndTypeRef {
+  U2 name_index;
+  U2 descriptor_index;
 };
 
-// CONSTANT_MethodHandle_info
-class MethodHandleInfo : public ConstantInfo {
+// The constant pool as two flat arrays indexed like the class file's: one tag byte and one
+// 8-byte value per entry, with no object per entry. The value is the decoded scalar of an
+// Integer, Float, Long or Double, the interned runtime::Symbol of a Utf8, and the indices an
+// entry refers to otherwise. Accessors check the tag and throw std::runtime_error on a mismatch.
+// The pool holds a reference to each of its symbols.
+class ConstantPool {
  public:
-  void readInfo(ByteReader& reader) override;
-  U1   reference_kind;
-  U2   reference_index;
-};
+  // An empty pool of `count` entries, filled in by readEntry()
+  explicit ConstantPool(U2 count) : tags_(count, ConstantTag::kEmpty), values_(count) {}
+  ConstantPool(const ConstantPool&) = delete;
+  ConstantPool(ConstantPool&& other) noexcept;
+  ConstantPool& operator=(const ConstantPool&) = delete;
+  ConstantPool& operator=(ConstantPool&& other) noexcept;
+  ~ConstantPool();
 
-// CONSTANT_MethodType_info
-class MethodTypeInfo : public ConstantInfo {
- public:
-  void readInfo(ByteReader& reader) override;
-  U2   descriptor_index;
-};
+  /**
+   * @brief Reads the entry at `index`, tag included, from the class file
+   * @return The tag read; a Long or Double also takes up index + 1, which the caller skips
+   * @throws std::runtime_error on an unknown tag
+   */
+  ConstantTag readEntry(U2 index, ByteReader& reader);
 
-// CONSTANT_InvokeDynamic_info
-class InvokeDynamicInfo : public ConstantInfo {
- public:
-  void readInfo(ByteReader& reader) override;
-  U2   bootstrap_method_attr_index;
-  U2   name_and_type_index;
-};
+  /**
+   * @brief The value of an entry as readEntry() stores it, and its inverse; used by the shared
+   * archive to save and restore a pool without a class file. An index not below size() throws
+   * std::invalid_argument.
+   */
+  U8   getRawValue(U2 index) const;
+  void setEntry(U2 index, ConstantTag tag, U8 value);
 
-class ConstantPool {
- public:
-  // Takes ownership of the parsed constant info vector
-  explicit ConstantPool(std::vector<std::unique_ptr<ConstantInfo>>&& pool)
-    : pool_(std::move(pool)) {}
-  ConstantPool(const ConstantPool&)            = delete;
-  ConstantPool(ConstantPool&&)                 = default;
-  ConstantPool& operator=(const ConstantPool&) = delete;
-  ConstantPool& operator=(ConstantPool&&)      = default;
-  ~ConstantPool()                              = default;
+  /**
+   * @brief Get the tag of an entry, ConstantTag::kEmpty for the second slot of a Long or Double
+   * @throws std::invalid_argument if `index` is 0 or out of range
+   */
+  ConstantTag getTag(U2 index) const;
 
   /**
    * @brief Get a UTF-8 string from a utf8 info entry in the constant pool
    * @param index Index of the utf8 info entry in the constant pool
-   * @return std::string
+   * @return std::string_view into the interned symbol, valid for the life of the process
    */
-  std::string getUtf8String(U2 index) const;
+  std::string_view getUtf8String(U2 index) const;
+
+  /**
+   * @brief Get the interned symbol of a utf8 info entry in the constant pool
+   * @param index Index of the utf8 info entry in the constant pool
+   * @return const runtime::Symbol*
+   */
+  const runtime::Symbol* getUtf8Symbol(U2 index) const;
 
   /**
    * @brief Get a class name from a class info entry pointing to a utf8 info entry
@@ -170,6 +113,11 @@ class ConstantPool {
    */
   std::string getClassName(U2 class_index) const;
 
+  /**
+   * @brief Get the utf8 index a class info entry refers to
+   */
+  U2 getClassNameIndex(U2 class_index) const;
+
   /**
    * @brief Get a name and descriptor from a name and type info entry pointing to two utf8 info
    * entries
@@ -179,20 +127,37 @@ class ConstantPool {
   std::pair<std::string, std::string> getNameAndType(U2 index) const;
 
   /**
-   * @brief Get a constant info entry from the constant pool
-   * @param index Index of the constant info entry in the constant pool
-   * @return const ConstantInfo*
+   * @brief Get the indices of a name and type info entry
    */
-  const ConstantInfo* getConstantInfo(U2 index) const;
+  NameAndTypeRef getNameAndTypeRef(U2 index) const;
+
+  /**
+   * @brief Get the indices of a field, method or interface method reference
+   */
+  MemberRef getMemberRef(U2 index) const;
+
+  // Literals
+  Jint    getInteger(U2 index) const;
+  Jfloat  getFloat(U2 index) const;
+  Jlong   getLong(U2 index) const;
+  Jdouble getDouble(U2 index) const;
+  // The utf8 index of a string info entry
+  U2      getStringIndex(U2 index) const;
 
   /**
    * @brief Get the size of the constant pool, including the placeholder at index 0
    * @return size_t
    */
-  size_t size() const { return pool_.size(); }
+  size_t size() const { return tags_.size(); }
 
  private:
-  std::vector<std::unique_ptr<ConstantInfo>> pool_;
+  std::vector<ConstantTag> tags_;
+  std::vector<U8>          values_;
+
+  void releaseSymbols();
+
+  // The value of the entry at `index`, which must be tagged `expected`
+  U8 getValue(U2 index, ConstantTag expected, const char* expected_name) const;
 };
 
 }  // namespace jvm::class_loader
@@ -0,0 +1,179 @@
+#include "jar_file.h"
+
+#include <zlib.h>
+
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace jvm::class_loader {
+
+namespace {
+
+// ZIP File Format Specification (APPNOTE.TXT), all fields little-endian
+constexpr U4 kEndOfCentralDirectorySignature = 0x06054B50;
+constexpr U4 kCentralDirectorySignature      = 0x02014B50;
+constexpr U4 kLocalHeaderSignature           = 0x04034B50;
+
+constexpr size_t kEndOfCentralDirectorySize = 22;
+constexpr size_t kCentralDirectoryEntrySize = 46;
+constexpr size_t kLocalHeaderSize           = 30;
+constexpr size_t kMaxCommentSize            = 0xFFFF;
+
+constexpr U2 kMethodStored   = 0;
+constexpr U2 kMethodDeflated = 8;
+constexpr U2 kFlagEncrypted  = 0x0001;
+
+U2 readU2(std::span<const U1> bytes, size_t offset) {
+  return static_cast<U2>(bytes[offset] | (bytes[offset + 1] << 8));
+}
+
+U4 readU4(std::span<const U1> bytes, size_t offset) {
+  return static_cast<U4>(readU2(bytes, offset)) |
+         (static_cast<U4>(readU2(bytes, offset + 2)) << 16);
+}
+
+[[noreturn]] void corrupt(const std::string& what) {
+  throw std::runtime_error("Invalid JAR file: " + what);
+}
+
+}  // namespace
+
+std::unique_ptr<JarFile> JarFile::open(const std::string& path) {
+  auto file = MappedFile::open(path);
+  if (!file.has_value()) {
+    return nullptr;
+  }
+  std::unique_ptr<JarFile> jar(new JarFile(std::make_shared<const MappedFile>(std::move(*file))));
+  jar->readCentralDirectory();
+  return jar;
+}
+
+void JarFile::readCentralDirectory() {
+  auto bytes = file_->getBytes();
+  if (bytes.size() < kEndOfCentralDirectorySize) {
+    corrupt("too short for a ZIP archive");
+  }
+
+  // the end of central directory record is last, followed only by a variable-length comment
+  size_t eocd   = bytes.size() - kEndOfCentralDirectorySize;
+  size_t lowest = eocd - std::min(eocd, kMaxCommentSize);
+  while (readU4(bytes, eocd) != kEndOfCentralDirectorySignature) {
+    if (eocd == lowest) {
+      corrupt("no end of central directory record");
+    }
+    eocd--;
+  }
+
+  U2 entry_count = readU2(bytes, eocd + 10);
+  U4 cd_size     = readU4(bytes, eocd + 12);
+  U4 cd_offset   = readU4(bytes, eocd + 16);
+  if (entry_count == std::numeric_limits<U2>::max() ||
+      cd_offset == std::numeric_limits<U4>::max()) {
+    corrupt("ZIP64 archives are not supported");
+  }
+  if (static_cast<size_t>(cd_offset) + cd_size > eocd) {
+    corrupt("central directory out of bounds");
+  }
+
+  entries_.reserve(entry_count);
+  size_t offset = cd_offset;
+  for (U2 i = 0; i < entry_count; i++) {
+    if (offset + kCentralDirectoryEntrySize > eocd ||
+        readU4(bytes, offset) != kCentralDirectorySignature) {
+      corrupt("bad central directory entry");
+    }
+    U2 flags        = readU2(bytes, offset + 8);
+    U2 name_length  = readU2(bytes, offset + 28);
+    U2 extra_length = readU2(bytes, offset + 30);
+    U2 comment_size = readU2(bytes, offset + 32);
+    if (offset + kCentralDirectoryEntrySize + name_length > eocd) {
+      corrupt("central directory entry name out of bounds");
+    }
+    if ((flags & kFlagEncrypted) != 0) {
+      corrupt("encrypted entries are not supported");
+    }
+
+    auto name = std::string_view(
+      reinterpret_cast<const char*>(bytes.data() + offset + kCentralDirectoryEntrySize),  // NOLINT
+      name_length);
+    entries_.emplace(name, Entry{.local_header_offset = readU4(bytes, offset + 42),
+                                 .compressed_size     = readU4(bytes, offset + 20),
+                                 .uncompressed_size   = readU4(bytes, offset + 24),
+                                 .crc32               = readU4(bytes, offset + 16),
+                                 .method              = readU2(bytes, offset + 10)});
+    if (!name.empty() && name.back() != '/') {
+      auto slash = name.rfind('/');
+      if (slash == std::string_view::npos) {
+        directories_[{}].push_back(name);
+      } else {
+        directories_[name.substr(0, slash)].push_back(name.substr(slash + 1));
+      }
+    }
+    offset += kCentralDirectoryEntrySize + name_length + extra_length + comment_size;
+  }
+}
+
+std::span<const std::string_view> JarFile::list(std::string_view directory) const {
+  auto it = directories_.find(directory);
+  if (it == directories_.end()) {
+    return {};
+  }
+  return it->second;
+}
+
+std::optional<ClassBytes> JarFile::read(std::string_view name) const {
+  auto it = entries_.find(name);
+  if (it == entries_.end()) {
+    return std::nullopt;
+  }
+  const auto& entry = it->second;
+  auto        bytes = file_->getBytes();
+
+  // the local header repeats the name and may carry a different extra field than the
+  // central directory, so the data offset comes from the local header itself
+  size_t header = entry.local_header_offset;
+  if (header + kLocalHeaderSize > bytes.size() ||
+      readU4(bytes, header) != kLocalHeaderSignature) {
+    corrupt("bad local header for " + std::string(name));
+  }
+  size_t data = header + kLocalHeaderSize + readU2(bytes, header + 26) + readU2(bytes, header + 28);
+  if (data + entry.compressed_size > bytes.size()) {
+    corrupt("data out of bounds for " + std::string(name));
+  }
+  auto compressed = bytes.subspan(data, entry.compressed_size);
+
+  switch (entry.method) {
+    case kMethodStored:
+      // zero-copy: a view into the mapping, which the ClassBytes keeps alive
+      return ClassBytes(file_, compressed);
+    case kMethodDeflated: {
+      std::vector<U1> buffer(entry.uncompressed_size);
+      z_stream        stream{};
+      // negative window bits: raw deflate data, without a zlib header
+      if (inflateInit2(&stream, -MAX_WBITS) != Z_OK) {
+        throw std::runtime_error("inflateInit2 failed");
+      }
+      stream.next_in   = const_cast<Bytef*>(compressed.data());  // NOLINT(*-const-cast)
+      stream.avail_in  = entry.compressed_size;
+      stream.next_out  = buffer.data();
+      stream.avail_out = entry.uncompressed_size;
+      int status       = inflate(&stream, Z_FINISH);
+      inflateEnd(&stream);
+      if (status != Z_STREAM_END || stream.total_out != entry.uncompressed_size) {
+        corrupt("cannot inflate " + std::string(name));
+      }
+      if (crc32(0, buffer.data(), entry.uncompressed_size) != entry.crc32) {
+        corrupt("CRC mismatch for " + std::string(name));
+      }
+      return ClassBytes(std::move(buffer));
+    }
+    default:
+      throw std::runtime_error("Unsupported compression method " + std::to_string(entry.method) +
+                               " for " + std::string(name));
+  }
+}
+
+}  // namespace jvm::class_loader
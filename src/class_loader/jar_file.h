@@ -0,0 +1,81 @@
+/**
+ * @file jar_file.h
+ * @author Rive Chen
+ * @brief JAR (ZIP) archives on the classpath
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.h"
+#include "mapped_file.h"
+
+namespace jvm::class_loader {
+
+// A JAR (ZIP) archive mapped into memory. Opening it reads the central directory once into a
+// hash index by entry name, whose keys are views into the mapping, so finding an entry is a
+// single lookup however large the archive. Stored entries are returned in place; deflated ones
+// are inflated into a buffer of their own.
+class JarFile {
+ public:
+  JarFile(const JarFile&)            = delete;
+  JarFile(JarFile&&)                 = delete;
+  JarFile& operator=(const JarFile&) = delete;
+  JarFile& operator=(JarFile&&)      = delete;
+  ~JarFile()                         = default;
+
+  /**
+   * @brief Maps the archive at `path` and indexes its central directory
+   * @return nullptr if `path` is not a regular file that can be mapped
+   * @throws std::runtime_error if the file is not a ZIP archive or uses an unsupported format
+   * (ZIP64, encryption)
+   */
+  static std::unique_ptr<JarFile> open(const std::string& path);
+
+  size_t size() const { return entries_.size(); }
+  bool   contains(std::string_view name) const { return entries_.contains(name); }
+
+  /**
+   * @brief Names of the files directly in `directory` (e.g. "java/lang", or "" for the root),
+   * without the directory prefix
+   */
+  std::span<const std::string_view> list(std::string_view directory) const;
+
+  /**
+   * @brief Reads the entry `name`, e.g. "java/lang/Object.class"
+   * @return std::nullopt if there is no such entry
+   * @throws std::runtime_error if the entry is corrupt or uses an unsupported compression method
+   */
+  std::optional<ClassBytes> read(std::string_view name) const;
+
+ private:
+  explicit JarFile(std::shared_ptr<const MappedFile> file) : file_(std::move(file)) {}
+
+  struct Entry {
+    U4 local_header_offset;
+    U4 compressed_size;
+    U4 uncompressed_size;
+    U4 crc32;
+    U2 method;
+  };
+
+  void readCentralDirectory();
+
+  std::shared_ptr<const MappedFile>           file_;  // shared with the entries read
+  std::unordered_map<std::string_view, Entry> entries_;
+  // directory -> file names in it, built alongside entries_
+  std::unordered_map<std::string_view, std::vector<std::string_view>> directories_;
+};
+
+}  // namespace jvm::class_loader
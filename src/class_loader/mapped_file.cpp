@@ -0,0 +1,64 @@
+#include "mapped_file.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+namespace jvm::class_loader {
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+  : data_(std::exchange(other.data_, nullptr)), size_(std::exchange(other.size_, 0)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+  if (this != &other) {
+    unmap();
+    data_ = std::exchange(other.data_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() { unmap(); }
+
+void MappedFile::unmap() {
+  if (data_ != nullptr) {
+    ::munmap(const_cast<U1*>(data_), size_);  // NOLINT(*-const-cast)
+    data_ = nullptr;
+    size_ = 0;
+  }
+}
+
+std::optional<MappedFile> MappedFile::open(const std::string& path) {
+  int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT(*-vararg)
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0 || !S_ISREG(status.st_mode)) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  auto size = static_cast<size_t>(status.st_size);
+  if (size == 0) {
+    // mmap rejects empty mappings; an empty file is simply no bytes
+    ::close(fd);
+    return MappedFile();
+  }
+
+  void* data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  // the mapping keeps the file referenced on its own
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    return std::nullopt;
+  }
+  // the parser reads front to back once and attributes may be read again later: ask for
+  // readahead now, the hints are best effort
+  ::madvise(data, size, MADV_SEQUENTIAL);
+  ::madvise(data, size, MADV_WILLNEED);
+  return MappedFile(static_cast<const U1*>(data), size);
+}
+
+}  // namespace jvm::class_loader
@@ -0,0 +1,76 @@
+/**
+ * @file mapped_file.h
+ * @author Rive Chen
+ * @brief Read-only memory mapping of a file, and the bytes of a class file
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+
+namespace jvm::class_loader {
+
+// A whole file mapped read-only into memory, unmapped on destruction. Reading a class file this
+// way costs open, fstat, mmap and close, with no copy: the parser reads the page cache directly.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  MappedFile(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+  ~MappedFile();
+
+  /**
+   * @brief Maps the regular file at `path`
+   * @return std::nullopt if it does not exist, is not a regular file, or cannot be mapped
+   */
+  static std::optional<MappedFile> open(const std::string& path);
+
+  std::span<const U1> getBytes() const { return {data_, size_}; }
+  size_t              size() const { return size_; }
+
+ private:
+  MappedFile(const U1* data, size_t size) : data_(data), size_(size) {}
+
+  void unmap();
+
+  const U1* data_{nullptr};
+  size_t    size_{0};
+};
+
+// The bytes of one class file together with whatever keeps them alive: the mapped .class file,
+// the mapped archive a stored JAR entry lies in, or the buffer a compressed entry was inflated
+// into. Views left by the parser (e.g. GenericAttribute::info) are valid while it lives.
+class ClassBytes {
+ public:
+  ClassBytes() = default;
+  ClassBytes(std::shared_ptr<const MappedFile> file, std::span<const U1> bytes)
+    : file_(std::move(file)), bytes_(bytes) {}
+  explicit ClassBytes(std::vector<U1> buffer) : buffer_(std::move(buffer)), bytes_(buffer_) {}
+  ClassBytes(const ClassBytes&)            = delete;
+  ClassBytes(ClassBytes&&)                 = default;  // moving a vector keeps its storage
+  ClassBytes& operator=(const ClassBytes&) = delete;
+  ClassBytes& operator=(ClassBytes&&)      = default;
+  ~ClassBytes()                            = default;
+
+  std::span<const U1> getBytes() const { return bytes_; }
+
+ private:
+  std::shared_ptr<const MappedFile> file_;
+  std::vector<U1>                   buffer_;
+  std::span<const U1>               bytes_;
+};
+
+}  // namespace jvm::class_loader
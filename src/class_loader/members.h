@@ -1,5 +1,9 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "attributes.hpp"
 #include "common/access_flags.hpp"
 #include "common/types.h"
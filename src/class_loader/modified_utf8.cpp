@@ -0,0 +1,179 @@
+#include "modified_utf8.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace jvm::class_loader {
+
+namespace {
+
+// isAsciiBlock: whether kBlockSize bytes are all ASCII other than 0
+// widenBlock: the same bytes zero-extended to UTF-16 code units
+#if defined(__AVX2__)
+constexpr size_t kBlockSize = 32;
+
+bool isAsciiBlock(const U1* bytes) {
+  auto block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(bytes));  // NOLINT
+  auto zeros = _mm256_cmpeq_epi8(block, _mm256_setzero_si256());
+  // the sign bit is set in a non-ASCII byte and in the comparison result for a 0
+  return _mm256_movemask_epi8(_mm256_or_si256(block, zeros)) == 0;
+}
+
+void widenBlock(const U1* bytes, char16_t* units) {
+  for (size_t half = 0; half < kBlockSize; half += 16) {
+    auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes + half));  // NOLINT
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(units + half),              // NOLINT
+                        _mm256_cvtepu8_epi16(block));
+  }
+}
+#elif defined(__SSE2__)
+constexpr size_t kBlockSize = 16;
+
+bool isAsciiBlock(const U1* bytes) {
+  auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));  // NOLINT
+  auto zeros = _mm_cmpeq_epi8(block, _mm_setzero_si128());
+  // the sign bit is set in a non-ASCII byte and in the comparison result for a 0
+  return _mm_movemask_epi8(_mm_or_si128(block, zeros)) == 0;
+}
+
+void widenBlock(const U1* bytes, char16_t* units) {
+  auto block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(bytes));  // NOLINT
+  auto zero  = _mm_setzero_si128();
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(units), _mm_unpacklo_epi8(block, zero));  // NOLINT
+  _mm_storeu_si128(reinterpret_cast<__m128i*>(units + 8),                            // NOLINT
+                   _mm_unpackhi_epi8(block, zero));
+}
+#else
+constexpr size_t kBlockSize = 8;
+
+bool isAsciiBlock(const U1* bytes) {
+  constexpr U8 kOnes = 0x0101010101010101;
+  constexpr U8 kHigh = 0x8080808080808080;
+  U8           word  = 0;
+  std::memcpy(&word, bytes, sizeof(word));
+  // (word - kOnes) & ~word has the high bit set in some byte iff a byte of word is 0
+  return ((word | ((word - kOnes) & ~word)) & kHigh) == 0;
+}
+
+void widenBlock(const U1* bytes, char16_t* units) {
+  for (size_t i = 0; i < kBlockSize; i++) {
+    units[i] = bytes[i];
+  }
+}
+#endif
+
+// ASCII other than 0 stands for itself; 0 is always written as C0 80
+bool isAsciiByte(U1 byte) { return static_cast<U1>(byte - 1) < 0x7F; }
+
+bool isContinuation(U1 byte) { return (byte & 0xC0) == 0x80; }
+
+// The end of the run of ASCII starting at `pos`
+size_t asciiRunEnd(std::span<const U1> bytes, size_t pos) {
+  while (pos + kBlockSize <= bytes.size() && isAsciiBlock(bytes.data() + pos)) {
+    pos += kBlockSize;
+  }
+  while (pos < bytes.size() && isAsciiByte(bytes[pos])) {
+    pos++;
+  }
+  return pos;
+}
+
+// Decodes the two or three byte sequence at `pos`; returns its length, 0 if it is malformed
+size_t decodeSequence(std::span<const U1> bytes, size_t pos, char16_t& unit) {
+  size_t left = bytes.size() - pos;
+  U1     lead = bytes[pos];
+  if ((lead & 0xE0) == 0xC0 && left >= 2 && isContinuation(bytes[pos + 1])) {
+    unit = static_cast<char16_t>(((lead & 0x1F) << 6) | (bytes[pos + 1] & 0x3F));
+    return 2;
+  }
+  if ((lead & 0xF0) == 0xE0 && left >= 3 && isContinuation(bytes[pos + 1]) &&
+      isContinuation(bytes[pos + 2])) {
+    unit = static_cast<char16_t>(((lead & 0x0F) << 12) | ((bytes[pos + 1] & 0x3F) << 6) |
+                                 (bytes[pos + 2] & 0x3F));
+    return 3;
+  }
+  // a 0, a stray continuation byte, the lead of a four byte sequence, or a truncated sequence
+  return 0;
+}
+
+// Calls on_ascii with each run of ASCII and on_unit with the code unit of each multi-byte
+// sequence, in order; false if `bytes` is malformed
+template <typename OnAscii, typename OnUnit>
+bool decode(std::span<const U1> bytes, OnAscii on_ascii, OnUnit on_unit) {
+  size_t pos = 0;
+  while (pos < bytes.size()) {
+    if (size_t end = asciiRunEnd(bytes, pos); end != pos) {
+      on_ascii(bytes.subspan(pos, end - pos));
+      pos = end;
+      continue;
+    }
+    char16_t unit   = 0;
+    size_t   length = decodeSequence(bytes, pos, unit);
+    if (length == 0) {
+      return false;
+    }
+    on_unit(unit);
+    pos += length;
+  }
+  return true;
+}
+
+}  // namespace
+
+bool isValidModifiedUtf8(std::span<const U1> bytes) {
+  return decode(bytes, [](std::span<const U1>) {}, [](char16_t) {});
+}
+
+std::u16string modifiedUtf8ToUtf16(std::span<const U1> bytes) {
+  // no character takes fewer bytes than code units
+  std::u16string units(bytes.size(), u'\0');
+  size_t         count = 0;
+
+  auto widen = [&units, &count](std::span<const U1> ascii) {
+    auto*  out = units.data() + count;
+    size_t i   = 0;
+    for (; i + kBlockSize <= ascii.size(); i += kBlockSize) {
+      widenBlock(ascii.data() + i, out + i);
+    }
+    for (; i < ascii.size(); i++) {
+      out[i] = ascii[i];
+    }
+    count += ascii.size();
+  };
+  auto append = [&units, &count](char16_t unit) { units[count++] = unit; };
+  if (!decode(bytes, widen, append)) {
+    throw std::runtime_error("Malformed Modified UTF-8");
+  }
+  units.resize(count);
+  return units;
+}
+
+std::optional<std::string> modifiedUtf8ToLatin1(std::span<const U1> bytes) {
+  std::string latin1;
+  latin1.reserve(bytes.size());
+  bool fits = true;
+
+  auto copy = [&latin1](std::span<const U1> ascii) {
+    latin1.append(reinterpret_cast<const char*>(ascii.data()), ascii.size());  // NOLINT
+  };
+  // decoding goes on after a wide character, so that malformed input still throws
+  auto append = [&latin1, &fits](char16_t unit) {
+    fits = fits && unit <= 0xFF;
+    latin1.push_back(static_cast<char>(unit));
+  };
+  if (!decode(bytes, copy, append)) {
+    throw std::runtime_error("Malformed Modified UTF-8");
+  }
+  if (!fits) {
+    return std::nullopt;
+  }
+  return latin1;
+}
+
+}  // namespace jvm::class_loader
@@ -0,0 +1,51 @@
+/**
+ * @file modified_utf8.h
+ * @author Rive Chen
+ * @brief Validation and transcoding of the Modified UTF-8 in class files
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <optional>
+#include <span>
+#include <string>
+
+#include "common/types.h"
+
+namespace jvm::class_loader {
+
+// JVMS §4.4.7. Modified UTF-8 differs from UTF-8 in two ways: U+0000 is written as the two
+// bytes C0 80, so no byte is ever 0, and a supplementary character is written as its two
+// UTF-16 surrogates, three bytes each, so no sequence is longer than three bytes. Like
+// DataInput.readUTF, well-formed two and three byte sequences are accepted whatever value they
+// encode.
+//
+// Symbols keep the Modified UTF-8 bytes as they are in the class file; only string literals
+// are transcoded. Every function scans runs of ASCII a vector at a time (AVX2 when the build
+// enables it, SSE2 on any x86-64, eight bytes in a word otherwise) and falls back to a byte at
+// a time only for multi-byte sequences, so mostly-ASCII input costs about a copy.
+
+/**
+ * @brief Whether `bytes` is well-formed Modified UTF-8
+ */
+bool isValidModifiedUtf8(std::span<const U1> bytes);
+
+/**
+ * @brief Decodes `bytes` to UTF-16 code units
+ * @throws std::runtime_error if `bytes` is not well-formed Modified UTF-8
+ */
+std::u16string modifiedUtf8ToUtf16(std::span<const U1> bytes);
+
+/**
+ * @brief Decodes `bytes` to Latin-1, the compact form of a string whose characters all fit
+ * in a byte
+ * @return std::nullopt if a character is above U+00FF
+ * @throws std::runtime_error if `bytes` is not well-formed Modified UTF-8
+ */
+std::optional<std::string> modifiedUtf8ToLatin1(std::span<const U1> bytes);
+
+}  // namespace jvm::class_loader
@@ -0,0 +1,344 @@
+#include "shared_archive.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include "byte_reader.hpp"
+#include "common/endian.hpp"
+#include "engine/bytecode_reader.h"
+#include "runtime/klass.h"
+#include "runtime/symbol.h"
+
+namespace jvm::class_loader {
+
+namespace {
+
+// Layout, big-endian like a class file:
+//   U4 magic, U2 format version
+//   U2 classpath entry count, then per entry: U2 length, bytes, U8 size, U8 modification time
+//   U4 symbol count, then per symbol: U4 length, bytes
+//   U4 class count, then per class: U4 name symbol, U4 record length, record
+// A class record:
+//   U2 major, U2 minor, U2 access flags, U2 this_class, U2 super_class
+//   U2 interface count, U2 per interface
+//   U2 constant pool count, then per index from 1: U1 tag, U8 value (a Utf8's symbol index)
+//   U2 method count, then per method: U2 access flags, U4 name, U4 descriptor, U2 max_stack,
+//     U2 max_locals, U4 code length, code, U2 handler count, 4 x U2 per handler
+//   U2 field count, then per field: U2 access flags, U4 name, U4 descriptor
+constexpr U4 kArchiveMagic   = 0x4A434453;  // "JCDS"
+constexpr U2 kArchiveVersion = 2;
+
+class ArchiveWriter {
+ public:
+  template <typename T>
+  void write(T value) {
+    value = common::swapEndian(value);
+    U1 bytes[sizeof(T)];  // NOLINT(*-avoid-c-arrays)
+    std::memcpy(bytes, &value, sizeof(T));
+    bytes_.insert(bytes_.end(), bytes, bytes + sizeof(T));
+  }
+
+  void writeBytes(std::span<const U1> bytes) {
+    bytes_.insert(bytes_.end(), bytes.begin(), bytes.end());
+  }
+  void writeBytes(std::string_view bytes) {
+    writeBytes(std::span(reinterpret_cast<const U1*>(bytes.data()), bytes.size()));  // NOLINT
+  }
+
+  const std::vector<U1>& getBytes() const { return bytes_; }
+
+ private:
+  std::vector<U1> bytes_;
+};
+
+// Numbers the symbols a dump refers to, in order of first use
+class SymbolIndex {
+ public:
+  U4 indexOf(const runtime::Symbol* symbol) {
+    auto [it, inserted] = indices_.try_emplace(symbol, static_cast<U4>(symbols_.size()));
+    if (inserted) {
+      symbols_.push_back(symbol);
+    }
+    return it->second;
+  }
+
+  const std::vector<const runtime::Symbol*>& getSymbols() const { return symbols_; }
+
+ private:
+  std::unordered_map<const runtime::Symbol*, U4> indices_;
+  std::vector<const runtime::Symbol*>            symbols_;
+};
+
+void writeClass(ArchiveWriter& out, SymbolIndex& symbols, const runtime::Klass& klass) {
+  const auto* class_file = klass.getClassFile();
+  const auto& cp         = class_file->constant_pool;
+
+  out.write<U2>(class_file->version.getMajor());
+  out.write<U2>(class_file->version.getMinor());
+  out.write<U2>(class_file->access_flags.getFlags());
+  out.write<U2>(class_file->this_class_index);
+  out.write<U2>(class_file->super_class_index);
+  out.write<U2>(static_cast<U2>(class_file->interfaces.size()));
+  for (auto interface_index : class_file->interfaces) {
+    out.write<U2>(interface_index);
+  }
+
+  out.write<U2>(static_cast<U2>(cp.size()));
+  for (U2 i = 1; i < cp.size(); i++) {
+    auto tag = cp.getTag(i);
+    out.write<U1>(static_cast<U1>(tag));
+    out.write<U8>(tag == ConstantTag::kUtf8 ? symbols.indexOf(cp.getUtf8Symbol(i))
+                                            : cp.getRawValue(i));
+  }
+
+  out.write<U2>(static_cast<U2>(klass.getMethods().size()));
+  for (const auto& method : klass.getMethods()) {
+    out.write<U2>(method.getAccessFlags().getFlags());
+    out.write<U4>(symbols.indexOf(method.getNameSymbol()));
+    out.write<U4>(symbols.indexOf(method.getDescriptorSymbol()));
+    out.write<U2>(method.getMaxStack());
+    out.write<U2>(method.getMaxLocals());
+    // as in the class file: quickening assumes classes the next VM has not initialized yet
+    std::vector<U1> code(method.getCode().begin(), method.getCode().end());
+    engine::unquicken(code);
+    out.write<U4>(static_cast<U4>(code.size()));
+    out.writeBytes(code);
+    auto handlers = method.getExceptionTable().getHandlers();
+    out.write<U2>(static_cast<U2>(handlers.size()));
+    for (const auto& handler : handlers) {
+      out.write<U2>(handler.start_pc);
+      out.write<U2>(handler.end_pc);
+      out.write<U2>(handler.handler_pc);
+      out.write<U2>(handler.catch_type);
+    }
+  }
+
+  out.write<U2>(static_cast<U2>(klass.getFields().size()));
+  for (const auto& field : klass.getFields()) {
+    out.write<U2>(field.getAccessFlags().getFlags());
+    out.write<U4>(symbols.indexOf(field.getNameSymbol()));
+    out.write<U4>(symbols.indexOf(field.getDescriptorSymbol()));
+  }
+}
+
+ClasspathStamp stampOf(const std::string& entry) {
+  namespace fs = std::filesystem;
+  ClasspathStamp  stamp;
+  std::error_code error;
+  auto            add = [&stamp](const fs::directory_entry& file) {
+    auto modified_time  = file.last_write_time().time_since_epoch().count();
+    stamp.size          += file.file_size();
+    stamp.modified_time  = std::max(stamp.modified_time, static_cast<U8>(modified_time));
+  };
+  fs::directory_entry root(entry, error);
+  if (error || !root.exists()) {
+    return stamp;
+  }
+  if (!root.is_directory()) {
+    add(root);
+    return stamp;
+  }
+  for (const auto& file : fs::recursive_directory_iterator(root, error)) {
+    if (file.is_regular_file()) {
+      add(file);
+    }
+  }
+  return stamp;
+}
+
+std::string_view readString(ByteReader& reader, size_t length) {
+  auto bytes = reader.readSpan(length);
+  return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};  // NOLINT
+}
+
+}  // namespace
+
+void SharedArchive::dump(const std::string& path, const std::vector<std::string>& classpath,
+                         std::span<runtime::Klass* const> classes) {
+  // records first: they number the symbols, which the file lists before them
+  SymbolIndex   symbols;
+  ArchiveWriter records;
+  for (const auto* klass : classes) {
+    ArchiveWriter record;
+    writeClass(record, symbols, *klass);
+    records.write<U4>(symbols.indexOf(klass->getNameSymbol()));
+    records.write<U4>(static_cast<U4>(record.getBytes().size()));
+    records.writeBytes(record.getBytes());
+  }
+
+  ArchiveWriter out;
+  out.write<U4>(kArchiveMagic);
+  out.write<U2>(kArchiveVersion);
+  out.write<U2>(static_cast<U2>(classpath.size()));
+  for (const auto& entry : classpath) {
+    auto stamp = stampOf(entry);
+    out.write<U2>(static_cast<U2>(entry.size()));
+    out.writeBytes(entry);
+    out.write<U8>(stamp.size);
+    out.write<U8>(stamp.modified_time);
+  }
+  out.write<U4>(static_cast<U4>(symbols.getSymbols().size()));
+  for (const auto* symbol : symbols.getSymbols()) {
+    out.write<U4>(static_cast<U4>(symbol->size()));
+    out.writeBytes(symbol->view());
+  }
+  out.write<U4>(static_cast<U4>(classes.size()));
+  out.writeBytes(records.getBytes());
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+  file.write(reinterpret_cast<const char*>(out.getBytes().data()),  // NOLINT
+             static_cast<std::streamsize>(out.getBytes().size()));
+  if (!file) {
+    throw std::runtime_error("Cannot write shared archive " + path);
+  }
+}
+
+std::unique_ptr<SharedArchive> SharedArchive::open(const std::string& path) {
+  auto file = MappedFile::open(path);
+  if (!file.has_value()) {
+    return nullptr;
+  }
+  std::unique_ptr<SharedArchive> archive(new SharedArchive(std::move(*file)));
+  try {
+    archive->readIndex();
+  } catch (const std::out_of_range&) {
+    throw std::runtime_error("Truncated shared archive " + path);
+  }
+  return archive;
+}
+
+SharedArchive::~SharedArchive() {
+  for (const auto* symbol : symbols_) {
+    runtime::SymbolTable::release(symbol);
+  }
+}
+
+void SharedArchive::readIndex() {
+  ByteReader reader(file_.getBytes());
+  if (reader.read<U4>() != kArchiveMagic || reader.read<U2>() != kArchiveVersion) {
+    throw std::runtime_error("Not a shared archive of this VM version");
+  }
+
+  U2 classpath_count = reader.read<U2>();
+  classpath_.reserve(classpath_count);
+  classpath_stamps_.reserve(classpath_count);
+  for (U2 i = 0; i < classpath_count; i++) {
+    classpath_.emplace_back(readString(reader, reader.read<U2>()));
+    U8 size          = reader.read<U8>();
+    U8 modified_time = reader.read<U8>();
+    classpath_stamps_.push_back({.size = size, .modified_time = modified_time});
+  }
+
+  auto& symbol_table = runtime::SymbolTable::getInstance();
+  U4    symbol_count = reader.read<U4>();
+  symbols_.reserve(symbol_count);
+  for (U4 i = 0; i < symbol_count; i++) {
+    symbols_.push_back(symbol_table.intern(readString(reader, reader.read<U4>())));
+  }
+
+  U4 class_count = reader.read<U4>();
+  classes_.reserve(class_count);
+  for (U4 i = 0; i < class_count; i++) {
+    U4 name   = reader.read<U4>();
+    U4 length = reader.read<U4>();
+    if (name >= symbols_.size()) {
+      throw std::runtime_error("Corrupt shared archive: bad class name");
+    }
+    // the key views the interned symbol, which the archive holds until destroyed
+    classes_.emplace(symbols_[name]->view(), reader.readSpan(length));
+  }
+}
+
+bool SharedArchive::matchesClasspath(const std::vector<std::string>& classpath) const {
+  if (classpath != classpath_) {
+    return false;
+  }
+  for (size_t i = 0; i < classpath.size(); i++) {
+    if (stampOf(classpath[i]) != classpath_stamps_[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+std::optional<ArchivedClass> SharedArchive::restore(std::string_view name) const {
+  auto it = classes_.find(name);
+  if (it == classes_.end()) {
+    return std::nullopt;
+  }
+
+  ByteReader reader(it->second);
+  auto       symbol = [this, &reader] {
+    U4 index = reader.read<U4>();
+    if (index >= symbols_.size()) {
+      throw std::runtime_error("Corrupt shared archive: bad symbol index");
+    }
+    return symbols_[index];
+  };
+
+  U2              major             = reader.read<U2>();
+  U2              minor             = reader.read<U2>();
+  U2              access_flags      = reader.read<U2>();
+  U2              this_class_index  = reader.read<U2>();
+  U2              super_class_index = reader.read<U2>();
+  U2              interfaces_count  = reader.read<U2>();
+  std::vector<U2> interfaces(interfaces_count);
+  for (auto& interface_index : interfaces) {
+    interface_index = reader.read<U2>();
+  }
+
+  ConstantPool constant_pool(reader.read<U2>());
+  for (U2 i = 1; i < constant_pool.size(); i++) {
+    auto tag   = static_cast<ConstantTag>(reader.read<U1>());
+    U8   value = reader.read<U8>();
+    if (tag == ConstantTag::kUtf8) {
+      if (value >= symbols_.size()) {
+        throw std::runtime_error("Corrupt shared archive: bad symbol index");
+      }
+      value = std::bit_cast<U8>(symbols_[value]);
+    }
+    constant_pool.setEntry(i, tag, value);
+  }
+
+  ArchivedClass archived;
+  archived.class_file = std::make_unique<ClassFile>(
+    Version(major, minor), std::move(constant_pool), AccessFlags<flags::Class>(access_flags),
+    this_class_index, super_class_index, interfaces_count, std::move(interfaces),
+    MemberTable({}), MemberTable({}), AttributeTable());
+
+  U2 method_count = reader.read<U2>();
+  archived.methods.reserve(method_count);
+  for (U2 i = 0; i < method_count; i++) {
+    ArchivedMethod method{.access_flags = AccessFlags<flags::Method>(reader.read<U2>()),
+                          .name         = symbol(),
+                          .descriptor   = symbol(),
+                          .max_stack    = reader.read<U2>(),
+                          .max_locals   = reader.read<U2>(),
+                          .code         = {},
+                          .handlers     = {}};
+    method.code = reader.readSpan(reader.read<U4>());
+    method.handlers.resize(reader.read<U2>());
+    for (auto& handler : method.handlers) {
+      handler.start_pc   = reader.read<U2>();
+      handler.end_pc     = reader.read<U2>();
+      handler.handler_pc = reader.read<U2>();
+      handler.catch_type = reader.read<U2>();
+    }
+    archived.methods.push_back(std::move(method));
+  }
+
+  U2 field_count = reader.read<U2>();
+  archived.fields.reserve(field_count);
+  for (U2 i = 0; i < field_count; i++) {
+    archived.fields.push_back({.access_flags = AccessFlags<flags::Field>(reader.read<U2>()),
+                               .name         = symbol(),
+                               .descriptor   = symbol()});
+  }
+  return archived;
+}
+
+}  // namespace jvm::class_loader
@@ -0,0 +1,130 @@
+/**
+ * @file shared_archive.h
+ * @author Rive Chen
+ * @brief Class data sharing archive
+ * @version 0.1
+ * @date 2026-10-18
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "class_file.h"
+#include "common/access_flags.hpp"
+#include "common/types.h"
+#include "mapped_file.h"
+#include "runtime/exception_table.h"
+
+namespace jvm::runtime {
+class Klass;
+class Symbol;
+}  // namespace jvm::runtime
+
+namespace jvm::class_loader {
+
+// A method as the archive holds it; `code` points into the mapped archive
+struct ArchivedMethod {
+  AccessFlags<flags::Method>             access_flags;
+  const runtime::Symbol*                 name;
+  const runtime::Symbol*                 descriptor;
+  U2                                     max_stack;
+  U2                                     max_locals;
+  std::span<const U1>                    code;
+  std::vector<runtime::ExceptionHandler> handlers;
+};
+
+struct ArchivedField {
+  AccessFlags<flags::Field> access_flags;
+  const runtime::Symbol*    name;
+  const runtime::Symbol*    descriptor;
+};
+
+// What defining an archived class needs: a ClassFile with the constant pool, superclass and
+// interfaces filled in but no member or attribute tables, and the members already in the form
+// Klass keeps them
+struct ArchivedClass {
+  std::unique_ptr<ClassFile>  class_file;
+  std::vector<ArchivedMethod> methods;
+  std::vector<ArchivedField>  fields;
+};
+
+// What a classpath entry looked like when an archive was dumped: the size and modification time
+// of a JAR, the total size and latest modification time of the files under a directory, zeros
+// if there was no such entry
+struct ClasspathStamp {
+  U8 size          = 0;
+  U8 modified_time = 0;
+
+  bool operator==(const ClasspathStamp&) const = default;
+};
+
+// The class data sharing (CDS) archive: the linked metadata of a set of classes, written by a
+// -Xshare:dump run and mapped read-only by later runs, which define the classes from it
+// without finding, reading or parsing their class files. The file holds no pointers: symbols
+// are stored once and referred to by index, constant pool entries and members by the class
+// file indices and values they had, so it can be mapped at any address and its clean pages are
+// shared by every VM process that maps it.
+//
+// The archive records the classpath it was dumped with and a stamp of each of its entries, and
+// only serves class loaders with the same classpath whose entries have not changed since.
+class SharedArchive {
+ public:
+  SharedArchive(const SharedArchive&)            = delete;
+  SharedArchive(SharedArchive&&)                 = delete;
+  SharedArchive& operator=(const SharedArchive&) = delete;
+  SharedArchive& operator=(SharedArchive&&)      = delete;
+  ~SharedArchive();
+
+  /**
+   * @brief Writes an archive of `classes`, which must have been loaded from class files by a
+   * class loader with classpath `classpath`
+   * @throws std::runtime_error if the file cannot be written
+   */
+  static void dump(const std::string& path, const std::vector<std::string>& classpath,
+                   std::span<runtime::Klass* const> classes);
+
+  /**
+   * @brief Maps the archive at `path` and interns its symbols
+   * @return nullptr if there is no such file
+   * @throws std::runtime_error if the file is not an archive of this format version
+   */
+  static std::unique_ptr<SharedArchive> open(const std::string& path);
+
+  const std::vector<std::string>& getClasspath() const { return classpath_; }
+  size_t                          size() const { return classes_.size(); }
+  bool contains(std::string_view name) const { return classes_.contains(name); }
+
+  /**
+   * @brief Whether the archive was dumped with `classpath` and none of its entries has changed
+   * since; stats every file under the directory entries
+   */
+  bool matchesClasspath(const std::vector<std::string>& classpath) const;
+
+  /**
+   * @brief Decodes the class `name` ("java/lang/String")
+   * @return std::nullopt if the archive does not have it
+   */
+  std::optional<ArchivedClass> restore(std::string_view name) const;
+
+ private:
+  explicit SharedArchive(MappedFile file) : file_(std::move(file)) {}
+
+  void readIndex();
+
+  MappedFile                                                file_;
+  std::vector<std::string>                                  classpath_;
+  std::vector<ClasspathStamp>                               classpath_stamps_;
+  std::vector<const runtime::Symbol*>                       symbols_;
+  std::unordered_map<std::string_view, std::span<const U1>> classes_;  // name -> record
+};
+
+}  // namespace jvm::class_loader
@@ -1,15 +1,30 @@
 #pragma once
 
-#include <vector>
+#include <atomic>
+#include <span>
 
 #include "common/types.h"
+#include "opcode.h"
 
 namespace jvm::engine {
+
+/**
+ * @brief The opcode at `pc`. Quickening rewrites opcodes while other threads run the same code
+ * (runtime::Method::patchOpcode), so opcodes are read atomically; a relaxed load costs what a
+ * plain one does.
+ */
+inline U1 loadOpcode(std::span<const U1> code, size_t pc) {
+  // the code lives in writable metaspace, only the view of it is const
+  auto& opcode = const_cast<U1&>(code[pc]);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+  return std::atomic_ref<U1>(opcode).load(std::memory_order_relaxed);
+}
+
 class BytecodeReader {
  public:
-  BytecodeReader(const std::vector<U1>& code, size_t& pc) : code_(code), pc_(pc) {}
+  BytecodeReader(std::span<const U1> code, size_t& pc) : code_(code), pc_(pc) {}
 
   U1 readU1() { return code_[pc_++]; }
+  U1 readOpcode() { return loadOpcode(code_, pc_++); }
 
   U2 readU2() {
     U1 high = code_[pc_++];
@@ -46,11 +61,93 @@ class BytecodeReader {
   }
 
  private:
+  std::span<const U1> code_;
   // considering the lifetime is determined, we can use reference here
-  // NOLINTBEGIN(cppcoreguidelines-avoid-const-or-ref-data-members)
-  const std::vector<U1>& code_;
-  size_t&                pc_;
-  // NOLINTEND(cppcoreguidelines-avoid-const-or-ref-data-members)
+  size_t& pc_;  // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
 };
 
-}  // namespace jvm::engine
\ No newline at end of file
+/**
+ * @brief Length in bytes of the instruction at `pc`, operands and switch padding included
+ *
+ * Used to walk a method's code without executing it. `code` must be well-formed.
+ */
+inline size_t instructionLength(std::span<const U1> code, size_t pc) {
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  auto opcode = unquickened(loadOpcode(code, pc));
+  switch (opcode) {
+    case BIPUSH:
+    case LDC:
+    case ILOAD:
+    case LLOAD:
+    case FLOAD:
+    case DLOAD:
+    case ALOAD:
+    case ISTORE:
+    case LSTORE:
+    case FSTORE:
+    case DSTORE:
+    case ASTORE:
+    case RET:
+    case NEWARRAY:
+      return 2;
+    case SIPUSH:
+    case LDC_W:
+    case LDC2_W:
+    case IINC:
+    case GETSTATIC:
+    case PUTSTATIC:
+    case GETFIELD:
+    case PUTFIELD:
+    case INVOKEVIRTUAL:
+    case INVOKESPECIAL:
+    case INVOKESTATIC:
+    case NEW:
+    case ANEWARRAY:
+    case CHECKCAST:
+    case INSTANCEOF:
+    case IFNULL:
+    case IFNONNULL:
+      return 3;
+    case MULTIANEWARRAY:
+      return 4;
+    case INVOKEINTERFACE:
+    case INVOKEDYNAMIC:
+    case GOTO_W:
+    case JSR_W:
+      return 5;
+    case WIDE:
+      return code[pc + 1] == IINC ? 6 : 4;
+    case TABLESWITCH:
+    case LOOKUPSWITCH: {
+      size_t operands = pc + 1;
+      BytecodeReader reader(code, operands);
+      reader.align4();
+      reader.skip(4);  // default
+      if (opcode == TABLESWITCH) {
+        auto low  = reader.readSU4();
+        auto high = reader.readSU4();
+        reader.skip(static_cast<size_t>(high - low + 1) * 4);
+      } else {
+        auto npairs = reader.readSU4();
+        reader.skip(static_cast<size_t>(npairs) * 8);
+      }
+      return reader.currentPC() - pc;
+    }
+    default:
+      // conditional branches and GOTO/JSR take a 2-byte offset
+      return opcode >= IFEQ && opcode <= JSR ? 3 : 1;
+  }
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+}
+
+/**
+ * @brief Rewrites every quick instruction in `code` back to its standard form, for code that
+ * leaves the VM (the shared archive)
+ */
+inline void unquicken(std::span<U1> code) {
+  for (size_t pc = 0; pc < code.size(); pc += instructionLength(code, pc)) {
+    code[pc] = unquickened(code[pc]);
+  }
+}
+
+}  // namespace jvm::engine
@@ -1,66 +1,392 @@
 
 #include "interpreter.h"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <string>
 
 #include "bytecode_reader.h"
 #include "common/types.h"
 #include "opcode.h"
 #include "runtime/frame.h"
+#include "runtime/implicit_checks.h"
 #include "runtime/klass.h"
+#include "runtime/memo_cache.h"
 #include "runtime/method.h"
+#include "runtime/safepoint.h"
 #include "runtime/thread.h"
+#include "runtime/throwable.h"
+#include "runtime/vm_options.h"
+#include "runtime/well_known_classes.h"
 
 namespace {
 
-// NOLINTBEGIN(readability-function-cognitive-complexity)
-jvm::U2 calculateArgSlotCount(const std::string& descriptor) {
-  jvm::U2 slot_count = 0;
-  for (size_t i = 1; i < descriptor.length(); ++i) {
-    char c = descriptor[i];
-    if (c == ')') {
-      break;
+// Returns the pc of the first handler of `method` that covers `pc` and catches `exception`.
+// A handler whose catch type cannot be loaded is passed over: nothing thrown can be an instance
+// of it, and the exception being dispatched must not be lost to the resolution failure.
+std::optional<size_t> findExceptionHandler(jvm::runtime::Method* method, size_t pc,
+                                           jvm::runtime::Throwable* exception) {
+  auto& rt_cp = method->getOwnerKlass()->getRuntimeConstantPool();
+  for (const auto& handler : method->getExceptionTable().findCandidates(pc)) {
+    if (handler.catch_type == 0) {
+      return handler.handler_pc;  // finally / catch-all
     }
-    if (c == 'L') {
-      // object reference: Ljava/lang/String;
-      // skip until ';'
-      while (descriptor[i] != ';') {
-        i++;
-      }
-      slot_count++;
-    } else if (c == '[') {
-      // array: [[I or [Ljava/lang/String;
-      // array reference only takes 1 slot, skip all '['
-      while (descriptor[i + 1] == '[') {
-        i++;
+    jvm::runtime::Klass* catch_klass = nullptr;
+    try {
+      catch_klass = rt_cp.resolveClass(handler.catch_type);
+    } catch (const std::runtime_error&) {
+      continue;
+    }
+    if (exception->getKlass()->isSubtypeOf(catch_klass)) {
+      return handler.handler_pc;
+    }
+  }
+  return std::nullopt;
+}
+
+// A throwable stored in a static field outlives the frames of the thread that owns it, which
+// then no longer keep it alive (see runtime::Thread::newThrowable)
+void pinIfThrowable(const jvm::runtime::Field* field, jvm::runtime::Slot value) {
+  auto type = field->getDescriptor().front();
+  if (value.r == nullptr || (type != 'L' && type != '[')) {
+    return;
+  }
+  auto* object = static_cast<jvm::runtime::Object*>(value.r);
+  if (auto* throwable = dynamic_cast<jvm::runtime::Throwable*>(object)) {
+    throwable->pin();
+  }
+}
+
+// `klass`'s name as Java code spells it, for exception messages
+std::string binaryName(const jvm::runtime::Klass* klass) {
+  std::string name(klass->getName());
+  std::ranges::replace(name, '/', '.');
+  return name;
+}
+
+// An exception escaping a <clinit> reaches the code that triggered the initialization as is if
+// it is an Error, wrapped in an ExceptionInInitializerError otherwise (JVMS §5.5 step 11)
+jvm::runtime::Throwable* wrapInitializerException(jvm::runtime::Thread*    thread,
+                                                  jvm::runtime::Throwable* exception,
+                                                  size_t                   throw_pc) {
+  using jvm::runtime::WellKnownClass;
+  if (exception->getKlass()->isSubtypeOf(getWellKnownClass(WellKnownClass::kError))) {
+    return exception;
+  }
+  auto* wrapped = thread->newThrowable(
+    getWellKnownClass(WellKnownClass::kExceptionInInitializerError), exception->toString());
+  wrapped->fillInStackTrace(thread->getStack(), throw_pc);
+  thread->setPendingException(wrapped);
+  return wrapped;
+}
+
+// JVMS §5.5, step 7: once the initialization of `failed` fails, so does that of the classes
+// from `requested` up to it, which waited for their superclass. The classes above `failed` are
+// initialized already and stay so.
+void failSubclassInitialization(jvm::runtime::Klass* requested,
+                                const jvm::runtime::Klass* failed) {
+  auto* klass = requested;
+  while (klass != nullptr && klass != failed) {
+    if (klass->claimInitialization() == jvm::runtime::Klass::InitClaim::kClaimed) {
+      klass->finishInitialization(false);
+    }
+    klass = klass->getSuperClass();
+  }
+}
+
+/**
+ * @brief Dispatches the thread's pending exception thrown at `throw_pc` in the current frame
+ *
+ * Walks the Java stack frame by frame: the first frame with a matching handler gets its
+ * operand stack reset to just the exception and execution resumes at the handler (`pc` is
+ * updated); frames without one are popped. This is an ordinary loop, no C++ exception is
+ * involved unless the exception escapes the last frame, in which case it is reported to the
+ * embedder as runtime::UncaughtException and stays pending on the thread.
+ */
+void dispatchException(jvm::runtime::Thread* thread, size_t throw_pc, size_t& pc) {
+  auto*  exception = thread->getPendingException();
+  size_t frame_pc  = throw_pc;
+  while (!thread->isStackEmpty()) {
+    auto& frame = thread->getCurrentFrame();
+    if (auto handler_pc = findExceptionHandler(frame.getMethod(), frame_pc, exception)) {
+      auto& op_stack = frame.getOperandStack();
+      op_stack.clear();
+      op_stack.pushRef(static_cast<jvm::runtime::Object*>(exception));
+      thread->clearPendingException();
+      thread->getStack().reguard();
+      pc = *handler_pc;
+      thread->setPC(pc);
+      return;
+    }
+
+    auto* initializing = frame.getInitializingKlass();
+    auto* requested    = frame.getRequestedKlass();
+    thread->popFrame();
+    if (initializing != nullptr) {
+      initializing->finishInitialization(false);
+      failSubclassInitialization(requested, initializing);
+    }
+    if (!thread->isStackEmpty()) {
+      auto& caller = thread->getCurrentFrame();
+      if (initializing != nullptr) {
+        // the caller is suspended at the instruction that triggered the initialization
+        frame_pc  = caller.getCallerPC();
+        exception = wrapInitializerException(thread, exception, frame_pc);
+        continue;
       }
-      if (descriptor[i + 1] == 'L') {
-        i++;
-        while (descriptor[i] != ';') {
-          i++;
-        }
-      } else {
-        i++;  // skip basic type characters
+      // the caller is suspended just past its invoke instruction. A resume address at the end
+      // of the code is not a call site (embedders use it for their entry frame), so no
+      // handler can cover it
+      frame_pc = caller.getCallerPC() < caller.getMethod()->getCode().size()
+                   ? caller.getCallerPC() - 1
+                   : caller.getMethod()->getCode().size();
+    }
+  }
+  thread->getStack().reguard();
+  throw jvm::runtime::UncaughtException(exception);
+}
+
+// Throws an implicit exception of a VM-defined class from the instruction at `throw_pc`.
+// Once a site has thrown often enough, it reuses the preallocated instance and skips the
+// stack walk altogether.
+void throwException(jvm::runtime::Thread* thread, jvm::runtime::WellKnownClass klass,
+                    std::string message, size_t throw_pc, size_t& pc) {
+  const auto&              options   = jvm::runtime::VMOptions::getInstance();
+  auto*                    method    = thread->getCurrentFrame().getMethod();
+  jvm::runtime::Throwable* exception = nullptr;
+  if (options.omit_stack_trace_in_fast_throw &&
+      method->countImplicitException(throw_pc) > options.fast_throw_threshold) {
+    exception = jvm::runtime::getPreallocatedException(klass);
+  } else {
+    exception = thread->newThrowable(jvm::runtime::getWellKnownClass(klass), std::move(message));
+    exception->fillInStackTrace(thread->getStack(), throw_pc);
+  }
+  thread->setPendingException(exception);
+  dispatchException(thread, throw_pc, pc);
+}
+
+// Bookkeeping on entry to `method`, whether called from Java or by the embedder
+template <typename Policy>
+void onMethodEntry(jvm::runtime::Method* method) {
+  if constexpr (Policy::kProfiling) {
+    method->incrementInvocationCount();
+  }
+  if constexpr (Policy::kSafepointPolls) {
+    jvm::runtime::Safepoint::getInstance().poll();
+  }
+}
+
+/**
+ * @brief The class initialization barrier of GETSTATIC, PUTSTATIC and INVOKESTATIC (JVMS §5.5)
+ * @return true if the instruction at `insn_pc` may use `klass` now. Otherwise it does not run
+ * and `pc` has moved: into an initializer, after which the instruction runs again, or to the
+ * handler of the error the class raised. `requested` is the class the instruction uses when
+ * `klass` is one of its superclasses.
+ */
+template <typename Policy>
+bool ensureInitialized(jvm::runtime::Thread* thread, jvm::runtime::Klass* klass, size_t insn_pc,
+                       size_t& pc, jvm::runtime::Klass* requested = nullptr) {
+  using jvm::runtime::Klass;
+  using jvm::runtime::WellKnownClass;
+  if (klass->isInitialized()) {
+    return true;
+  }
+  if (requested == nullptr) {
+    requested = klass;
+  }
+  // superclasses first: the instruction comes back here once each initializer returns
+  auto* super = klass->getSuperClass();
+  if (super != nullptr && !klass->getAccessFlags().has(jvm::flags::Class::INTERFACE) &&
+      !ensureInitialized<Policy>(thread, super, insn_pc, pc, requested)) {
+    return false;
+  }
+
+  switch (klass->claimInitialization()) {
+    case Klass::InitClaim::kDone:
+      return true;
+    case Klass::InitClaim::kErroneous:
+      failSubclassInitialization(requested, klass);
+      throwException(thread, WellKnownClass::kNoClassDefFoundError,
+                     "Could not initialize class " + binaryName(klass), insn_pc, pc);
+      return false;
+    case Klass::InitClaim::kClaimed:
+      break;
+  }
+
+  auto* clinit = klass->getClassInitializer();
+  if (clinit == nullptr) {
+    klass->finishInitialization(true);
+    return true;
+  }
+  jvm::runtime::Frame clinit_frame(clinit);
+  clinit_frame.setInitializingKlass(klass, requested);
+  thread->getCurrentFrame().setCallerPC(insn_pc);
+  if (!thread->pushFrame(std::move(clinit_frame))) {
+    klass->finishInitialization(false);
+    failSubclassInitialization(requested, klass);
+    throwException(thread, WellKnownClass::kStackOverflowError, "", insn_pc, pc);
+    return false;
+  }
+  onMethodEntry<Policy>(clinit);
+  pc = 0;
+  thread->setPC(pc);
+  return false;
+}
+
+// Rewrites the instruction at `insn_pc` of `method`, which passed the barrier of `klass`, to
+// `quick_opcode`. A class still being initialized by this thread keeps the barrier, for the
+// other threads that must wait at it.
+template <typename Policy>
+void quicken(jvm::runtime::Method* method, size_t insn_pc, jvm::U1 quick_opcode,
+             const jvm::runtime::Klass* klass) {
+  if constexpr (Policy::kQuickening) {
+    if (klass->isInitialized()) {
+      method->patchOpcode(insn_pc, quick_opcode);
+    }
+  }
+}
+
+// Run by a quick instruction before it touches its class: pairs with the release store of
+// Method::patchOpcode, so that the statics written by <clinit> are visible to this thread
+// too. Free on x86; a load barrier where loads may be reordered.
+void acquireQuickened() { std::atomic_thread_fence(std::memory_order_acquire); }
+
+// The int operators a trivial method may apply, with the same semantics as the opcodes
+jvm::Jint applyIntBinaryOp(jvm::U1 opcode, jvm::Jint lhs, jvm::Jint rhs) {
+  using namespace jvm::engine;  // NOLINT(google-build-using-namespace)
+  auto ulhs  = static_cast<jvm::U4>(lhs);
+  auto urhs  = static_cast<jvm::U4>(rhs);
+  auto shift = urhs & 0x1FU;  // NOLINT(cppcoreguidelines-avoid-magic-numbers)
+  switch (opcode) {
+    case IADD:
+      return static_cast<jvm::Jint>(ulhs + urhs);
+    case ISUB:
+      return static_cast<jvm::Jint>(ulhs - urhs);
+    case IMUL:
+      return static_cast<jvm::Jint>(ulhs * urhs);
+    case IAND:
+      return lhs & rhs;  // NOLINT(hicpp-signed-bitwise)
+    case IOR:
+      return lhs | rhs;  // NOLINT(hicpp-signed-bitwise)
+    case IXOR:
+      return lhs ^ rhs;  // NOLINT(hicpp-signed-bitwise)
+    case ISHL:
+      return static_cast<jvm::Jint>(ulhs << shift);
+    case ISHR:
+      return lhs >> shift;  // NOLINT(hicpp-signed-bitwise)
+    case IUSHR:
+      return static_cast<jvm::Jint>(ulhs >> shift);
+    default:
+      throw std::logic_error("Not a trivial int operator: " + std::to_string(opcode));
+  }
+}
+
+// Executes a call to a method recognized as trivial at link time directly on the caller's
+// operand stack: the arguments are popped and the result pushed as if a frame had run
+template <typename Policy>
+void invokeTrivial(jvm::runtime::Method* method, jvm::runtime::OperandStack& op_stack) {
+  using jvm::runtime::TrivialMethod;
+  constexpr bool kChecked = Policy::kBoundsChecks;
+  const auto&    trivial  = method->getTrivialMethod();
+
+  if constexpr (Policy::kProfiling) {
+    method->incrementInvocationCount();
+  }
+
+  // same slot order as the callee's local variables
+  std::array<jvm::runtime::Slot, TrivialMethod::kMaxArgSlots> args{};
+  for (int i = method->getArgSlotCount() - 1; i >= 0; i--) {
+    args[i] = op_stack.popSlot<kChecked>();
+  }
+  auto operand = [&args](const jvm::runtime::TrivialOperand& operand) {
+    return operand.is_arg ? args[operand.arg_slot] : operand.constant;
+  };
+
+  switch (trivial.kind) {
+    case TrivialMethod::Kind::kValue:
+      op_stack.pushSlot(operand(trivial.lhs));
+      if (trivial.wide) {
+        op_stack.pushSlot({.l = 0});  // placeholder on top, as pushLong/pushDouble do
       }
-      slot_count++;
-    } else if (c == 'J' || c == 'D') {
-      // long or double takes 2 slots
-      slot_count += 2;
-    } else {
-      // other basic types (I, F, B, C, S, Z) take 1 slot
-      slot_count++;
+      break;
+    case TrivialMethod::Kind::kIntBinaryOp: {
+      auto lhs = operand(trivial.lhs).i;
+      auto rhs = operand(trivial.rhs).i;
+      op_stack.pushInt(applyIntBinaryOp(trivial.opcode, lhs, rhs));
+    } break;
+    case TrivialMethod::Kind::kStaticGetter:
+      // set by canInlineTrivial
+      op_stack.pushSlot(*method->getStaticGetterSlot());
+      break;
+    case TrivialMethod::Kind::kNone:
+      break;
+  }
+}
+
+// A trivial static getter reads its field in place, which is only right once the field's
+// class is initialized; until then the call gets a frame, and its GETSTATIC the barrier. The
+// field's slot is looked up once, after which a call costs a single load.
+bool canInlineTrivial(jvm::runtime::Method* method) {
+  const auto& trivial = method->getTrivialMethod();
+  if (trivial.kind != jvm::runtime::TrivialMethod::Kind::kStaticGetter) {
+    return trivial.isTrivial();
+  }
+  if (method->getStaticGetterSlot() != nullptr) {
+    return true;
+  }
+  auto& rt_cp = method->getOwnerKlass()->getRuntimeConstantPool();
+  auto* field = rt_cp.resolveField(trivial.field_index);
+  auto* owner = field->getOwnerKlass();
+  if (!owner->isInitialized()) {
+    return false;
+  }
+  method->setStaticGetterSlot(&owner->getStaticSlot(field->getSlotIndex()));
+  return true;
+}
+
+// Stores the result of a returning frame that missed its method's memo cache
+void memoizeResult(jvm::runtime::Frame& callee_frame, jvm::runtime::Slot result) {
+  if (auto* cache = callee_frame.getMemoCache()) {
+    cache->insert(callee_frame.getMemoKey(), result);
+  }
+}
+
+// Target of a branch at `base` by `offset`. A non-forward branch closes a loop, so it is
+// where loops get profiled and where a long-running loop runs pending safepoint operations.
+template <typename Policy>
+size_t branchTarget(jvm::runtime::Method* method, size_t base, jvm::Jint offset) {
+  if (offset <= 0) {
+    if constexpr (Policy::kProfiling) {
+      method->incrementBackedgeCount();
+    }
+    if constexpr (Policy::kSafepointPolls) {
+      jvm::runtime::Safepoint::getInstance().poll();
     }
   }
-  return slot_count;
+  return base + offset;
 }
-// NOLINTEND(readability-function-cognitive-complexity)
 }  // namespace
 
 namespace jvm::engine {
 
 // (readability-function-size, hicpp-function-size, readability-function-cognitive-complexity)
 // NOLINTNEXTLINE
-void Interpreter::interpret(runtime::Thread* thread) {
+template <typename Policy>
+void Interpreter<Policy>::interpret(runtime::Thread* thread) {
+  constexpr bool kChecked = Policy::kBoundsChecks;
+  const bool     memoize  = runtime::VMOptions::getInstance().memoize_pure_methods;
+
+  runtime::installImplicitCheckHandlers();
+
+  // the embedder has already pushed the entry frame
+  if (!thread->isStackEmpty()) {
+    onMethodEntry<Policy>(thread->getCurrentFrame().getMethod());
+  }
+
   // cache pc to avoid fetching it from thread every time
   // for thread-pc, we only use it when the frame is popped or pushed
   size_t pc = 0;
@@ -88,8 +414,14 @@ void Interpreter::interpret(runtime::Thread* thread) {
     }
 
     // fetch opcode
-    BytecodeReader reader(code, pc);          // note we pass pc by ref here
-    auto           opcode = reader.readU1();  // note pc incremented by 1 here
+    BytecodeReader reader(code, pc);              // note we pass pc by ref here
+    auto           opcode = reader.readOpcode();  // note pc incremented by 1 here
+
+    if constexpr (Policy::kTracing) {
+      if (trace_hook_ != nullptr) {
+        trace_hook_(*method, pc - 1, opcode);
+      }
+    }
 
     // NOLINTBEGIN(bugprone-branch-clone)
     // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
@@ -153,11 +485,11 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Components: op_stack, thread (PC)
       case BIPUSH: {
         // byte integer push
-        op_stack.pushInt(reader.readU1());
+        op_stack.pushInt(reader.readSU1());
       } break;
       case SIPUSH: {
         // short integer push
-        op_stack.pushInt(reader.readU2());
+        op_stack.pushInt(reader.readSU2());
       } break;
       /* #endregion Push immediate values */
 
@@ -166,39 +498,52 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Function: Load constants from runtime constant pool onto operand stack
       // Components: rt_cp, op_stack, thread (PC)
       case LDC: {
-        auto index    = reader.readU1();
-        auto constant = rt_cp.getConstant(index);
-        if (std::holds_alternative<Jint>(constant)) {
-          op_stack.pushInt(std::get<Jint>(constant));
-        } else if (std::holds_alternative<Jfloat>(constant)) {
-          op_stack.pushFloat(std::get<Jfloat>(constant));
-        } else if (std::holds_alternative<std::string>(constant)) {
-          // For now, push char* for string literals
-          // TODO: implement proper string object creation
-          op_stack.pushRef(
-            static_cast<Jref>(const_cast<char*>(std::get<std::string>(constant).c_str())));
+        auto index = reader.readU1();
+        switch (rt_cp.getTag(index)) {
+          case runtime::CpTag::kInteger:
+            op_stack.pushInt(rt_cp.getInt(index));
+            break;
+          case runtime::CpTag::kFloat:
+            op_stack.pushFloat(rt_cp.getFloat(index));
+            break;
+          case runtime::CpTag::kString:
+            // For now, push char* for string literals
+            // TODO: implement proper string object creation
+            op_stack.pushRef(static_cast<Jref>(const_cast<char*>(rt_cp.getString(index)->data())));
+            break;
+          default:
+            break;
         }
       } break;
       case LDC_W: {
-        auto index    = reader.readU2();
-        auto constant = rt_cp.getConstant(index);
-        if (std::holds_alternative<Jint>(constant)) {
-          op_stack.pushInt(std::get<Jint>(constant));
-        } else if (std::holds_alternative<Jfloat>(constant)) {
-          op_stack.pushFloat(std::get<Jfloat>(constant));
-        } else if (std::holds_alternative<std::string>(constant)) {
-          // For now, push null reference for string literals
-          // TODO: implement proper string object creation
-          op_stack.pushRef(nullptr);
+        auto index = reader.readU2();
+        switch (rt_cp.getTag(index)) {
+          case runtime::CpTag::kInteger:
+            op_stack.pushInt(rt_cp.getInt(index));
+            break;
+          case runtime::CpTag::kFloat:
+            op_stack.pushFloat(rt_cp.getFloat(index));
+            break;
+          case runtime::CpTag::kString:
+            // For now, push null reference for string literals
+            // TODO: implement proper string object creation
+            op_stack.pushRef(nullptr);
+            break;
+          default:
+            break;
         }
       } break;
       case LDC2_W: {
-        auto index    = reader.readU2();
-        auto constant = rt_cp.getConstant(index);
-        if (std::holds_alternative<Jlong>(constant)) {
-          op_stack.pushLong(std::get<Jlong>(constant));
-        } else if (std::holds_alternative<Jdouble>(constant)) {
-          op_stack.pushDouble(std::get<Jdouble>(constant));
+        auto index = reader.readU2();
+        switch (rt_cp.getTag(index)) {
+          case runtime::CpTag::kLong:
+            op_stack.pushLong(rt_cp.getLong(index));
+            break;
+          case runtime::CpTag::kDouble:
+            op_stack.pushDouble(rt_cp.getDouble(index));
+            break;
+          default:
+            break;
         }
       } break;
       /* #endregion Push from constant pool */
@@ -209,107 +554,107 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Components: local_vars, op_stack, thread (PC)
       case ILOAD: {
         auto index = reader.readU1();
-        auto value = local_vars.getInt(index);
+        auto value = local_vars.getInt<kChecked>(index);
         op_stack.pushInt(value);
       } break;
       case LLOAD: {
         auto index = reader.readU1();
-        auto value = local_vars.getLong(index);
+        auto value = local_vars.getLong<kChecked>(index);
         op_stack.pushLong(value);
       } break;
       case FLOAD: {
         auto index = reader.readU1();
-        auto value = local_vars.getFloat(index);
+        auto value = local_vars.getFloat<kChecked>(index);
         op_stack.pushFloat(value);
       } break;
       case DLOAD: {
         auto index = reader.readU1();
-        auto value = local_vars.getDouble(index);
+        auto value = local_vars.getDouble<kChecked>(index);
         op_stack.pushDouble(value);
       } break;
       case ALOAD: {
         auto  index = reader.readU1();
-        auto* value = local_vars.getRef(index);
+        auto* value = local_vars.getRef<kChecked>(index);
         op_stack.pushRef(value);
       } break;
       case ILOAD_0: {
-        auto value = local_vars.getInt(0);
+        auto value = local_vars.getInt<kChecked>(0);
         op_stack.pushInt(value);
       } break;
       case ILOAD_1: {
-        auto value = local_vars.getInt(1);
+        auto value = local_vars.getInt<kChecked>(1);
         op_stack.pushInt(value);
       } break;
       case ILOAD_2: {
-        auto value = local_vars.getInt(2);
+        auto value = local_vars.getInt<kChecked>(2);
         op_stack.pushInt(value);
       } break;
       case ILOAD_3: {
-        auto value = local_vars.getInt(3);
+        auto value = local_vars.getInt<kChecked>(3);
         op_stack.pushInt(value);
       } break;
       case LLOAD_0: {
-        auto value = local_vars.getLong(0);
+        auto value = local_vars.getLong<kChecked>(0);
         op_stack.pushLong(value);
       } break;
       case LLOAD_1: {
-        auto value = local_vars.getLong(1);
+        auto value = local_vars.getLong<kChecked>(1);
         op_stack.pushLong(value);
       } break;
       case LLOAD_2: {
-        auto value = local_vars.getLong(2);
+        auto value = local_vars.getLong<kChecked>(2);
         op_stack.pushLong(value);
       } break;
       case LLOAD_3: {
-        auto value = local_vars.getLong(3);
+        auto value = local_vars.getLong<kChecked>(3);
         op_stack.pushLong(value);
       } break;
       case FLOAD_0: {
-        auto value = local_vars.getFloat(0);
+        auto value = local_vars.getFloat<kChecked>(0);
         op_stack.pushFloat(value);
       } break;
       case FLOAD_1: {
-        auto value = local_vars.getFloat(1);
+        auto value = local_vars.getFloat<kChecked>(1);
         op_stack.pushFloat(value);
       } break;
       case FLOAD_2: {
-        auto value = local_vars.getFloat(2);
+        auto value = local_vars.getFloat<kChecked>(2);
         op_stack.pushFloat(value);
       } break;
       case FLOAD_3: {
-        auto value = local_vars.getFloat(3);
+        auto value = local_vars.getFloat<kChecked>(3);
         op_stack.pushFloat(value);
       } break;
       case DLOAD_0: {
-        auto value = local_vars.getDouble(0);
+        auto value = local_vars.getDouble<kChecked>(0);
         op_stack.pushDouble(value);
       } break;
       case DLOAD_1: {
-        auto value = local_vars.getDouble(1);
+        auto value = local_vars.getDouble<kChecked>(1);
         op_stack.pushDouble(value);
       } break;
       case DLOAD_2: {
-        auto value = local_vars.getDouble(2);
+        auto value = local_vars.getDouble<kChecked>(2);
         op_stack.pushDouble(value);
       } break;
       case DLOAD_3: {
-        auto value = local_vars.getDouble(3);
+        auto value = local_vars.getDouble<kChecked>(3);
         op_stack.pushDouble(value);
       } break;
       case ALOAD_0: {
-        auto* value = local_vars.getRef(0);
+        auto* value = local_vars.getRef<kChecked>(0);
         op_stack.pushRef(value);
       } break;
       case ALOAD_1: {
-        auto* value = local_vars.getRef(1);
+        auto* value = local_vars.getRef<kChecked>(1);
         op_stack.pushRef(value);
       } break;
       case ALOAD_2: {
-        auto* value = local_vars.getRef(2);
+        auto* value = local_vars.getRef<kChecked>(2);
         op_stack.pushRef(value);
       } break;
       case ALOAD_3: {
-        auto* value = local_vars.getRef(3);
+        auto* value = local_vars.getRef<kChecked>(3);
         op_stack.pushRef(value);
       } break;
       case IALOAD:
@@ -344,108 +689,108 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Components: op_stack, local_vars, thread (PC)
       case ISTORE: {
         auto index = reader.readU1();
-        auto value = op_stack.popInt();
-        local_vars.setInt(index, value);
+        auto value = op_stack.popInt<kChecked>();
+        local_vars.setInt<kChecked>(index, value);
       } break;
       case LSTORE: {
         auto index = reader.readU1();
-        auto value = op_stack.popLong();
-        local_vars.setLong(index, value);
+        auto value = op_stack.popLong<kChecked>();
+        local_vars.setLong<kChecked>(index, value);
       } break;
       case FSTORE: {
         auto index = reader.readU1();
-        auto value = op_stack.popFloat();
-        local_vars.setFloat(index, value);
+        auto value = op_stack.popFloat<kChecked>();
+        local_vars.setFloat<kChecked>(index, value);
       } break;
       case DSTORE: {
         auto index = reader.readU1();
-        auto value = op_stack.popDouble();
-        local_vars.setDouble(index, value);
+        auto value = op_stack.popDouble<kChecked>();
+        local_vars.setDouble<kChecked>(index, value);
       } break;
       case ASTORE: {
         auto  index = reader.readU1();
-        auto* value = op_stack.popRef();
-        local_vars.setRef(index, value);
+        auto* value = op_stack.popRef<kChecked>();
+        local_vars.setRef<kChecked>(index, value);
       } break;
       case ISTORE_0: {
-        auto value = op_stack.popInt();
-        local_vars.setInt(0, value);
+        auto value = op_stack.popInt<kChecked>();
+        local_vars.setInt<kChecked>(0, value);
       } break;
       case ISTORE_1: {
-        auto value = op_stack.popInt();
-        local_vars.setInt(1, value);
+        auto value = op_stack.popInt<kChecked>();
+        local_vars.setInt<kChecked>(1, value);
       } break;
       case ISTORE_2: {
-        auto value = op_stack.popInt();
-        local_vars.setInt(2, value);
+        auto value = op_stack.popInt<kChecked>();
+        local_vars.setInt<kChecked>(2, value);
       } break;
       case ISTORE_3: {
-        auto value = op_stack.popInt();
-        local_vars.setInt(3, value);
+        auto value = op_stack.popInt<kChecked>();
+        local_vars.setInt<kChecked>(3, value);
       } break;
       case LSTORE_0: {
-        auto value = op_stack.popLong();
-        local_vars.setLong(0, value);
+        auto value = op_stack.popLong<kChecked>();
+        local_vars.setLong<kChecked>(0, value);
       } break;
       case LSTORE_1: {
-        auto value = op_stack.popLong();
-        local_vars.setLong(1, value);
+        auto value = op_stack.popLong<kChecked>();
+        local_vars.setLong<kChecked>(1, value);
       } break;
       case LSTORE_2: {
-        auto value = op_stack.popLong();
-        local_vars.setLong(2, value);
+        auto value = op_stack.popLong<kChecked>();
+        local_vars.setLong<kChecked>(2, value);
       } break;
       case LSTORE_3: {
-        auto value = op_stack.popLong();
-        local_vars.setLong(3, value);
+        auto value = op_stack.popLong<kChecked>();
+        local_vars.setLong<kChecked>(3, value);
       } break;
       case FSTORE_0: {
-        auto value = op_stack.popFloat();
-        local_vars.setFloat(0, value);
+        auto value = op_stack.popFloat<kChecked>();
+        local_vars.setFloat<kChecked>(0, value);
       } break;
       case FSTORE_1: {
-        auto value = op_stack.popFloat();
-        local_vars.setFloat(1, value);
+        auto value = op_stack.popFloat<kChecked>();
+        local_vars.setFloat<kChecked>(1, value);
       } break;
       case FSTORE_2: {
-        auto value = op_stack.popFloat();
-        local_vars.setFloat(2, value);
+        auto value = op_stack.popFloat<kChecked>();
+        local_vars.setFloat<kChecked>(2, value);
       } break;
       case FSTORE_3: {
-        auto value = op_stack.popFloat();
-        local_vars.setFloat(3, value);
+        auto value = op_stack.popFloat<kChecked>();
+        local_vars.setFloat<kChecked>(3, value);
       } break;
       case DSTORE_0: {
-        auto value = op_stack.popDouble();
-        local_vars.setDouble(0, value);
+        auto value = op_stack.popDouble<kChecked>();
+        local_vars.setDouble<kChecked>(0, value);
       } break;
       case DSTORE_1: {
-        auto value = op_stack.popDouble();
-        local_vars.setDouble(1, value);
+        auto value = op_stack.popDouble<kChecked>();
+        local_vars.setDouble<kChecked>(1, value);
       } break;
       case DSTORE_2: {
-        auto value = op_stack.popDouble();
-        local_vars.setDouble(2, value);
+        auto value = op_stack.popDouble<kChecked>();
+        local_vars.setDouble<kChecked>(2, value);
       } break;
       case DSTORE_3: {
-        auto value = op_stack.popDouble();
-        local_vars.setDouble(3, value);
+        auto value = op_stack.popDouble<kChecked>();
+        local_vars.setDouble<kChecked>(3, value);
       } break;
       case ASTORE_0: {
-        auto* value = op_stack.popRef();
-        local_vars.setRef(0, value);
+        auto* value = op_stack.popRef<kChecked>();
+        local_vars.setRef<kChecked>(0, value);
       } break;
       case ASTORE_1: {
-        auto* value = op_stack.popRef();
-        local_vars.setRef(1, value);
+        auto* value = op_stack.popRef<kChecked>();
+        local_vars.setRef<kChecked>(1, value);
       } break;
       case ASTORE_2: {
-        auto* value = op_stack.popRef();
-        local_vars.setRef(2, value);
+        auto* value = op_stack.popRef<kChecked>();
+        local_vars.setRef<kChecked>(2, value);
       } break;
       case ASTORE_3: {
-        auto* value = op_stack.popRef();
-        local_vars.setRef(3, value);
+        auto* value = op_stack.popRef<kChecked>();
+        local_vars.setRef<kChecked>(3, value);
       } break;
       case IASTORE:
         // TODO: implement iastore
@@ -460,7 +805,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
         // TODO: implement dastore
         break;
       case AASTORE:
-        // TODO: implement aastore
+        // TODO: implement aastore, with Klass::isSubtypeOf of the component class as its
+        // store check
         break;
       case BASTORE:
         // TODO: implement bastore
@@ -478,79 +824,79 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Function: Manipulate operand stack (pop, dup, swap operations)
       // Components: op_stack
       case POP: {
-        op_stack.popSlot();  // Pop one word (int, float, or reference)
+        op_stack.popSlot<kChecked>();  // Pop one word (int, float, or reference)
       } break;
       case POP2: {
-        op_stack.popSlot();  // long & double emplace 2 slots
-        op_stack.popSlot();  // Pop two words (long or double)
+        op_stack.popSlot<kChecked>();  // long & double emplace 2 slots
+        op_stack.popSlot<kChecked>();  // Pop two words (long or double)
       } break;
       case DUP: {
-        auto value = op_stack.popSlot();  // Pop one word
-        op_stack.pushSlot(value);         // Push it back
-        op_stack.pushSlot(value);         // Push it again (duplicate)
+        auto value = op_stack.popSlot<kChecked>();  // Pop one word
+        op_stack.pushSlot(value);                   // Push it back
+        op_stack.pushSlot(value);                   // Push it again (duplicate)
       } break;
       case DUP_X1: {
         // Duplicate the top value and insert it two slots down
         // Stack: ..., value2, value1 -> ..., value1, value2, value1
-        auto value1 = op_stack.popSlot();  // Pop value1 (top)
-        auto value2 = op_stack.popSlot();  // Pop value2
-        op_stack.pushSlot(value1);         // Push value1 (duplicate)
-        op_stack.pushSlot(value2);         // Push value2
-        op_stack.pushSlot(value1);         // Push value1 (original)
+        auto value1 = op_stack.popSlot<kChecked>();  // Pop value1 (top)
+        auto value2 = op_stack.popSlot<kChecked>();  // Pop value2
+        op_stack.pushSlot(value1);                   // Push value1 (duplicate)
+        op_stack.pushSlot(value2);                   // Push value2
+        op_stack.pushSlot(value1);                   // Push value1 (original)
       } break;
       case DUP_X2: {
         // Duplicate the top value and insert it three slots down
         // Stack: ..., value3, value2, value1 -> ..., value1, value3, value2, value1
-        auto value1 = op_stack.popSlot();  // Pop value1 (top)
-        auto value2 = op_stack.popSlot();  // Pop value2
-        auto value3 = op_stack.popSlot();  // Pop value3
-        op_stack.pushSlot(value1);         // Push value1 (duplicate)
-        op_stack.pushSlot(value3);         // Push value3
-        op_stack.pushSlot(value2);         // Push value2
-        op_stack.pushSlot(value1);         // Push value1 (original)
+        auto value1 = op_stack.popSlot<kChecked>();  // Pop value1 (top)
+        auto value2 = op_stack.popSlot<kChecked>();  // Pop value2
+        auto value3 = op_stack.popSlot<kChecked>();  // Pop value3
+        op_stack.pushSlot(value1);                   // Push value1 (duplicate)
+        op_stack.pushSlot(value3);                   // Push value3
+        op_stack.pushSlot(value2);                   // Push value2
+        op_stack.pushSlot(value1);                   // Push value1 (original)
       } break;
       case DUP2: {
         // Duplicate the top two values
         // Stack: ..., value2, value1 -> ..., value2, value1, value2, value1
-        auto value1 = op_stack.popSlot();  // Pop value1 (top)
-        auto value2 = op_stack.popSlot();  // Pop value2
-        op_stack.pushSlot(value2);         // Push value2 (duplicate)
-        op_stack.pushSlot(value1);         // Push value1 (duplicate)
-        op_stack.pushSlot(value2);         // Push value2 (original)
-        op_stack.pushSlot(value1);         // Push value1 (original)
+        auto value1 = op_stack.popSlot<kChecked>();  // Pop value1 (top)
+        auto value2 = op_stack.popSlot<kChecked>();  // Pop value2
+        op_stack.pushSlot(value2);                   // Push value2 (duplicate)
+        op_stack.pushSlot(value1);                   // Push value1 (duplicate)
+        op_stack.pushSlot(value2);                   // Push value2 (original)
+        op_stack.pushSlot(value1);                   // Push value1 (original)
       } break;
       case DUP2_X1: {
         // Duplicate the top two values and insert them three slots down
         // Stack: ..., value3, value2, value1 -> ..., value2, value1, value3, value2, value1
-        auto value1 = op_stack.popSlot();  // Pop value1 (top)
-        auto value2 = op_stack.popSlot();  // Pop value2
-        auto value3 = op_stack.popSlot();  // Pop value3
-        op_stack.pushSlot(value2);         // Push value2 (duplicate)
-        op_stack.pushSlot(value1);         // Push value1 (duplicate)
-        op_stack.pushSlot(value3);         // Push value3
-        op_stack.pushSlot(value2);         // Push value2 (original)
-        op_stack.pushSlot(value1);         // Push value1 (original)
+        auto value1 = op_stack.popSlot<kChecked>();  // Pop value1 (top)
+        auto value2 = op_stack.popSlot<kChecked>();  // Pop value2
+        auto value3 = op_stack.popSlot<kChecked>();  // Pop value3
+        op_stack.pushSlot(value2);                   // Push value2 (duplicate)
+        op_stack.pushSlot(value1);                   // Push value1 (duplicate)
+        op_stack.pushSlot(value3);                   // Push value3
+        op_stack.pushSlot(value2);                   // Push value2 (original)
+        op_stack.pushSlot(value1);                   // Push value1 (original)
       } break;
       case DUP2_X2: {
         // Duplicate the top two values and insert them four slots down
         // Stack: ..., value4, value3, value2, value1 -> ..., value2, value1, value4, value3,
         // value2, value1
-        auto value1 = op_stack.popSlot();  // Pop value1 (top)
-        auto value2 = op_stack.popSlot();  // Pop value2
-        auto value3 = op_stack.popSlot();  // Pop value3
-        auto value4 = op_stack.popSlot();  // Pop value4
-        op_stack.pushSlot(value2);         // Push value2 (duplicate)
-        op_stack.pushSlot(value1);         // Push value1 (duplicate)
-        op_stack.pushSlot(value4);         // Push value4
-        op_stack.pushSlot(value3);         // Push value3
-        op_stack.pushSlot(value2);         // Push value2 (original)
-        op_stack.pushSlot(value1);         // Push value1 (original)
+        auto value1 = op_stack.popSlot<kChecked>();  // Pop value1 (top)
+        auto value2 = op_stack.popSlot<kChecked>();  // Pop value2
+        auto value3 = op_stack.popSlot<kChecked>();  // Pop value3
+        auto value4 = op_stack.popSlot<kChecked>();  // Pop value4
+        op_stack.pushSlot(value2);                   // Push value2 (duplicate)
+        op_stack.pushSlot(value1);                   // Push value1 (duplicate)
+        op_stack.pushSlot(value4);                   // Push value4
+        op_stack.pushSlot(value3);                   // Push value3
+        op_stack.pushSlot(value2);                   // Push value2 (original)
+        op_stack.pushSlot(value1);                   // Push value1 (original)
       } break;
       case SWAP: {
-        auto value1 = op_stack.popSlot();  // Pop first word
-        auto value2 = op_stack.popSlot();  // Pop second word
-        op_stack.pushSlot(value1);         // Push first word
-        op_stack.pushSlot(value2);         // Push second word (now on top)
+        auto value1 = op_stack.popSlot<kChecked>();  // Pop first word
+        auto value2 = op_stack.popSlot<kChecked>();  // Pop second word
+        op_stack.pushSlot(value1);                   // Push first word
+        op_stack.pushSlot(value2);                   // Push second word (now on top)
       } break;
       /* #endregion Stack */
 
@@ -559,205 +905,243 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Function: Perform arithmetic operations on numeric values (add, subtract, multiply, divide,
       // remainder, negate, shift, bitwise) Components: op_stack
       case IADD: {
-        auto value2 = op_stack.popInt();
-        auto value1 = op_stack.popInt();
+        auto value2 = op_stack.popInt<kChecked>();
+        auto value1 = op_stack.popInt<kChecked>();
         op_stack.pushInt(value1 + value2);
       } break;
       case LADD: {
-        auto value2 = op_stack.popLong();
-        auto value1 = op_stack.popLong();
+        auto value2 = op_stack.popLong<kChecked>();
+        auto value1 = op_stack.popLong<kChecked>();
         op_stack.pushLong(value1 + value2);
       } break;
       case FADD: {
-        auto value2 = op_stack.popFloat();
-        auto value1 = op_stack.popFloat();
+        auto value2 = op_stack.popFloat<kChecked>();
+        auto value1 = op_stack.popFloat<kChecked>();
         op_stack.pushFloat(value1 + value2);
       } break;
       case DADD: {
-        auto value2 = op_stack.popDouble();
-        auto value1 = op_stack.popDouble();
+        auto value2 = op_stack.popDouble<kChecked>();
+        auto value1 = op_stack.popDouble<kChecked>();
         op_stack.pushDouble(value1 + value2);
       } break;
       case ISUB: {
-        auto value2 = op_stack.popInt();
-        auto value1 = op_stack.popInt();
+        auto value2 = op_stack.popInt<kChecked>();
+        auto value1 = op_stack.popInt<kChecked>();
         op_stack.pushInt(value1 - value2);
       } break;
       case LSUB: {
-        auto value2 = op_stack.popLong();
-        auto value1 = op_stack.popLong();
+        auto value2 = op_stack.popLong<kChecked>();
+        auto value1 = op_stack.popLong<kChecked>();
         op_stack.pushLong(value1 - value2);
       } break;
       case FSUB: {
-        auto value2 = op_stack.popFloat();
-        auto value1 = op_stack.popFloat();
+        auto value2 = op_stack.popFloat<kChecked>();
+        auto value1 = op_stack.popFloat<kChecked>();
         op_stack.pushFloat(value1 - value2);
       } break;
       case DSUB: {
-        auto value2 = op_stack.popDouble();
-        auto value1 = op_stack.popDouble();
+        auto value2 = op_stack.popDouble<kChecked>();
+        auto value1 = op_stack.popDouble<kChecked>();
         op_stack.pushDouble(value1 - value2);
       } break;
       case IMUL: {
-        auto value2 = op_stack.popInt();
-        auto value1 = op_stack.popInt();
+        auto value2 = op_stack.popInt<kChecked>();
+        auto value1 = op_stack.popInt<kChecked>();
         op_stack.pushInt(value1 * value2);
       } break;
       case LMUL: {
-        auto value2 = op_stack.popLong();
-        auto value1 = op_stack.popLong();
+        auto value2 = op_stack.popLong<kChecked>();
+        auto value1 = op_stack.popLong<kChecked>();
         op_stack.pushLong(value1 * value2);
       } break;
       case FMUL: {
-        auto value2 = op_stack.popFloat();
-        auto value1 = op_stack.popFloat();
+        auto value2 = op_stack.popFloat<kChecked>();
+        auto value1 = op_stack.popFloat<kChecked>();
         op_stack.pushFloat(value1 * value2);
       } break;
       case DMUL: {
-        auto value2 = op_stack.popDouble();
-        auto value1 = op_stack.popDouble();
+        auto value2 = op_stack.popDouble<kChecked>();
+        auto value1 = op_stack.popDouble<kChecked>();
         op_stack.pushDouble(value1 * value2);
       } break;
       case IDIV: {
-        auto value2 = op_stack.popInt();
-        auto value1 = op_stack.popInt();
-        if (value2 == 0) {
-          throw std::runtime_error("ArithmeticException: / by zero");
+        auto value2 = op_stack.popInt<kChecked>();
+        auto value1 = op_stack.popInt<kChecked>();
+        Jint quotient{};
+        Jint remainder{};
+        if (!runtime::trappingDivide(value1, value2, quotient, remainder)) {
+          if (value2 == 0) {
+            throwException(thread, runtime::WellKnownClass::kArithmeticException, "/ by zero",
+                           pc - 1, pc);
+            break;
+          }
+          // MIN_VALUE / -1 overflows back to MIN_VALUE (JLS 15.17.2)
+          quotient = value1;
         }
-        op_stack.pushInt(value1 / value2);
+        op_stack.pushInt(quotient);
       } break;
       case LDIV: {
-        auto value2 = op_stack.popLong();
-        auto value1 = op_stack.popLong();
-        if (value2 == 0) {
-          throw std::runtime_error("ArithmeticException: / by zero");
+        auto  value2 = op_stack.popLong<kChecked>();
+        auto  value1 = op_stack.popLong<kChecked>();
+        Jlong quotient{};
+        Jlong remainder{};
+        if (!runtime::trappingDivide(value1, value2, quotient, remainder)) {
+          if (value2 == 0) {
+            throwException(thread, runtime::WellKnownClass::kArithmeticException, "/ by zero",
+                           pc - 1, pc);
+            break;
+          }
+          // MIN_VALUE / -1 overflows back to MIN_VALUE (JLS 15.17.2)
+          quotient = value1;
         }
-        op_stack.pushLong(value1 / value2);
+        op_stack.pushLong(quotient);
       } break;
       case FDIV: {
-        auto value2 = op_stack.popFloat();
-        auto value1 = op_stack.popFloat();
+        auto value2 = op_stack.popFloat<kChecked>();
+        auto value1 = op_stack.popFloat<kChecked>();
         op_stack.pushFloat(value1 / value2);
       } break;
       case DDIV: {
-        auto value2 = op_stack.popDouble();
-        auto value1 = op_stack.popDouble();
+        auto value2 = op_stack.popDouble<kChecked>();
+        auto value1 = op_stack.popDouble<kChecked>();
         op_stack.pushDouble(value1 / value2);
       } break;
       case IREM: {
-        auto value2 = op_stack.popInt();
-        auto value1 = op_stack.popInt();
-        if (value2 == 0) {
-          throw std::runtime_error("ArithmeticException: / by zero");
+        auto value2 = op_stack.popInt<kChecked>();
+        auto value1 = op_stack.popInt<kChecked>();
+        Jint quotient{};
+        Jint remainder{};
+        if (!runtime::trappingDivide(value1, value2, quotient, remainder)) {
+          if (value2 == 0) {
+            throwException(thread, runtime::WellKnownClass::kArithmeticException, "/ by zero",
+                           pc - 1, pc);
+            break;
+          }
+          // MIN_VALUE % -1 is 0 (JLS 15.17.3)
+          remainder = 0;
         }
-        op_stack.pushInt(value1 % value2);
+        op_stack.pushInt(remainder);
       } break;
       case LREM: {
-        auto value2 = op_stack.popLong();
-        auto value1 = op_stack.popLong();
-        if (value2 == 0) {
-          throw std::runtime_error("ArithmeticException: / by zero");
+        auto  value2 = op_stack.popLong<kChecked>();
+        auto  value1 = op_stack.popLong<kChecked>();
+        Jlong quotient{};
+        Jlong remainder{};
+        if (!runtime::trappingDivide(value1, value2, quotient, remainder)) {
+          if (value2 == 0) {
+            throwException(thread, runtime::WellKnownClass::kArithmeticException, "/ by zero",
+                           pc - 1, pc);
+            break;
+          }
+          // MIN_VALUE % -1 is 0 (JLS 15.17.3)
+          remainder = 0;
         }
-        op_stack.pushLong(value1 % value2);
+        op_stack.pushLong(remainder);
       } break;
       case FREM: {
-        auto value2 = op_stack.popFloat();
-        auto value1 = op_stack.popFloat();
+        auto value2 = op_stack.popFloat<kChecked>();
+        auto value1 = op_stack.popFloat<kChecked>();
         op_stack.pushFloat(std::fmod(value1, value2));
       } break;
       case DREM: {
-        auto value2 = op_stack.popDouble();
-        auto value1 = op_stack.popDouble();
+        auto value2 = op_stack.popDouble<kChecked>();
+        auto value1 = op_stack.popDouble<kChecked>();
         op_stack.pushDouble(std::fmod(value1, value2));
       } break;
       case INEG: {
-        auto value = op_stack.popInt();
+        auto value = op_stack.popInt<kChecked>();
         op_stack.pushInt(-value);
       } break;
       case LNEG: {
-        auto value = op_stack.popLong();
+        auto value = op_stack.popLong<kChecked>();
         op_stack.pushLong(-value);
       } break;
       case FNEG: {
-        auto value = op_stack.popFloat();
+        auto value = op_stack.popFloat<kChecked>();
         op_stack.pushFloat(-value);
       } break;
       case DNEG: {
-        auto value = op_stack.popDouble();
+        auto value = op_stack.popDouble<kChecked>();
         op_stack.pushDouble(-value);
       } break;
       case ISHL: {
         // Integer shift left: value1 << (value2 & 0x1f)
-        auto shift_count = static_cast<U4>(op_stack.popInt()) & 0x1FU;  // Only use lower 5 bits
-        auto value       = static_cast<U4>(op_stack.popInt());
+        // Only use lower 5 bits
+        auto shift_count = static_cast<U4>(op_stack.popInt<kChecked>()) & 0x1FU;
+        auto value       = static_cast<U4>(op_stack.popInt<kChecked>());
         op_stack.pushInt(static_cast<Jint>(value << shift_count));
       } break;
       case LSHL: {
         // Long shift left: value1 << (value2 & 0x3f)
-        auto shift_count = static_cast<U4>(op_stack.popInt()) & 0x3FU;  // Only use lower 6 bits
-        auto value       = static_cast<U8>(op_stack.popLong());
+        // Only use lower 6 bits
+        auto shift_count = static_cast<U4>(op_stack.popInt<kChecked>()) & 0x3FU;
+        auto value       = static_cast<U8>(op_stack.popLong<kChecked>());
         op_stack.pushLong(static_cast<Jlong>(value << shift_count));
       } break;
       case ISHR: {
         // Integer arithmetic shift right: value1 >> (value2 & 0x1f)
-        auto shift_count = static_cast<U4>(op_stack.popInt()) & 0x1FU;  // Only use lower 5 bits
-        auto value       = op_stack.popInt();
+        // Only use lower 5 bits
+        auto shift_count = static_cast<U4>(op_stack.popInt<kChecked>()) & 0x1FU;
+        auto value       = op_stack.popInt<kChecked>();
         // NOLINTNEXTLINE(hicpp-signed-bitwise) yes we want to shift the sign bit
         op_stack.pushInt(value >> shift_count);
       } break;
       case LSHR: {
         // Long arithmetic shift right: value1 >> (value2 & 0x3f)
-        auto shift_count = static_cast<U4>(op_stack.popInt()) & 0x3FU;  // Only use lower 6 bits
-        auto value       = op_stack.popLong();
+        // Only use lower 6 bits
+        auto shift_count = static_cast<U4>(op_stack.popInt<kChecked>()) & 0x3FU;
+        auto value       = op_stack.popLong<kChecked>();
         // NOLINTNEXTLINE(hicpp-signed-bitwise) yes we want to shift the sign bit
         op_stack.pushLong(value >> shift_count);
       } break;
       case IUSHR: {
         // Integer logical shift right: (unsigned)value1 >>> (value2 & 0x1f)
-        auto shift_count = static_cast<U4>(op_stack.popInt()) & 0x1FU;  // Only use lower 5 bits
-        auto value       = static_cast<U4>(op_stack.popInt());
+        // Only use lower 5 bits
+        auto shift_count = static_cast<U4>(op_stack.popInt<kChecked>()) & 0x1FU;
+        auto value       = static_cast<U4>(op_stack.popInt<kChecked>());
         op_stack.pushInt(static_cast<Jint>(value >> shift_count));
       } break;
       case LUSHR: {
         // Long logical shift right: (unsigned)value1 >>> (value2 & 0x3f)
-        auto shift_count = static_cast<U4>(op_stack.popInt()) & 0x3FU;  // Only use lower 6 bits
-        auto value       = static_cast<U8>(op_stack.popLong());
+        // Only use lower 6 bits
+        auto shift_count = static_cast<U4>(op_stack.popInt<kChecked>()) & 0x3FU;
+        auto value       = static_cast<U8>(op_stack.popLong<kChecked>());
         op_stack.pushLong(static_cast<Jlong>(value >> shift_count));
       } break;
       case IAND: {
         // Integer bitwise AND
-        auto value2 = static_cast<U4>(op_stack.popInt());
-        auto value1 = static_cast<U4>(op_stack.popInt());
+        auto value2 = static_cast<U4>(op_stack.popInt<kChecked>());
+        auto value1 = static_cast<U4>(op_stack.popInt<kChecked>());
         op_stack.pushInt(static_cast<Jint>(value1 & value2));
       } break;
       case LAND: {
         // Long bitwise AND
-        auto value2 = static_cast<U8>(op_stack.popLong());
-        auto value1 = static_cast<U8>(op_stack.popLong());
+        auto value2 = static_cast<U8>(op_stack.popLong<kChecked>());
+        auto value1 = static_cast<U8>(op_stack.popLong<kChecked>());
         op_stack.pushLong(static_cast<Jlong>(value1 & value2));
       } break;
       case IOR: {
         // Integer bitwise OR
-        auto value2 = static_cast<U4>(op_stack.popInt());
-        auto value1 = static_cast<U4>(op_stack.popInt());
+        auto value2 = static_cast<U4>(op_stack.popInt<kChecked>());
+        auto value1 = static_cast<U4>(op_stack.popInt<kChecked>());
         op_stack.pushInt(static_cast<Jint>(value1 | value2));
       } break;
       case LOR: {
         // Long bitwise OR
-        auto value2 = static_cast<U8>(op_stack.popLong());
-        auto value1 = static_cast<U8>(op_stack.popLong());
+        auto value2 = static_cast<U8>(op_stack.popLong<kChecked>());
+        auto value1 = static_cast<U8>(op_stack.popLong<kChecked>());
         op_stack.pushLong(static_cast<Jlong>(value1 | value2));
       } break;
       case IXOR: {
         // Integer bitwise XOR
-        auto value2 = static_cast<U4>(op_stack.popInt());
-        auto value1 = static_cast<U4>(op_stack.popInt());
+        auto value2 = static_cast<U4>(op_stack.popInt<kChecked>());
+        auto value1 = static_cast<U4>(op_stack.popInt<kChecked>());
         op_stack.pushInt(static_cast<Jint>(value1 ^ value2));
       } break;
       case LXOR: {
         // Long bitwise XOR
-        auto value2 = static_cast<U8>(op_stack.popLong());
-        auto value1 = static_cast<U8>(op_stack.popLong());
+        auto value2 = static_cast<U8>(op_stack.popLong<kChecked>());
+        auto value1 = static_cast<U8>(op_stack.popLong<kChecked>());
         op_stack.pushLong(static_cast<Jlong>(value1 ^ value2));
       } break;
       /* #endregion Arithmetic */
@@ -769,8 +1153,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       case IINC: {
         auto index         = reader.readU1();
         auto const_val     = reader.readSU1();
-        auto current_value = local_vars.getInt(index);
-        local_vars.setInt(index, current_value + const_val);
+        auto current_value = local_vars.getInt<kChecked>(index);
+        local_vars.setInt<kChecked>(index, current_value + const_val);
       } break;
       /* #endregion IINC */
 
@@ -780,37 +1164,37 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Components: op_stack
       case I2L: {
         // Convert int to long
-        auto value = op_stack.popInt();
+        auto value = op_stack.popInt<kChecked>();
         op_stack.pushLong(static_cast<Jlong>(value));
       } break;
       case I2F: {
         // Convert int to float
-        auto value = op_stack.popInt();
+        auto value = op_stack.popInt<kChecked>();
         op_stack.pushFloat(static_cast<Jfloat>(value));
       } break;
       case I2D: {
         // Convert int to double
-        auto value = op_stack.popInt();
+        auto value = op_stack.popInt<kChecked>();
         op_stack.pushDouble(static_cast<Jdouble>(value));
       } break;
       case L2I: {
         // Convert long to int (truncate)
-        auto value = op_stack.popLong();
+        auto value = op_stack.popLong<kChecked>();
         op_stack.pushInt(static_cast<Jint>(value));
       } break;
       case L2F: {
         // Convert long to float
-        auto value = op_stack.popLong();
+        auto value = op_stack.popLong<kChecked>();
         op_stack.pushFloat(static_cast<Jfloat>(value));
       } break;
       case L2D: {
         // Convert long to double
-        auto value = op_stack.popLong();
+        auto value = op_stack.popLong<kChecked>();
         op_stack.pushDouble(static_cast<Jdouble>(value));
       } break;
       case F2I: {
         // Convert float to int (truncate towards zero)
-        auto value = op_stack.popFloat();
+        auto value = op_stack.popFloat<kChecked>();
         if (std::isnan(value) || std::isinf(value)) {
           op_stack.pushInt(0);
         } else {
@@ -819,7 +1203,7 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case F2L: {
         // Convert float to long (truncate towards zero)
-        auto value = op_stack.popFloat();
+        auto value = op_stack.popFloat<kChecked>();
         if (std::isnan(value) || std::isinf(value)) {
           op_stack.pushLong(0);
         } else {
@@ -828,12 +1212,12 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case F2D: {
         // Convert float to double
-        auto value = op_stack.popFloat();
+        auto value = op_stack.popFloat<kChecked>();
         op_stack.pushDouble(static_cast<Jdouble>(value));
       } break;
       case D2I: {
         // Convert double to int (truncate towards zero)
-        auto value = op_stack.popDouble();
+        auto value = op_stack.popDouble<kChecked>();
         if (std::isnan(value) || std::isinf(value)) {
           op_stack.pushInt(0);
         } else {
@@ -842,7 +1226,7 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case D2L: {
         // Convert double to long (truncate towards zero)
-        auto value = op_stack.popDouble();
+        auto value = op_stack.popDouble<kChecked>();
         if (std::isnan(value) || std::isinf(value)) {
           op_stack.pushLong(0);
         } else {
@@ -851,22 +1235,22 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case D2F: {
         // Convert double to float
-        auto value = op_stack.popDouble();
+        auto value = op_stack.popDouble<kChecked>();
         op_stack.pushFloat(static_cast<Jfloat>(value));
       } break;
       case I2B: {
         // Convert int to byte (sign extend)
-        auto value = op_stack.popInt();
+        auto value = op_stack.popInt<kChecked>();
         op_stack.pushInt(static_cast<Jint>(static_cast<Jbyte>(value)));
       } break;
       case I2C: {
         // Convert int to char (zero extend)
-        auto value = op_stack.popInt();
+        auto value = op_stack.popInt<kChecked>();
         op_stack.pushInt(static_cast<Jint>(static_cast<Jchar>(value)));
       } break;
       case I2S: {
         // Convert int to short (sign extend)
-        auto value = op_stack.popInt();
+        auto value = op_stack.popInt<kChecked>();
         op_stack.pushInt(static_cast<Jint>(static_cast<Jshort>(value)));
       } break;
       /* #endregion Conversions */
@@ -877,8 +1261,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Components: op_stack, thread (PC)
       case LCMP: {
         // Compare two longs: value1 - value2
-        auto value2 = op_stack.popLong();
-        auto value1 = op_stack.popLong();
+        auto value2 = op_stack.popLong<kChecked>();
+        auto value1 = op_stack.popLong<kChecked>();
         if (value1 > value2) {
           op_stack.pushInt(1);
         } else if (value1 < value2) {
@@ -889,8 +1273,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case FCMPL: {
         // Compare two floats, return -1 if either is NaN
-        auto value2 = op_stack.popFloat();
-        auto value1 = op_stack.popFloat();
+        auto value2 = op_stack.popFloat<kChecked>();
+        auto value1 = op_stack.popFloat<kChecked>();
         if (std::isnan(value1) || std::isnan(value2)) {
           op_stack.pushInt(-1);
         } else if (value1 > value2) {
@@ -903,8 +1287,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case FCMPG: {
         // Compare two floats, return 1 if either is NaN
-        auto value2 = op_stack.popFloat();
-        auto value1 = op_stack.popFloat();
+        auto value2 = op_stack.popFloat<kChecked>();
+        auto value1 = op_stack.popFloat<kChecked>();
         if (std::isnan(value1) || std::isnan(value2)) {
           op_stack.pushInt(1);
         } else if (value1 > value2) {
@@ -917,8 +1301,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case DCMPL: {
         // Compare two doubles, return -1 if either is NaN
-        auto value2 = op_stack.popDouble();
-        auto value1 = op_stack.popDouble();
+        auto value2 = op_stack.popDouble<kChecked>();
+        auto value1 = op_stack.popDouble<kChecked>();
         if (std::isnan(value1) || std::isnan(value2)) {
           op_stack.pushInt(-1);
         } else if (value1 > value2) {
@@ -931,8 +1315,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case DCMPG: {
         // Compare two doubles, return 1 if either is NaN
-        auto value2 = op_stack.popDouble();
-        auto value1 = op_stack.popDouble();
+        auto value2 = op_stack.popDouble<kChecked>();
+        auto value1 = op_stack.popDouble<kChecked>();
         if (std::isnan(value1) || std::isnan(value2)) {
           op_stack.pushInt(1);
         } else if (value1 > value2) {
@@ -946,153 +1330,153 @@ void Interpreter::interpret(runtime::Thread* thread) {
       case IFEQ: {
         // Branch if int value equals 0
         auto bass_addr     = pc - 1;
-        auto value         = op_stack.popInt();
+        auto value         = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value == 0) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IFNE: {
         // Branch if int value not equal to 0
         auto bass_addr     = pc - 1;
-        auto value         = op_stack.popInt();
+        auto value         = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value != 0) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IFLT: {
         // Branch if int value less than 0
         auto bass_addr     = pc - 1;
-        auto value         = op_stack.popInt();
+        auto value         = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value < 0) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IFGE: {
         // Branch if int value greater than or equal to 0
         auto bass_addr     = pc - 1;
-        auto value         = op_stack.popInt();
+        auto value         = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value >= 0) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IFGT: {
         // Branch if int value greater than 0
         auto bass_addr     = pc - 1;
-        auto value         = op_stack.popInt();
+        auto value         = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value > 0) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IFLE: {
         // Branch if int value less than or equal to 0
         auto bass_addr     = pc - 1;
-        auto value         = op_stack.popInt();
+        auto value         = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value <= 0) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ICMPEQ: {
         // Branch if two int values are equal
         auto bass_addr     = pc - 1;
-        auto value2        = op_stack.popInt();
-        auto value1        = op_stack.popInt();
+        auto value2        = op_stack.popInt<kChecked>();
+        auto value1        = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value1 == value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ICMPNE: {
         // Branch if two int values are not equal
         auto bass_addr     = pc - 1;
-        auto value2        = op_stack.popInt();
-        auto value1        = op_stack.popInt();
+        auto value2        = op_stack.popInt<kChecked>();
+        auto value1        = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value1 != value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ICMPLT: {
         // Branch if first int value less than second
         auto bass_addr     = pc - 1;
-        auto value2        = op_stack.popInt();
-        auto value1        = op_stack.popInt();
+        auto value2        = op_stack.popInt<kChecked>();
+        auto value1        = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value1 < value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ICMPGE: {
         // Branch if first int value greater than or equal to second
         auto bass_addr     = pc - 1;
-        auto value2        = op_stack.popInt();
-        auto value1        = op_stack.popInt();
+        auto value2        = op_stack.popInt<kChecked>();
+        auto value1        = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value1 >= value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ICMPGT: {
         // Branch if first int value greater than second
         auto bass_addr     = pc - 1;
-        auto value2        = op_stack.popInt();
-        auto value1        = op_stack.popInt();
+        auto value2        = op_stack.popInt<kChecked>();
+        auto value1        = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value1 > value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ICMPLE: {
         // Branch if first int value less than or equal to second
         auto bass_addr     = pc - 1;
-        auto value2        = op_stack.popInt();
-        auto value1        = op_stack.popInt();
+        auto value2        = op_stack.popInt<kChecked>();
+        auto value1        = op_stack.popInt<kChecked>();
         auto branch_offset = reader.readSU2();
         if (value1 <= value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ACMPEQ: {
         // Branch if two reference values are equal
         auto  bass_addr     = pc - 1;
-        auto* value2        = op_stack.popRef();
-        auto* value1        = op_stack.popRef();
+        auto* value2        = op_stack.popRef<kChecked>();
+        auto* value1        = op_stack.popRef<kChecked>();
         auto  branch_offset = reader.readSU2();
         if (value1 == value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IF_ACMPNE: {
         // Branch if two reference values are not equal
         auto  bass_addr     = pc - 1;
-        auto* value2        = op_stack.popRef();
-        auto* value1        = op_stack.popRef();
+        auto* value2        = op_stack.popRef<kChecked>();
+        auto* value1        = op_stack.popRef<kChecked>();
         auto  branch_offset = reader.readSU2();
         if (value1 != value2) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IFNULL: {
         // Branch if reference value is null
         auto  bass_addr     = pc - 1;
-        auto* value         = op_stack.popRef();
+        auto* value         = op_stack.popRef<kChecked>();
         auto  branch_offset = reader.readSU2();
         if (value == nullptr) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       case IFNONNULL: {
         // Branch if reference value is not null
         auto  bass_addr     = pc - 1;
-        auto* value         = op_stack.popRef();
+        auto* value         = op_stack.popRef<kChecked>();
         auto  branch_offset = reader.readSU2();
         if (value != nullptr) {
-          pc = bass_addr + branch_offset;
+          pc = branchTarget<Policy>(method, bass_addr, branch_offset);
         }
       } break;
       /* #endregion Comparisons */
@@ -1104,12 +1488,12 @@ void Interpreter::interpret(runtime::Thread* thread) {
       case GOTO: {
         auto bass_addr     = pc - 1;
         auto branch_offset = reader.readSU2();
-        pc                 = bass_addr + branch_offset;
+        pc                 = branchTarget<Policy>(method, bass_addr, branch_offset);
       } break;
       case GOTO_W: {
         auto bass_addr     = pc - 1;
         auto branch_offset = reader.readSU4();
-        pc                 = bass_addr + branch_offset;
+        pc                 = branchTarget<Policy>(method, bass_addr, branch_offset);
       } break;
       case JSR:
         // not used in Java SE 8
@@ -1136,11 +1520,11 @@ void Interpreter::interpret(runtime::Thread* thread) {
           jump_offsets[i] = reader.readSU4();
         }
         // pop index from operand stack
-        auto index = op_stack.popInt();
+        auto index = op_stack.popInt<kChecked>();
         if (index < low_bytes || index > high_bytes) {
-          pc = bass_addr + default_offset;
+          pc = branchTarget<Policy>(method, bass_addr, default_offset);
         } else {
-          pc = bass_addr + jump_offsets[index - low_bytes];
+          pc = branchTarget<Policy>(method, bass_addr, jump_offsets[index - low_bytes]);
         }
       } break;
       case LOOKUPSWITCH: {
@@ -1155,17 +1539,17 @@ void Interpreter::interpret(runtime::Thread* thread) {
           jump_offsets[i].second = reader.readSU4();
         }
         // pop key from operand stack
-        auto key   = op_stack.popInt();
+        auto key   = op_stack.popInt<kChecked>();
         bool found = false;
         for (size_t i = 0; i < jump_offsets.size(); i++) {
           if (key == jump_offsets[i].first) {
-            pc    = bass_addr + jump_offsets[i].second;
+            pc    = branchTarget<Policy>(method, bass_addr, jump_offsets[i].second);
             found = true;
             break;
           }
         }
         if (!found) {
-          pc = bass_addr + default_bytes;
+          pc = branchTarget<Policy>(method, bass_addr, default_bytes);
         }
       } break;
 
@@ -1177,7 +1561,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       // Components: thread, op_stack
       case IRETURN: {
         auto& callee_frame = thread->getCurrentFrame();
-        Jint  ret          = callee_frame.getOperandStack().popInt();
+        Jint  ret          = callee_frame.getOperandStack().popInt<kChecked>();
+        memoizeResult(callee_frame, {.i = ret});
         thread->popFrame();
         if (!thread->isStackEmpty()) {
           // push ret into caller frame's operand stack
@@ -1189,7 +1574,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case LRETURN: {
         auto& callee_frame = thread->getCurrentFrame();
-        Jlong ret          = callee_frame.getOperandStack().popLong();
+        Jlong ret          = callee_frame.getOperandStack().popLong<kChecked>();
+        memoizeResult(callee_frame, {.l = ret});
         thread->popFrame();
         if (!thread->isStackEmpty()) {
           auto& caller_frame = thread->getCurrentFrame();
@@ -1200,7 +1586,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case FRETURN: {
         auto&  callee_frame = thread->getCurrentFrame();
-        Jfloat ret          = callee_frame.getOperandStack().popFloat();
+        Jfloat ret          = callee_frame.getOperandStack().popFloat<kChecked>();
+        memoizeResult(callee_frame, {.f = ret});
         thread->popFrame();
         if (!thread->isStackEmpty()) {
           auto& caller_frame = thread->getCurrentFrame();
@@ -1211,7 +1598,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case DRETURN: {
         auto&   callee_frame = thread->getCurrentFrame();
-        Jdouble ret          = callee_frame.getOperandStack().popDouble();
+        Jdouble ret          = callee_frame.getOperandStack().popDouble<kChecked>();
+        memoizeResult(callee_frame, {.d = ret});
         thread->popFrame();
         if (!thread->isStackEmpty()) {
           auto& caller_frame = thread->getCurrentFrame();
@@ -1222,7 +1610,7 @@ void Interpreter::interpret(runtime::Thread* thread) {
       } break;
       case ARETURN: {
         auto& callee_frame = thread->getCurrentFrame();
-        Jref  ret          = callee_frame.getOperandStack().popRef();
+        Jref  ret          = callee_frame.getOperandStack().popRef<kChecked>();
         thread->popFrame();
         if (!thread->isStackEmpty()) {
           auto& caller_frame = thread->getCurrentFrame();
@@ -1232,6 +1620,9 @@ void Interpreter::interpret(runtime::Thread* thread) {
         }
       } break;
       case RETURN: {
+        if (auto* klass = frame.getInitializingKlass()) {
+          klass->finishInitialization(true);
+        }
         thread->popFrame();
         if (!thread->isStackEmpty()) {
           pc = thread->getCurrentFrame().getCallerPC();
@@ -1246,17 +1637,40 @@ void Interpreter::interpret(runtime::Thread* thread) {
 
       // Function: Access static and instance fields
       // Components: rt_cp, op_stack, thread (PC)
-      case GETSTATIC: {
+      // The plain forms check that the field's class is initialized, and become quick forms
+      // without the check once it is
+      case GETSTATIC:
+      case GETSTATIC_QUICK: {
         auto  index = reader.readU2();
         auto* field = rt_cp.resolveField(index);
-        auto  slot  = field->getOwnerKlass()->getStaticSlot(field->getSlotIndex());
-        op_stack.pushSlot(slot);
+        auto* owner = field->getOwnerKlass();
+        if (opcode == GETSTATIC) {
+          if (!ensureInitialized<Policy>(thread, owner, pc - 3, pc)) {
+            break;
+          }
+          quicken<Policy>(method, pc - 3, GETSTATIC_QUICK, owner);
+        } else {
+          acquireQuickened();
+        }
+        op_stack.pushSlot(owner->getStaticSlot(field->getSlotIndex()));
       } break;
-      case PUTSTATIC: {
+      case PUTSTATIC:
+      case PUTSTATIC_QUICK: {
         auto  index = reader.readU2();
         auto* field = rt_cp.resolveField(index);
+        auto* owner = field->getOwnerKlass();
+        if (opcode == PUTSTATIC) {
+          if (!ensureInitialized<Policy>(thread, owner, pc - 3, pc)) {
+            break;
+          }
+          quicken<Policy>(method, pc - 3, PUTSTATIC_QUICK, owner);
+        } else {
+          acquireQuickened();
+        }
         // compatibility checking is needed here, but not implemented yet
-        field->getOwnerKlass()->getStaticSlot(field->getSlotIndex()) = op_stack.popSlot();
+        auto value = op_stack.popSlot<kChecked>();
+        pinIfThrowable(field, value);
+        owner->getStaticSlot(field->getSlotIndex()) = value;
       } break;
       case GETFIELD:
         // TODO: implement getfield, Object module are needed
@@ -1276,7 +1690,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
       case INVOKESPECIAL:
         // TODO: implement invokespecial
         break;
-      case INVOKESTATIC: {
+      case INVOKESTATIC:
+      case INVOKESTATIC_QUICK: {
         // calling static method
         auto index = reader.readU2();
 
@@ -1286,7 +1701,24 @@ void Interpreter::interpret(runtime::Thread* thread) {
           throw std::runtime_error("Cannot invoke non-static method as static");
         }
 
-        U2 arg_slot_count = calculateArgSlotCount(method->getDescriptor());
+        if (opcode == INVOKESTATIC) {
+          auto* owner = method->getOwnerKlass();
+          if (!ensureInitialized<Policy>(thread, owner, pc - 3, pc)) {
+            break;
+          }
+          quicken<Policy>(frame.getMethod(), pc - 3, INVOKESTATIC_QUICK, owner);
+        } else {
+          acquireQuickened();
+        }
+
+        U2 arg_slot_count = method->getArgSlotCount();
+
+        if constexpr (Policy::kInlineTrivialMethods) {
+          if (canInlineTrivial(method)) {
+            invokeTrivial<Policy>(method, op_stack);
+            break;
+          }
+        }
 
         runtime::Frame next_frame(method);
 
@@ -1296,14 +1728,34 @@ void Interpreter::interpret(runtime::Thread* thread) {
         if (arg_slot_count > 0) {
           // must use int instead of U2, because the loop may decrement to negative numbers
           for (int i = arg_slot_count - 1; i >= 0; i--) {
-            runtime::Slot val = current_op_stack.popSlot();
-            next_local_vars.setSlot(i, val);
+            runtime::Slot val = current_op_stack.popSlot<kChecked>();
+            next_local_vars.setSlot<kChecked>(i, val);
+          }
+        }
+
+        if (memoize) {
+          if (auto* cache = runtime::getMemoCache(method)) {
+            auto key = cache->makeKey(next_local_vars);
+            if (auto result = cache->lookup(key)) {
+              op_stack.pushSlot(*result);
+              if (cache->returnsWide()) {
+                op_stack.pushSlot({.l = 0});  // placeholder on top, as pushLong/pushDouble do
+              }
+              break;
+            }
+            next_frame.setMemoKey(cache, key);
           }
         }
 
         thread->getCurrentFrame().setCallerPC(pc);
 
-        thread->pushFrame(std::move(next_frame));
+        if (!thread->pushFrame(std::move(next_frame))) {
+          // thrown by the invoke instruction (opcode + 2-byte index)
+          throwException(thread, runtime::WellKnownClass::kStackOverflowError, "", pc - 3, pc);
+          break;
+        }
+
+        onMethodEntry<Policy>(method);
 
         // reset pc to 0 for the next frame
         pc = 0;
@@ -1330,21 +1782,44 @@ void Interpreter::interpret(runtime::Thread* thread) {
         // Jref            obj_ref = heap_.newInstance(klass);
         // op_stack.pushRef(obj_ref);
       } break;
-      case CHECKCAST:
-        // TODO: implement checkcast
-        break;
-      case INSTANCEOF:
-        // TODO: implement instanceof
-        break;
+      case CHECKCAST: {
+        auto  index = reader.readU2();
+        auto* ref   = static_cast<runtime::Object*>(op_stack.popRef<kChecked>());
+        op_stack.pushRef(ref);
+        if (ref == nullptr) {
+          break;  // null can be cast to any reference type
+        }
+        auto* klass = rt_cp.resolveClass(index);
+        if (!ref->getKlass()->isSubtypeOf(klass)) {
+          throwException(thread, runtime::WellKnownClass::kClassCastException,
+                         "class " + binaryName(ref->getKlass()) + " cannot be cast to class " +
+                           binaryName(klass),
+                         pc - 3, pc);
+        }
+      } break;
+      case INSTANCEOF: {
+        auto  index = reader.readU2();
+        auto* ref   = static_cast<runtime::Object*>(op_stack.popRef<kChecked>());
+        // null is an instance of nothing, and its class is not resolved
+        bool is_instance =
+          ref != nullptr && ref->getKlass()->isSubtypeOf(rt_cp.resolveClass(index));
+        op_stack.pushInt(is_instance ? 1 : 0);
+      } break;
       /* #endregion Objects */
 
       /* #region Exceptions */
 
       // Function: Exception handling
-      // Components: op_stack
-      case ATHROW:
-        // TODO: implement athrow
-        break;
+      // Components: op_stack, thread (pending exception)
+      case ATHROW: {
+        auto* ref = static_cast<runtime::Object*>(op_stack.popRef<kChecked>());
+        if (!runtime::implicitNullCheck(ref)) {
+          throwException(thread, runtime::WellKnownClass::kNullPointerException, "", pc - 1, pc);
+          break;
+        }
+        thread->setPendingException(static_cast<runtime::Throwable*>(ref));
+        dispatchException(thread, pc - 1, pc);
+      } break;
       /* #endregion Exceptions */
 
       /* #region Monitors */
@@ -1389,4 +1864,8 @@ void Interpreter::interpret(runtime::Thread* thread) {
   }
 }
 
-}  // namespace jvm::engine
\ No newline at end of file
+template class Interpreter<Checked>;
+template class Interpreter<Profiled>;
+template class Interpreter<Fast>;
+
+}  // namespace jvm::engine
@@ -1,14 +1,36 @@
 #pragma once
 
+#include <cstddef>
+
+#include "common/types.h"
+#include "interpreter_policy.h"
+
 namespace jvm::runtime {
+class Method;
 class Thread;
 }  // namespace jvm::runtime
 
 namespace jvm::engine {
 
+// The bytecode interpreter, specialized at compile time by a policy from interpreter_policy.h.
+// Interpreter<Checked>, Interpreter<Profiled> and Interpreter<Fast> are instantiated in
+// interpreter.cpp; any method can run on any of them.
+template <typename Policy = Checked>
 class Interpreter {
  public:
+  // Called before each instruction when Policy::kTracing is set
+  using TraceHook = void (*)(const runtime::Method& method, size_t pc, U1 opcode);
+
+  void setTraceHook(TraceHook hook) { trace_hook_ = hook; }
+
   void interpret(runtime::Thread* thread);
+
+ private:
+  TraceHook trace_hook_{nullptr};
 };
 
-}  // namespace jvm::engine
\ No newline at end of file
+extern template class Interpreter<Checked>;
+extern template class Interpreter<Profiled>;
+extern template class Interpreter<Fast>;
+
+}  // namespace jvm::engine
@@ -0,0 +1,46 @@
+#pragma once
+
+namespace jvm::engine {
+
+// Interpreter policies. Each one is a set of compile-time switches that Interpreter<Policy>
+// tests with `if constexpr`, so a disabled feature costs nothing in the generated loop:
+//   kBoundsChecks         - local variable index and operand stack underflow checks
+//   kTracing              - call the installed trace hook before every instruction
+//   kProfiling            - count method invocations and loop back-edges on runtime::Method
+//   kSafepointPolls       - poll runtime::Safepoint at method entry and on back-edges
+//   kInlineTrivialMethods - run calls to runtime::TrivialMethod shapes in place, without a frame
+//   kQuickening           - rewrite instructions past their class initialization barrier to
+//                           quick forms (engine/opcode.h) that skip it
+
+// Development and debugging: every check on, plus tracing. Every call gets a real frame and
+// code is never rewritten, so traces and stack depths match the bytecode exactly.
+struct Checked {
+  static constexpr bool kBoundsChecks         = true;
+  static constexpr bool kTracing              = true;
+  static constexpr bool kProfiling            = false;
+  static constexpr bool kSafepointPolls       = true;
+  static constexpr bool kInlineTrivialMethods = false;
+  static constexpr bool kQuickening           = false;
+};
+
+// Collects invocation and back-edge counts for picking hot methods
+struct Profiled {
+  static constexpr bool kBoundsChecks         = false;
+  static constexpr bool kTracing              = false;
+  static constexpr bool kProfiling            = true;
+  static constexpr bool kSafepointPolls       = true;
+  static constexpr bool kInlineTrivialMethods = true;
+  static constexpr bool kQuickening           = true;
+};
+
+// Verified code only: no checks, no hooks, no counters, no polls
+struct Fast {
+  static constexpr bool kBoundsChecks         = false;
+  static constexpr bool kTracing              = false;
+  static constexpr bool kProfiling            = false;
+  static constexpr bool kSafepointPolls       = false;
+  static constexpr bool kInlineTrivialMethods = true;
+  static constexpr bool kQuickening           = true;
+};
+
+}  // namespace jvm::engine
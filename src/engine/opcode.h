@@ -275,4 +275,25 @@ constexpr U1 BREAKPOINT = 0xCA;
 constexpr U1 IMPDEP1    = 0xFE;
 constexpr U1 IMPDEP2    = 0xFF;
 
+// --- Quick ---
+// Never in a class file: the interpreter rewrites an instruction to its quick form once the
+// class it initializes is initialized, and the quick form runs without the barrier
+constexpr U1 GETSTATIC_QUICK    = 0xCB;
+constexpr U1 PUTSTATIC_QUICK    = 0xCC;
+constexpr U1 INVOKESTATIC_QUICK = 0xCD;
+
+// The standard instruction `opcode` stands for
+constexpr U1 unquickened(U1 opcode) {
+  switch (opcode) {
+    case GETSTATIC_QUICK:
+      return GETSTATIC;
+    case PUTSTATIC_QUICK:
+      return PUTSTATIC;
+    case INVOKESTATIC_QUICK:
+      return INVOKESTATIC;
+    default:
+      return opcode;
+  }
+}
+
 }  // namespace jvm::engine
\ No newline at end of file
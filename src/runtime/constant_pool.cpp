@@ -1,89 +1,215 @@
 #include "constant_pool.h"
 
-#include <iostream>
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <stdexcept>
+#include <string>
 
 #include "class_loader/class_file.h"
 #include "class_loader/class_loader.h"
 #include "klass.h"
+#include "metaspace.h"
+#include "symbol.h"
 namespace jvm::runtime {
 
-Klass* RuntimeConstantPool::resolveClass(U2 index) {
-  auto& slot = infos_[index];
+namespace {
+
+// Symbolic references keep the low bit set, which no resolved pointer has
+U8 symbolicMemberRef(class_loader::MemberRef ref) {
+  return (static_cast<U8>(ref.class_index) << 17) |
+         (static_cast<U8>(ref.name_and_type_index) << 1) | 1;
+}
+U2 classIndexOf(U8 payload) { return static_cast<U2>(payload >> 17); }
+U2 nameAndTypeIndexOf(U8 payload) { return static_cast<U2>(payload >> 1); }
+
+}  // namespace
+
+void RuntimeConstantPool::allocate(size_t count, Metaspace& metaspace) {
+  // value-initialized: every tag starts as kUnmaterialized
+  tags_     = metaspace.allocate<std::atomic<CpTag>>(count);
+  payloads_ = metaspace.allocate<std::atomic<U8>>(count);
+  std::uninitialized_value_construct_n(tags_, count);
+  std::uninitialized_value_construct_n(payloads_, count);
+  size_ = count;
+}
 
-  if (auto* klass = std::get_if<Klass*>(&slot)) {
-    return *klass;
+CpTag RuntimeConstantPool::getTag(U2 index) {
+  if (index >= size_) {
+    throw std::runtime_error("Invalid constant pool index: " + std::to_string(index));
+  }
+  auto tag = tags_[index].load(std::memory_order_acquire);
+  if (tag == CpTag::kUnmaterialized) [[unlikely]] {
+    materialize(index);
+    tag = tags_[index].load(std::memory_order_acquire);
   }
+  return tag;
+}
 
-  auto* sym_ref = std::get_if<SymRef_Class>(&slot);
-  if (sym_ref == nullptr) {
+U8 RuntimeConstantPool::getPayload(U2 index, CpTag expected) {
+  if (getTag(index) != expected) {
     throw std::runtime_error("Invalid symbol reference");
   }
+  return payloads_[index].load(std::memory_order_acquire);
+}
+
+void RuntimeConstantPool::materialize(U2 index) {
+  std::lock_guard lock(materialize_mutex_);
+  if (tags_[index].load(std::memory_order_relaxed) != CpTag::kUnmaterialized) {
+    return;  // another thread got here first
+  }
+
+  const auto& cf_cp   = owner_klass_->getClassFile()->constant_pool;
+  CpTag       tag     = CpTag::kEmpty;
+  U8          payload = 0;
+  // index 0 and the second slot of a long or double have no entry
+  switch (index == 0 ? class_loader::ConstantTag::kEmpty : cf_cp.getTag(index)) {
+    case class_loader::ConstantTag::kInteger:
+      tag     = CpTag::kInteger;
+      payload = std::bit_cast<U4>(cf_cp.getInteger(index));
+      break;
+    case class_loader::ConstantTag::kFloat:
+      tag     = CpTag::kFloat;
+      payload = std::bit_cast<U4>(cf_cp.getFloat(index));
+      break;
+    case class_loader::ConstantTag::kLong:
+      tag     = CpTag::kLong;
+      payload = std::bit_cast<U8>(cf_cp.getLong(index));
+      break;
+    case class_loader::ConstantTag::kDouble:
+      tag     = CpTag::kDouble;
+      payload = std::bit_cast<U8>(cf_cp.getDouble(index));
+      break;
+
+    case class_loader::ConstantTag::kString: {
+      // TODO: string objects; for now a string constant is its symbol, and the references
+      // pushed to it may outlive the class, so it is kept for good
+      const auto* symbol = cf_cp.getUtf8Symbol(cf_cp.getStringIndex(index));
+      SymbolTable::retain(symbol);
+      tag     = CpTag::kString;
+      payload = std::bit_cast<U8>(symbol);
+    } break;
+
+    case class_loader::ConstantTag::kClass:
+      tag     = CpTag::kClass;
+      payload = std::bit_cast<U8>(cf_cp.getUtf8Symbol(cf_cp.getClassNameIndex(index))) | 1;
+      break;
+    case class_loader::ConstantTag::kFieldref:
+      tag     = CpTag::kFieldref;
+      payload = symbolicMemberRef(cf_cp.getMemberRef(index));
+      break;
+    case class_loader::ConstantTag::kMethodref:
+      tag     = CpTag::kMethodref;
+      payload = symbolicMemberRef(cf_cp.getMemberRef(index));
+      break;
+    case class_loader::ConstantTag::kInterfaceMethodref:
+      tag     = CpTag::kInterfaceMethodref;
+      payload = symbolicMemberRef(cf_cp.getMemberRef(index));
+      break;
+
+    // TODO: dynamic language support
+    case class_loader::ConstantTag::kMethodHandle:
+    case class_loader::ConstantTag::kMethodType:
+    case class_loader::ConstantTag::kInvokeDynamic:
+    // only referenced by other entries
+    case class_loader::ConstantTag::kNameAndType:
+    case class_loader::ConstantTag::kUtf8:
+    case class_loader::ConstantTag::kEmpty:
+      break;
+    default:
+      throw std::runtime_error("Unknown constant pool tag: " +
+                               std::to_string(static_cast<int>(cf_cp.getTag(index))));
+  }
+
+  payloads_[index].store(payload, std::memory_order_relaxed);
+  tags_[index].store(tag, std::memory_order_release);
+}
+
+Jint RuntimeConstantPool::getInt(U2 index) {
+  return std::bit_cast<Jint>(static_cast<U4>(getPayload(index, CpTag::kInteger)));
+}
+
+Jfloat RuntimeConstantPool::getFloat(U2 index) {
+  return std::bit_cast<Jfloat>(static_cast<U4>(getPayload(index, CpTag::kFloat)));
+}
+
+Jlong RuntimeConstantPool::getLong(U2 index) {
+  return std::bit_cast<Jlong>(getPayload(index, CpTag::kLong));
+}
+
+Jdouble RuntimeConstantPool::getDouble(U2 index) {
+  return std::bit_cast<Jdouble>(getPayload(index, CpTag::kDouble));
+}
+
+const Symbol* RuntimeConstantPool::getString(U2 index) {
+  return std::bit_cast<const Symbol*>(getPayload(index, CpTag::kString));
+}
+
+bool RuntimeConstantPool::isResolved(U2 index) {
+  auto tag = getTag(index);
+  if (tag != CpTag::kClass && tag != CpTag::kFieldref && tag != CpTag::kMethodref &&
+      tag != CpTag::kInterfaceMethodref) {
+    return false;
+  }
+  return !isSymbolic(payloads_[index].load(std::memory_order_acquire));
+}
 
-  const auto& class_cp   = owner_klass_->getClassFile()->constant_pool;
-  auto        class_name = class_cp.getUtf8String(sym_ref->name_index);
+Klass* RuntimeConstantPool::resolveClass(U2 index) {
+  auto payload = getPayload(index, CpTag::kClass);
+  if (!isSymbolic(payload)) {
+    return std::bit_cast<Klass*>(payload);
+  }
+
+  const auto* name       = std::bit_cast<const Symbol*>(payload & ~U8{1});
+  auto        class_name = name->str();
   // replace '/' with '.'
   std::replace(class_name.begin(), class_name.end(), '/', '.');
   auto* resolved_klass = owner_klass_->getClassLoader()->loadClass(class_name);
-  slot                 = resolved_klass;
+  payloads_[index].store(std::bit_cast<U8>(resolved_klass), std::memory_order_release);
   return resolved_klass;
 }
 
 Field* RuntimeConstantPool::resolveField(U2 index) {
-  auto& slot = infos_[index];
-
-  if (auto* field = std::get_if<Field*>(&slot)) {
+  auto payload = getPayload(index, CpTag::kFieldref);
+  if (!isSymbolic(payload)) {
     // if is already resolved, return
-    return *field;
+    return std::bit_cast<Field*>(payload);
   }
 
-  // otherwise, resolve it
-  auto* sym_ref = std::get_if<SymRef_Field>(&slot);
-  if (sym_ref == nullptr) {
-    throw std::runtime_error("Invalid symbol reference");
-  }
+  Klass* target_klass = this->resolveClass(classIndexOf(payload));
 
-  Klass* target_klass = this->resolveClass(sym_ref->class_index);
-
-  auto [name, descriptor] = this->resolveNameAndType(sym_ref->name_and_type_index);
+  auto [name, descriptor] = this->resolveNameAndType(nameAndTypeIndexOf(payload));
 
   Field* resolved_field = target_klass->findField(name, descriptor);
-  slot                  = resolved_field;
+  if (resolved_field != nullptr) {
+    payloads_[index].store(std::bit_cast<U8>(resolved_field), std::memory_order_release);
+  }
   return resolved_field;
 }
 
 Method* RuntimeConstantPool::resolveMethod(U2 index) {
-  auto& slot = infos_[index];
-
-  if (auto* method = std::get_if<Method*>(&slot)) {
-    return *method;
-  }
-
-  auto* sym_ref = std::get_if<SymRef_Method>(&slot);
-  if (sym_ref == nullptr) {
-    throw std::runtime_error("Invalid symbol reference");
+  auto tag     = getTag(index);
+  auto payload = getPayload(index, tag == CpTag::kInterfaceMethodref ? tag : CpTag::kMethodref);
+  if (!isSymbolic(payload)) {
+    return std::bit_cast<Method*>(payload);
   }
 
-  Klass* target_klass = this->resolveClass(sym_ref->class_index);
+  Klass* target_klass = this->resolveClass(classIndexOf(payload));
 
-  auto [name, descriptor] = this->resolveNameAndType(sym_ref->name_and_type_index);
+  auto [name, descriptor] = this->resolveNameAndType(nameAndTypeIndexOf(payload));
 
   Method* resolved_method = target_klass->findMethod(name, descriptor);
-  slot                    = resolved_method;
+  if (resolved_method != nullptr) {
+    payloads_[index].store(std::bit_cast<U8>(resolved_method), std::memory_order_release);
+  }
   return resolved_method;
 }
 
-std::pair<std::string, std::string> RuntimeConstantPool::resolveNameAndType(U2 index) {
-  const auto& cf_cp = owner_klass_->getClassFile()->constant_pool;
-  const auto* nt_info =
-    dynamic_cast<const class_loader::NameAndTypeInfo*>(cf_cp.getConstantInfo(index));
-  if (nt_info == nullptr) {
-    throw std::runtime_error("Invalid name and type info");
-  }
-
-  std::string name       = cf_cp.getUtf8String(nt_info->name_index);
-  std::string descriptor = cf_cp.getUtf8String(nt_info->descriptor_index);
-
-  return std::make_pair(name, descriptor);
+std::pair<const Symbol*, const Symbol*> RuntimeConstantPool::resolveNameAndType(U2 index) {
+  const auto& cf_cp   = owner_klass_->getClassFile()->constant_pool;
+  auto        nt_info = cf_cp.getNameAndTypeRef(index);
+  return std::make_pair(cf_cp.getUtf8Symbol(nt_info.name_index),
+                        cf_cp.getUtf8Symbol(nt_info.descriptor_index));
 }
 
-}  // namespace jvm::runtime
\ No newline at end of file
+}  // namespace jvm::runtime
@@ -1,58 +1,92 @@
 #pragma once
 
-#include <string>
-#include <vector>
+#include <atomic>
+#include <mutex>
+#include <utility>
 
 #include "common/types.h"
 
 namespace jvm::runtime {
 
 class Klass;
+class Metaspace;
 class Method;
 class Field;
+class Symbol;
 
-// 4 types of symbol references, not resolved yet
-struct SymRef_Class {
-  U2 name_index;
-};
-struct SymRef_Field {
-  U2 class_index;
-  U2 name_and_type_index;
-};
-struct SymRef_Method {
-  U2 class_index;
-  U2 name_and_type_index;
-};
-struct SymRef_InterfaceMethod {
-  U2 class_index;
-  U2 name_and_type_index;
+// Kind of a runtime constant pool entry
+enum class CpTag : U1 {
+  kUnmaterialized,  // not looked at yet
+  kEmpty,  // index 0, second slot of a long or double, or a kind with no runtime value
+  kInteger,
+  kFloat,
+  kLong,
+  kDouble,
+  kString,  // payload: the string's Symbol
+  // payload: a symbolic reference (low bit set) until resolved, then the Klass*, Field* or
+  // Method* it resolved to
+  kClass,
+  kFieldref,
+  kMethodref,
+  kInterfaceMethodref,
 };
 
-using RtCpInfo = std::variant<std::monostate,                // empty
-                              Jint, Jfloat, Jlong, Jdouble,  // literal
-                              std::string,              // string literal, optimize: string intern
-                              Klass*, Method*, Field*,  // resolved
-                              SymRef_Class, SymRef_Field, SymRef_Method,
-                              SymRef_InterfaceMethod  // symbol references, not resolved yet
-                              >;
-
+// The per-class constant pool the interpreter uses: one tag byte and one 8-byte payload per
+// class file constant pool index. Nothing is converted at link time; an entry is materialized
+// from the class file on first use, and symbolic references are replaced by what they resolve
+// to. Both steps publish with release stores, so threads may read and resolve entries
+// concurrently: racing resolutions of one entry store the same value.
 class RuntimeConstantPool {
  public:
   explicit RuntimeConstantPool(Klass* owner_klass) : owner_klass_(owner_klass) {}
+  RuntimeConstantPool(const RuntimeConstantPool&)            = delete;
+  RuntimeConstantPool(RuntimeConstantPool&&)                 = delete;
+  RuntimeConstantPool& operator=(const RuntimeConstantPool&) = delete;
+  RuntimeConstantPool& operator=(RuntimeConstantPool&&)      = delete;
+  ~RuntimeConstantPool()                                     = default;
+
+  /**
+   * @brief Sizes the pool to match the class file's, with every entry unmaterialized; the
+   * entries live in `metaspace` and are never freed on their own
+   */
+  void allocate(size_t count, Metaspace& metaspace);
 
-  void     setConstant(U2 index, RtCpInfo info) { infos_[index] = std::move(info); }
-  RtCpInfo getConstant(U2 index) { return infos_[index]; }
+  size_t size() const { return size_; }
 
-  Klass*                              resolveClass(U2 index);
-  Field*                              resolveField(U2 index);
-  Method*                             resolveMethod(U2 index);
-  std::pair<std::string, std::string> resolveNameAndType(U2 index);
+  // Kind of the entry at `index`, materializing it if needed
+  CpTag getTag(U2 index);
+
+  // Literal values; each throws if the entry is of another kind
+  Jint          getInt(U2 index);
+  Jfloat        getFloat(U2 index);
+  Jlong         getLong(U2 index);
+  Jdouble       getDouble(U2 index);
+  const Symbol* getString(U2 index);
+
+  // Whether a class, field or method reference has been resolved already
+  bool isResolved(U2 index);
+
+  Klass*                                  resolveClass(U2 index);
+  Field*                                  resolveField(U2 index);
+  Method*                                 resolveMethod(U2 index);
+  std::pair<const Symbol*, const Symbol*> resolveNameAndType(U2 index);
 
  private:
-  std::vector<RtCpInfo> infos_;
-  Klass*                owner_klass_;
+  Klass* owner_klass_;
+  size_t size_{0};
+
+  std::atomic<CpTag>* tags_{nullptr};
+  std::atomic<U8>*    payloads_{nullptr};
+  std::mutex          materialize_mutex_;
+
+  /**
+   * @brief Materializes the entry if needed and returns its payload
+   * @throws std::runtime_error if the entry is not of kind `expected`
+   */
+  U8   getPayload(U2 index, CpTag expected);
+  void materialize(U2 index);
 
-  friend class Klass;
+  static bool isSymbolic(U8 payload) { return (payload & 1) != 0; }
 };
 
-}  // namespace jvm::runtime
\ No newline at end of file
+}  // namespace jvm::runtime
@@ -0,0 +1,62 @@
+#include "exception_table.h"
+
+#include <algorithm>
+
+namespace jvm::runtime {
+
+ExceptionHandlerTable::ExceptionHandlerTable(std::span<const ExceptionHandler> handlers)
+  : handlers_(handlers.begin(), handlers.end()) {
+  // collect every range boundary, then walk the elementary intervals between them
+  std::vector<U2> boundaries;
+  boundaries.reserve(handlers.size() * 2);
+  for (const auto& handler : handlers) {
+    boundaries.push_back(handler.start_pc);
+    boundaries.push_back(handler.end_pc);
+  }
+  std::ranges::sort(boundaries);
+  auto [first, last] = std::ranges::unique(boundaries);
+  boundaries.erase(first, last);
+
+  for (size_t i = 0; i + 1 < boundaries.size(); i++) {
+    U2 start = boundaries[i];
+    U2 end   = boundaries[i + 1];
+
+    auto offset = static_cast<U4>(candidates_.size());
+    for (const auto& handler : handlers) {
+      if (handler.start_pc <= start && end <= handler.end_pc) {
+        candidates_.push_back(handler);
+      }
+    }
+    auto count = static_cast<U4>(candidates_.size()) - offset;
+    if (count == 0) {
+      continue;  // gap between two protected regions
+    }
+
+    // merge with the previous segment when it is adjacent and has the same candidates
+    if (!segments_.empty()) {
+      auto& prev = segments_.back();
+      if (prev.end_pc == start && prev.count == count &&
+          std::equal(candidates_.begin() + prev.first, candidates_.begin() + prev.first + count,
+                     candidates_.begin() + offset, [](const auto& lhs, const auto& rhs) {
+                       return lhs.handler_pc == rhs.handler_pc &&
+                              lhs.catch_type == rhs.catch_type;
+                     })) {
+        prev.end_pc = end;
+        candidates_.resize(offset);
+        continue;
+      }
+    }
+    segments_.push_back({.start_pc = start, .end_pc = end, .first = offset, .count = count});
+  }
+}
+
+std::span<const ExceptionHandler> ExceptionHandlerTable::findCandidates(size_t pc) const {
+  // first segment that ends after pc; segments are disjoint and sorted
+  auto it = std::ranges::upper_bound(segments_, pc, {}, &Segment::end_pc);
+  if (it == segments_.end() || pc < it->start_pc) {
+    return {};
+  }
+  return {candidates_.data() + it->first, it->count};
+}
+
+}  // namespace jvm::runtime
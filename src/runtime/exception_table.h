@@ -0,0 +1,57 @@
+#pragma once
+
+#include <span>
+#include <vector>
+
+#include "common/types.h"
+
+namespace jvm::runtime {
+
+// One row of a method's exception_table, in runtime form
+struct ExceptionHandler {
+  U2 start_pc;    // inclusive
+  U2 end_pc;      // exclusive
+  U2 handler_pc;
+  U2 catch_type;  // constant pool index of the caught class, 0 for `finally`/catch-all
+};
+
+/**
+ * @brief Per-method exception handler lookup table
+ *
+ * Built once when the method is prepared. The handler ranges of the class file are cut at
+ * every start/end boundary into disjoint pc segments, sorted by start pc; each segment
+ * lists the handlers covering it in their original class-file order, which is the order
+ * JVMS 2.10 requires them to be tried in. A throw then costs one binary search over the
+ * segments plus a scan of the (usually one or two) candidates, instead of a walk over
+ * the whole table.
+ */
+class ExceptionHandlerTable {
+ public:
+  ExceptionHandlerTable() = default;
+  explicit ExceptionHandlerTable(std::span<const ExceptionHandler> handlers);
+
+  bool empty() const { return segments_.empty(); }
+
+  // The handlers the table was built from, in class-file order
+  std::span<const ExceptionHandler> getHandlers() const { return handlers_; }
+
+  /**
+   * @brief Returns the handlers whose [start_pc, end_pc) range covers pc, in the order they
+   * must be tried. Empty if no handler covers pc.
+   */
+  std::span<const ExceptionHandler> findCandidates(size_t pc) const;
+
+ private:
+  struct Segment {
+    U2 start_pc;
+    U2 end_pc;
+    U4 first;  // index of the first candidate in candidates_
+    U4 count;
+  };
+
+  std::vector<Segment>          segments_;
+  std::vector<ExceptionHandler> candidates_;
+  std::vector<ExceptionHandler> handlers_;
+};
+
+}  // namespace jvm::runtime
@@ -1,32 +1,37 @@
 #pragma once
 
-#include <string>
+#include <string_view>
 
 #include "common/access_flags.hpp"
+#include "symbol.h"
 
 namespace jvm::runtime {
 class Klass;
 
 class Field {
  public:
-  bool               isStatic() const { return access_flags_.has(flags::Field::STATIC); }
-  const std::string& getName() const { return name_; }
-  const std::string& getDescriptor() const { return descriptor_; }
-  Klass*             getOwnerKlass() const { return owner_klass_; }
-  size_t             getSlotIndex() const { return slot_index_; }
+  AccessFlags<flags::Field> getAccessFlags() const { return access_flags_; }
+
+  bool             isStatic() const { return access_flags_.has(flags::Field::STATIC); }
+  std::string_view getName() const { return name_->view(); }
+  std::string_view getDescriptor() const { return descriptor_->view(); }
+  const Symbol*    getNameSymbol() const { return name_; }
+  const Symbol*    getDescriptorSymbol() const { return descriptor_; }
+  Klass*           getOwnerKlass() const { return owner_klass_; }
+  size_t           getSlotIndex() const { return slot_index_; }
 
  private:
   Field() = default;
-  Field(AccessFlags<flags::Field> access_flags, std::string name, std::string descriptor,
+  Field(AccessFlags<flags::Field> access_flags, const Symbol* name, const Symbol* descriptor,
         Klass* owner_klass)
     : access_flags_(access_flags),
-      name_(std::move(name)),
-      descriptor_(std::move(descriptor)),
+      name_(name),
+      descriptor_(descriptor),
       owner_klass_(owner_klass) {}
 
   AccessFlags<flags::Field> access_flags_;
-  std::string               name_;
-  std::string               descriptor_;
+  const Symbol*             name_{nullptr};
+  const Symbol*             descriptor_{nullptr};
 
   Klass* owner_klass_{nullptr};
   size_t slot_index_{};
@@ -22,12 +22,38 @@ class Frame {
   size_t getCallerPC() const { return caller_pc_; }
   void   setCallerPC(size_t pc) { caller_pc_ = pc; }
 
+  // Set on the frame of a memoizable call that missed the cache, so that its result is
+  // stored when it returns
+  MemoCache*            getMemoCache() const { return memo_cache_; }
+  const MemoCache::Key& getMemoKey() const { return memo_key_; }
+  void                  setMemoKey(MemoCache* cache, const MemoCache::Key& key) {
+    memo_cache_ = cache;
+    memo_key_   = key;
+  }
+
+  // Set on the frame of a <clinit>, so that its class is marked initialized when it returns,
+  // or erroneous when an exception unwinds it. The requested class is the one the triggering
+  // instruction uses: it and its superclasses below the initializing class wait for it, and
+  // fail with it (JVMS §5.5, step 7).
+  Klass* getInitializingKlass() const { return initializing_klass_; }
+  Klass* getRequestedKlass() const { return requested_klass_; }
+  void   setInitializingKlass(Klass* klass, Klass* requested) {
+    initializing_klass_ = klass;
+    requested_klass_    = requested;
+  }
+
  private:
   Method*        method_;  // points to method area
   LocalVariables local_variables_;
   OperandStack   operand_stack_;
 
   size_t caller_pc_{0};
+
+  MemoCache*     memo_cache_{nullptr};
+  MemoCache::Key memo_key_{};
+
+  Klass* initializing_klass_{nullptr};
+  Klass* requested_klass_{nullptr};
 };
 
 }  // namespace jvm::runtime
\ No newline at end of file
@@ -0,0 +1,110 @@
+#include "implicit_checks.h"
+
+#include <csignal>
+#include <cstdint>
+#include <mutex>
+
+#if JVM_IMPLICIT_CHECKS
+#include <ucontext.h>
+
+// Bounds of the check-site table; the linker defines them for any section whose name is a
+// valid C identifier. Weak so that a binary without check sites still links.
+// NOLINTBEGIN(bugprone-reserved-identifier, cert-dcl37-c, cert-dcl51-cpp)
+extern "C" {
+extern const jvm::runtime::ImplicitExceptionEntry __start_jvm_implicit_exceptions[]
+  __attribute__((weak));
+extern const jvm::runtime::ImplicitExceptionEntry __stop_jvm_implicit_exceptions[]
+  __attribute__((weak));
+}
+// NOLINTEND(bugprone-reserved-identifier, cert-dcl37-c, cert-dcl51-cpp)
+#endif
+
+namespace jvm::runtime {
+
+#if JVM_IMPLICIT_CHECKS
+namespace {
+
+// Implicit null checks only cover accesses that land in the unmapped zero page
+constexpr uintptr_t kNullPageSize = 4096;
+
+struct sigaction previous_sigfpe  = {};
+struct sigaction previous_sigsegv = {};
+
+// Hands a fault that is not ours to whoever handled the signal before us
+void forwardSignal(int signal, siginfo_t* info, void* context) {
+  const auto& previous = signal == SIGFPE ? previous_sigfpe : previous_sigsegv;
+  if ((previous.sa_flags & SA_SIGINFO) != 0) {
+    previous.sa_sigaction(signal, info, context);
+  } else if (previous.sa_handler == SIG_DFL || previous.sa_handler == SIG_IGN) {
+    // returning re-executes the faulting instruction, which now gets the default action. A
+    // synchronous fault cannot be ignored: returning under SIG_IGN would fault again forever
+    struct sigaction default_action = {};
+    default_action.sa_handler       = SIG_DFL;
+    sigemptyset(&default_action.sa_mask);
+    sigaction(signal, &default_action, nullptr);
+  } else {
+    previous.sa_handler(signal);
+  }
+}
+
+// Whether a fault at a check site is the one the site is testing for
+bool isExpectedFault(const ImplicitExceptionEntry& entry, int signal, const siginfo_t* info) {
+  switch (entry.kind) {
+    case ImplicitCheck::kDivideByZero:
+      return signal == SIGFPE;
+    case ImplicitCheck::kNullCheck:
+      return signal == SIGSEGV && reinterpret_cast<uintptr_t>(info->si_addr) < kNullPageSize;
+    case ImplicitCheck::kStackBang:
+      // the probed address always lies inside a Java thread stack mapping, so the only way
+      // it can fault is by hitting one of the guard zones
+      return signal == SIGSEGV;
+  }
+  return false;
+}
+
+void handleImplicitException(int signal, siginfo_t* info, void* context) {
+  auto* ucontext = static_cast<ucontext_t*>(context);
+  auto& pc       = ucontext->uc_mcontext.gregs[REG_RIP];
+  if (const auto* entry = findImplicitException(static_cast<U8>(pc));
+      entry != nullptr && isExpectedFault(*entry, signal, info)) {
+    pc = static_cast<greg_t>(entry->continuation_pc);
+    return;
+  }
+  forwardSignal(signal, info, context);
+}
+
+}  // namespace
+#endif
+
+void installImplicitCheckHandlers() {
+#if JVM_IMPLICIT_CHECKS
+  static std::once_flag installed;
+  std::call_once(installed, [] {
+    struct sigaction action = {};
+    action.sa_sigaction     = handleImplicitException;
+    action.sa_flags         = SA_SIGINFO | SA_ONSTACK;
+    sigemptyset(&action.sa_mask);
+    sigaction(SIGFPE, &action, &previous_sigfpe);
+    sigaction(SIGSEGV, &action, &previous_sigsegv);
+  });
+#endif
+}
+
+const ImplicitExceptionEntry* findImplicitException(U8 pc) {
+#if JVM_IMPLICIT_CHECKS
+  if (__start_jvm_implicit_exceptions == nullptr) {
+    return nullptr;
+  }
+  for (const auto* entry = __start_jvm_implicit_exceptions;
+       entry != __stop_jvm_implicit_exceptions; ++entry) {
+    if (entry->trap_pc == pc) {
+      return entry;
+    }
+  }
+#else
+  (void)pc;
+#endif
+  return nullptr;
+}
+
+}  // namespace jvm::runtime
@@ -0,0 +1,183 @@
+/**
+ * @file implicit_checks.h
+ * @brief Null, divide-by-zero and stack overflow checks left to the hardware
+ *
+ * On Linux/x86-64 the VM does not test divisors, references or stack depth before using them.
+ * The trapping instruction of each check site is recorded, together with a continuation
+ * address, in the `jvm_implicit_exceptions` section. When the instruction faults, the
+ * SIGFPE/SIGSEGV handler finds the faulting pc in that table and resumes execution at the
+ * continuation, which reports the trap to the code that issued it; for bytecode handlers the
+ * interpreter then knows the executing Method and bytecode index and raises the Java
+ * exception. A fault anywhere else is a genuine crash and goes to the previous handler.
+ *
+ * Elsewhere the same functions fall back to explicit checks.
+ */
+#pragma once
+
+#include <limits>
+
+#include "common/types.h"
+
+#if defined(__linux__) && defined(__x86_64__) && defined(__GNUC__)
+#define JVM_IMPLICIT_CHECKS 1
+#else
+#define JVM_IMPLICIT_CHECKS 0
+#endif
+
+namespace jvm::runtime {
+
+// What a check site tests, which determines the faults it accepts
+enum class ImplicitCheck : U8 {
+  kDivideByZero = 1,  // SIGFPE
+  kNullCheck    = 2,  // SIGSEGV in the zero page
+  kStackBang    = 3,  // SIGSEGV in a guard zone of a Java thread stack
+};
+
+// One row of the `jvm_implicit_exceptions` section, emitted by the check sites below
+struct ImplicitExceptionEntry {
+  U8            trap_pc;          // address of the instruction that may fault
+  U8            continuation_pc;  // where the signal handler resumes execution
+  ImplicitCheck kind;
+};
+
+/**
+ * @brief Installs the SIGFPE/SIGSEGV handlers once per process. Handlers installed before
+ * are kept and still receive the faults that do not belong to a check site.
+ */
+void installImplicitCheckHandlers();
+
+/**
+ * @brief Finds the check site a faulting pc belongs to
+ * @return The table entry, or nullptr if the pc is not a check site
+ */
+const ImplicitExceptionEntry* findImplicitException(U8 pc);
+
+// NOLINTBEGIN(hicpp-no-assembler)
+
+/**
+ * @brief Divides with the divisor checked by the hardware
+ * @return false if the division trapped: the divisor is zero, or the quotient overflows
+ * (MIN_VALUE / -1). quotient and remainder are unspecified in that case.
+ */
+static inline bool trappingDivide(Jint dividend, Jint divisor, Jint& quotient, Jint& remainder) {
+#if JVM_IMPLICIT_CHECKS
+  bool trapped = false;
+  quotient     = dividend;
+  asm volatile(
+    "cltd\n"
+    "1: idivl %[divisor]\n"
+    "2:\n"
+    ".pushsection .text.unlikely,\"ax\",@progbits\n"
+    "3: movb $1, %[trapped]\n"
+    "   jmp 2b\n"
+    ".popsection\n"
+    ".pushsection jvm_implicit_exceptions,\"aw\",@progbits\n"
+    ".balign 8\n"
+    ".quad 1b, 3b, %c[kind]\n"
+    ".popsection\n"
+    : "+a"(quotient), "=&d"(remainder), [trapped] "+r"(trapped)
+    : [divisor] "r"(divisor), [kind] "i"(ImplicitCheck::kDivideByZero)
+    : "cc");
+  return !trapped;
+#else
+  if (divisor == 0 || (divisor == -1 && dividend == std::numeric_limits<Jint>::min())) {
+    return false;
+  }
+  quotient  = dividend / divisor;
+  remainder = dividend % divisor;
+  return true;
+#endif
+}
+
+static inline bool trappingDivide(Jlong dividend, Jlong divisor, Jlong& quotient,
+                                  Jlong& remainder) {
+#if JVM_IMPLICIT_CHECKS
+  bool trapped = false;
+  quotient     = dividend;
+  asm volatile(
+    "cqto\n"
+    "1: idivq %[divisor]\n"
+    "2:\n"
+    ".pushsection .text.unlikely,\"ax\",@progbits\n"
+    "3: movb $1, %[trapped]\n"
+    "   jmp 2b\n"
+    ".popsection\n"
+    ".pushsection jvm_implicit_exceptions,\"aw\",@progbits\n"
+    ".balign 8\n"
+    ".quad 1b, 3b, %c[kind]\n"
+    ".popsection\n"
+    : "+a"(quotient), "=&d"(remainder), [trapped] "+r"(trapped)
+    : [divisor] "r"(divisor), [kind] "i"(ImplicitCheck::kDivideByZero)
+    : "cc");
+  return !trapped;
+#else
+  if (divisor == 0 || (divisor == -1 && dividend == std::numeric_limits<Jlong>::min())) {
+    return false;
+  }
+  quotient  = dividend / divisor;
+  remainder = dividend % divisor;
+  return true;
+#endif
+}
+
+/**
+ * @brief Null check by touching the referenced object; a null reference faults in the
+ * unmapped zero page. Meant to be folded into the first access of GETFIELD/PUTFIELD and
+ * array instructions.
+ * @return false if ref is null
+ */
+static inline bool implicitNullCheck(const void* ref) {
+#if JVM_IMPLICIT_CHECKS
+  bool trapped = false;
+  asm volatile(
+    "1: testb $0, (%[ref])\n"
+    "2:\n"
+    ".pushsection .text.unlikely,\"ax\",@progbits\n"
+    "3: movb $1, %[trapped]\n"
+    "   jmp 2b\n"
+    ".popsection\n"
+    ".pushsection jvm_implicit_exceptions,\"aw\",@progbits\n"
+    ".balign 8\n"
+    ".quad 1b, 3b, %c[kind]\n"
+    ".popsection\n"
+    : [trapped] "+r"(trapped)
+    : [ref] "r"(ref), [kind] "i"(ImplicitCheck::kNullCheck)
+    : "cc", "memory");
+  return !trapped;
+#else
+  return ref != nullptr;
+#endif
+}
+
+/**
+ * @brief Touches `address` with a store; an address in a stack guard zone faults instead of
+ * being silently written
+ * @return false if the address is in a guard zone
+ */
+static inline bool stackBang(void* address) {
+#if JVM_IMPLICIT_CHECKS
+  bool trapped = false;
+  asm volatile(
+    "1: movb $0, (%[address])\n"
+    "2:\n"
+    ".pushsection .text.unlikely,\"ax\",@progbits\n"
+    "3: movb $1, %[trapped]\n"
+    "   jmp 2b\n"
+    ".popsection\n"
+    ".pushsection jvm_implicit_exceptions,\"aw\",@progbits\n"
+    ".balign 8\n"
+    ".quad 1b, 3b, %c[kind]\n"
+    ".popsection\n"
+    : [trapped] "+r"(trapped)
+    : [address] "r"(address), [kind] "i"(ImplicitCheck::kStackBang)
+    : "memory");
+  return !trapped;
+#else
+  (void)address;
+  return true;
+#endif
+}
+
+// NOLINTEND(hicpp-no-assembler)
+
+}  // namespace jvm::runtime
@@ -1,123 +1,232 @@
 #include "klass.h"
 
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+
 #include "class_loader/class_file.h"
+#include "class_loader/class_loader.h"
 #include "runtime/constant_pool.h"
+#include "runtime/metaspace.h"
+#include "runtime/vm_options.h"
 
 namespace jvm::runtime {
 
+namespace {
+
+// The synthetic classes of the VM have no loader; the few tables they need live as long as the
+// VM does
+Metaspace& vmMetaspace() {
+  static Metaspace metaspace;
+  return metaspace;
+}
+
+}  // namespace
+
 Klass::Klass(class_loader::ClassFile* class_file, class_loader::ClassLoader* loader)
   : loader_(loader),
     class_file_(class_file),
-    name_(class_file->constant_pool.getClassName(class_file->this_class_index)),
+    name_(SymbolTable::getInstance().intern(
+      class_file->constant_pool.getClassName(class_file->this_class_index))),
     access_flags_(class_file->access_flags),
     super_class_(nullptr),
-    interfaces_(class_file->interfaces_count),
+    interfaces_(loader->getMetaspace().allocate<Klass*>(class_file->interfaces_count),
+                class_file->interfaces_count),
+    constant_pool_(this),
+    method_table_(loader->getMetaspace()),
+    field_table_(loader->getMetaspace()),
+    mirror_class_object_(nullptr) {
+  // filled in by the loader as it links them
+  std::uninitialized_fill(interfaces_.begin(), interfaces_.end(), nullptr);
+}
+
+Klass::Klass(std::string_view name, AccessFlags<flags::Class> access_flags, Klass* super_class)
+  : loader_(nullptr),
+    class_file_(nullptr),
+    name_(SymbolTable::getInstance().intern(name)),
+    access_flags_(access_flags),
+    super_class_(super_class),
     constant_pool_(this),
-    mirror_class_object_(nullptr) {}
+    method_table_(vmMetaspace()),
+    field_table_(vmMetaspace()),
+    mirror_class_object_(nullptr),
+    state_(KlassState::kInitialized) {
+  linkSupertypes();
+}
 
-// NOLINTNEXTLINE(misc-no-recursion)
-Method* Klass::findMethod(const std::string& name, const std::string& descriptor) {
-  for (auto& method : methods_) {
-    if (method.getName() == name && method.getDescriptor() == descriptor) {
+Klass::~Klass() {
+  // the storage belongs to the metaspace, only the members are destroyed here
+  std::destroy_n(methods_.data(), method_count_);
+  std::destroy_n(fields_.data(), field_count_);
+  SymbolTable::release(name_);
+}
+
+namespace {
+
+// Initialization is rare and short next to everything else a class does, so every class
+// shares one lock (the LC of JVMS §5.5) and waiters recheck their class when woken
+std::mutex              init_mutex;
+std::condition_variable init_done;
+
+}  // namespace
+
+Klass::InitClaim Klass::claimInitialization() {
+  if (isInitialized()) {
+    return InitClaim::kDone;
+  }
+  std::unique_lock lock(init_mutex);
+  auto             self = std::this_thread::get_id();
+  init_done.wait(lock, [this, self] {
+    return getState() != KlassState::kInitializing || initializing_thread_ == self;
+  });
+  switch (getState()) {
+    case KlassState::kInitializing:  // a recursive request
+    case KlassState::kInitialized:
+      return InitClaim::kDone;
+    case KlassState::kError:
+      return InitClaim::kErroneous;
+    default:
+      initializing_thread_ = self;
+      state_.store(KlassState::kInitializing, std::memory_order_release);
+      return InitClaim::kClaimed;
+  }
+}
+
+void Klass::finishInitialization(bool succeeded) {
+  {
+    std::lock_guard lock(init_mutex);
+    initializing_thread_ = {};
+    state_.store(succeeded ? KlassState::kInitialized : KlassState::kError,
+                 std::memory_order_release);
+  }
+  init_done.notify_all();
+}
+
+Metaspace& Klass::getMetaspace() const {
+  return loader_ != nullptr ? loader_->getMetaspace() : vmMetaspace();
+}
+
+Method* Klass::getClassInitializer() {
+  // JVMS §2.9.2: named <clinit> and of descriptor ()V, and static too from version 51 on. A
+  // method that only shares the name is not the initializer and never runs as one.
+  constexpr U2 kStaticClinitVersion = 51;
+
+  const bool must_be_static =
+    class_file_ != nullptr && class_file_->version.getMajor() >= kStaticClinitVersion;
+  for (auto& method : methods_.first(method_count_)) {
+    if (method.getName() == "<clinit>" && method.getDescriptor() == "()V" &&
+        (method.isStatic() || !must_be_static)) {
       return &method;
     }
   }
+  return nullptr;
+}
+
+void Klass::linkSupertypes() {
+  if (super_class_ != nullptr) {
+    super_depth_ = super_class_->super_depth_ + 1;
+    for (U1 depth = 0; depth < kPrimarySuperLimit; depth++) {
+      auto* super = super_class_->super_display_[depth].load(std::memory_order_relaxed);
+      super_display_[depth].store(super, std::memory_order_relaxed);
+    }
+  }
+  // an interface has no superclass but Object, so it never takes a primary slot
+  const bool primary = !isInterface() && super_depth_ < kPrimarySuperLimit;
+  if (primary) {
+    super_check_index_ = static_cast<U1>(super_depth_);
+    super_display_[super_check_index_].store(this, std::memory_order_relaxed);
+  } else {
+    super_check_index_ = kSecondarySuperCache;
+  }
+
+  // room for this class and the secondary supers of its superclass and interfaces, of which
+  // the ones they share are kept once
+  size_t capacity = primary ? 0 : 1;
+  if (super_class_ != nullptr) {
+    capacity += super_class_->secondary_supers_.size();
+  }
+  for (const auto* interface : interfaces_) {
+    capacity += interface->secondary_supers_.size();
+  }
+  if (capacity == 0) {
+    return;
+  }
+  const auto** secondary = getMetaspace().allocate<const Klass*>(capacity);
+  size_t       count     = 0;
+
+  auto addSecondary = [secondary, &count](const Klass* klass) {
+    if (std::find(secondary, secondary + count, klass) == secondary + count) {
+      secondary[count++] = klass;
+    }
+  };
   if (super_class_ != nullptr) {
+    std::ranges::for_each(super_class_->secondary_supers_, addSecondary);
+  }
+  if (!primary) {
+    addSecondary(this);
+  }
+  for (const auto* interface : interfaces_) {
+    std::ranges::for_each(interface->secondary_supers_, addSecondary);
+  }
+  secondary_supers_ = {secondary, count};
+}
+
+bool Klass::isSecondarySubtypeOf(const Klass* other) const {
+  if (std::ranges::find(secondary_supers_, other) == secondary_supers_.end()) {
+    return false;
+  }
+  // racing threads may overwrite each other's entry, and any of them is correct
+  super_display_[kSecondarySuperCache].store(other, std::memory_order_relaxed);
+  return true;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+Method* Klass::findMethod(const Symbol* name, const Symbol* descriptor) {
+  if (auto* method = method_table_.find(name, descriptor); method != nullptr) {
+    return method;
+  }
+  if (super_class_ != nullptr && !member_tables_flattened_) {
     return super_class_->findMethod(name, descriptor);
   }
   return nullptr;
 }
 
 // NOLINTNEXTLINE(misc-no-recursion)
-Field* Klass::findField(const std::string& name, const std::string& descriptor) {
-  for (auto& field : fields_) {
-    if (field.getName() == name && field.getDescriptor() == descriptor) {
-      return &field;
-    }
+Field* Klass::findField(const Symbol* name, const Symbol* descriptor) {
+  if (auto* field = field_table_.find(name, descriptor); field != nullptr) {
+    return field;
   }
-  if (super_class_ != nullptr) {
+  if (super_class_ != nullptr && !member_tables_flattened_) {
     return super_class_->findField(name, descriptor);
   }
   return nullptr;
 }
 
-void Klass::prepareRuntimeConstantPool(class_loader::ClassFile* class_file) {
-  // create runtime constant pool
-  size_t cp_count = class_file->constant_pool.size();
-  constant_pool_.infos_.resize(cp_count);
-  constant_pool_.infos_[0] = std::monostate{};  // placeholder for the first slot
-  for (size_t i = 1; i < cp_count; i++) {
-    const auto* cpinfo = class_file->constant_pool.getConstantInfo(i);
-    switch (cpinfo->tag) {
-      case class_loader::ConstantTag::kClass: {
-        const auto* info = dynamic_cast<const class_loader::ClassInfo*>(cpinfo);
-        constant_pool_.setConstant(i, SymRef_Class{.name_index = info->name_index});
-      } break;
-      case class_loader::ConstantTag::kMethodref: {
-        const auto* info = dynamic_cast<const class_loader::MethodrefInfo*>(cpinfo);
-        constant_pool_.setConstant(i,
-                                   SymRef_Method{.class_index         = info->class_index,
-                                                 .name_and_type_index = info->name_and_type_index});
-      } break;
-      case class_loader::ConstantTag::kFieldref: {
-        const auto* info = dynamic_cast<const class_loader::FieldrefInfo*>(cpinfo);
-        constant_pool_.setConstant(i,
-                                   SymRef_Field{.class_index         = info->class_index,
-                                                .name_and_type_index = info->name_and_type_index});
-      } break;
-      case class_loader::ConstantTag::kInterfaceMethodref: {
-        const auto* info = dynamic_cast<const class_loader::InterfaceMethodrefInfo*>(cpinfo);
-        constant_pool_.setConstant(
-          i, SymRef_InterfaceMethod{.class_index         = info->class_index,
-                                    .name_and_type_index = info->name_and_type_index});
-      } break;
-
-      case class_loader::ConstantTag::kInteger: {
-        auto rt_cpinfo = dynamic_cast<const class_loader::IntegerInfo*>(cpinfo)->value;
-        constant_pool_.setConstant(i, rt_cpinfo);
-      } break;
-
-      case class_loader::ConstantTag::kLong: {
-        auto rt_cpinfo = dynamic_cast<const class_loader::LongInfo*>(cpinfo)->value;
-        constant_pool_.setConstant(i, rt_cpinfo);
-        i++;
-        constant_pool_.infos_[i] = std::monostate{};  // placeholder for the second slot
-      } break;
-      case class_loader::ConstantTag::kFloat: {
-        auto rt_cpinfo = dynamic_cast<const class_loader::FloatInfo*>(cpinfo)->value;
-        constant_pool_.setConstant(i, rt_cpinfo);
-      } break;
-      case class_loader::ConstantTag::kDouble: {
-        auto rt_cpinfo = dynamic_cast<const class_loader::DoubleInfo*>(cpinfo)->value;
-        constant_pool_.setConstant(i, rt_cpinfo);
-        i++;
-        constant_pool_.infos_[i] = std::monostate{};  // placeholder for the second slot
-      } break;
-
-      case class_loader::ConstantTag::kString: {
-        // TODO: string intern
-        auto index     = dynamic_cast<const class_loader::StringInfo*>(cpinfo)->string_index;
-        auto rt_cpinfo = class_file->constant_pool.getUtf8String(index);
-        constant_pool_.setConstant(i, rt_cpinfo);
-      } break;
-
-      // TODO: dynamic language support
-      case class_loader::ConstantTag::kMethodHandle:
-        break;
-      case class_loader::ConstantTag::kMethodType:
-        break;
-      case class_loader::ConstantTag::kInvokeDynamic:
-        break;
+Method* Klass::findMethod(std::string_view name, std::string_view descriptor) {
+  const auto& symbols = SymbolTable::getInstance();
+  const auto* name_symbol       = symbols.lookup(name);
+  const auto* descriptor_symbol = symbols.lookup(descriptor);
+  if (name_symbol == nullptr || descriptor_symbol == nullptr) {
+    return nullptr;
+  }
+  return findMethod(name_symbol, descriptor_symbol);
+}
 
-      // just ignore these constant pool entries
-      case class_loader::ConstantTag::kNameAndType:
-      case class_loader::ConstantTag::kUtf8:
-        break;
-      default:
-        throw std::runtime_error("Unknown constant pool tag: " +
-                                 std::to_string(static_cast<int>(cpinfo->tag)));
-    }
+Field* Klass::findField(std::string_view name, std::string_view descriptor) {
+  const auto& symbols = SymbolTable::getInstance();
+  const auto* name_symbol       = symbols.lookup(name);
+  const auto* descriptor_symbol = symbols.lookup(descriptor);
+  if (name_symbol == nullptr || descriptor_symbol == nullptr) {
+    return nullptr;
   }
+  return findField(name_symbol, descriptor_symbol);
+}
+
+void Klass::prepareRuntimeConstantPool(class_loader::ClassFile* class_file) {
+  // entries are materialized from the class file on first use
+  constant_pool_.allocate(class_file->constant_pool.size(), getMetaspace());
 }
 
 void Klass::prepareMethods(class_loader::ClassFile* class_file) {
@@ -125,51 +234,142 @@ void Klass::prepareMethods(class_loader::ClassFile* class_file) {
   for (auto& member_info : class_file->methods.getMembers()) {
     auto* method_info  = dynamic_cast<class_loader::MethodInfo*>(member_info.get());
     auto  access_flags = method_info->access_flags;
-    // optimize after string intern
-    auto   name       = class_file->constant_pool.getUtf8String(method_info->name_index);
-    auto   descriptor = class_file->constant_pool.getUtf8String(method_info->descriptor_index);
-    Method method(access_flags, name, descriptor, this);
-    if (access_flags.has(flags::Method::NATIVE)) {
+    const auto* name       = class_file->constant_pool.getUtf8Symbol(method_info->name_index);
+    const auto* descriptor = class_file->constant_pool.getUtf8Symbol(method_info->descriptor_index);
+    if (access_flags.has(flags::Method::NATIVE) || access_flags.has(flags::Method::ABSTRACT)) {
       // TODO: native method binding
       // this->linkNativeMethods(&method);
-    } else if (!access_flags.has(flags::Method::ABSTRACT)) {
-      // if a method is not native and not abstract, it must have code
-      // find Code attribute
-      auto* code_attribute = method_info->attributes.getAttribute<class_loader::CodeAttribute>();
-      if (code_attribute != nullptr) {
-        method.max_stack_  = code_attribute->max_stack;
-        method.max_locals_ = code_attribute->max_locals;
-        method.code_       = std::move(code_attribute->code);
-      } else {
-        throw std::runtime_error("Method " + name + " has no code attribute");
-      }
+      addMethod(access_flags, name, descriptor, 0, 0, {}, {});
+      continue;
     }
-    methods_.emplace_back(std::move(method));
+
+    // if a method is not native and not abstract, it must have code
+    // find Code attribute
+    auto* code_attribute = method_info->attributes.getAttribute<class_loader::CodeAttribute>();
+    if (code_attribute == nullptr) {
+      throw std::runtime_error("Method " + name->str() + " has no code attribute");
+    }
+    addMethod(access_flags, name, descriptor, code_attribute->info);
   }
 }
 
 void Klass::prepareFieldsAndStatics(class_loader::ClassFile* class_file) {
   // create fields
-  size_t instance_slot_count = 0;
-  size_t static_slot_count   = 0;
   for (auto& member_info : class_file->fields.getMembers()) {
     auto* field_info   = dynamic_cast<class_loader::FieldInfo*>(member_info.get());
-    auto  access_flags = field_info->access_flags;
-    // optimize after string intern
-    auto  name       = class_file->constant_pool.getUtf8String(field_info->name_index);
-    auto  descriptor = class_file->constant_pool.getUtf8String(field_info->descriptor_index);
-    Field field(access_flags, name, descriptor, this);
-    if (access_flags.has(flags::Field::STATIC)) {
-      field.slot_index_ = static_slot_count;
-      static_slot_count += (descriptor == "J" || descriptor == "D") ? 2 : 1;
-    } else {
-      field.slot_index_ = instance_slot_count;
-      instance_slot_count += (descriptor == "J" || descriptor == "D") ? 2 : 1;
+    const auto* name       = class_file->constant_pool.getUtf8Symbol(field_info->name_index);
+    const auto* descriptor = class_file->constant_pool.getUtf8Symbol(field_info->descriptor_index);
+    addField(field_info->access_flags, name, descriptor);
+  }
+  allocateStatics();
+}
+
+void Klass::allocateStatics() {
+  statics_ = {getMetaspace().allocate<Slot>(static_slot_count_), static_slot_count_};
+  std::uninitialized_value_construct(statics_.begin(), statics_.end());
+}
+
+void Klass::allocateMembers(size_t method_count, size_t field_count) {
+  auto& metaspace = loader_->getMetaspace();
+  methods_        = {metaspace.allocate<Method>(method_count), method_count};
+  fields_         = {metaspace.allocate<Field>(field_count), field_count};
+}
+
+Method& Klass::emplaceMethod(AccessFlags<flags::Method> access_flags, const Symbol* name,
+                             const Symbol* descriptor) {
+  if (method_count_ == methods_.size()) {
+    throw std::runtime_error("No room for another method in " + name_->str());
+  }
+  return *new (&methods_[method_count_++]) Method(access_flags, name, descriptor, this);
+}
+
+void Klass::addMethod(AccessFlags<flags::Method> access_flags, const Symbol* name,
+                      const Symbol* descriptor, U2 max_stack, U2 max_locals,
+                      std::span<const U1> code, std::span<const ExceptionHandler> handlers) {
+  auto& method = emplaceMethod(access_flags, name, descriptor);
+  if (!code.empty()) {
+    method.hot_.max_stack   = max_stack;
+    method.hot_.max_locals  = max_locals;
+    method.exception_table_ = ExceptionHandlerTable(handlers);
+    method.setCode(code);
+    if (method.isStatic() && !method.isSynchronized()) {
+      method.trivial_ = TrivialMethod::match(code, method.hot_.arg_slot_count);
+    }
+  }
+  method.hot_.decoded.store(true, std::memory_order_release);
+}
+
+void Klass::addMethod(AccessFlags<flags::Method> access_flags, const Symbol* name,
+                      const Symbol* descriptor, std::span<const U1> code_attribute) {
+  emplaceMethod(access_flags, name, descriptor).code_attribute_ = code_attribute;
+  class_bytes_users_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Klass::releaseClassBytes() {
+  if (class_bytes_users_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    // every Code attribute is copied out, so nothing views the bytes any more
+    class_file_->source = {};
+  }
+}
+
+void Klass::addField(AccessFlags<flags::Field> access_flags, const Symbol* name,
+                     const Symbol* descriptor) {
+  if (field_count_ == fields_.size()) {
+    throw std::runtime_error("No room for another field in " + name_->str());
+  }
+  auto&      field = *new (&fields_[field_count_++]) Field(access_flags, name, descriptor, this);
+  const bool wide  = descriptor->view() == "J" || descriptor->view() == "D";
+  if (access_flags.has(flags::Field::STATIC)) {
+    field.slot_index_ = static_slot_count_;
+    static_slot_count_ += wide ? 2 : 1;
+  } else {
+    field.slot_index_ = instance_slot_count_;
+    instance_slot_count_ += wide ? 2 : 1;
+  }
+}
+
+void Klass::buildMemberTables() {
+  const bool flatten = VMOptions::getInstance().flatten_member_tables;
+  // the superclasses a flattened table takes the members of, linked before this class: up to
+  // the first one that is flattened itself, as its tables already hold everything above it
+  auto forEachInherited = [this](auto&& fn) {
+    for (auto* klass = super_class_; klass != nullptr; klass = klass->super_class_) {
+      fn(klass);
+      if (klass->member_tables_flattened_) {
+        break;
+      }
     }
-    fields_.push_back(field);
+  };
+
+  // the tables are sized once for every member they may get, so they never grow
+  size_t method_capacity = method_count_;
+  size_t field_capacity  = field_count_;
+  if (flatten) {
+    forEachInherited([&method_capacity, &field_capacity](Klass* klass) {
+      method_capacity += klass->method_table_.size();
+      field_capacity += klass->field_table_.size();
+    });
+  }
+  method_table_.reserve(method_capacity);
+  field_table_.reserve(field_capacity);
+
+  // members never move, so the pointers stay valid
+  for (auto& method : methods_.first(method_count_)) {
+    method_table_.insert(&method);
+  }
+  for (auto& field : fields_.first(field_count_)) {
+    field_table_.insert(&field);
+  }
+
+  if (!flatten) {
+    return;
   }
-  instance_slot_count_ = instance_slot_count;
-  static_slot_count_   = static_slot_count;
+  // own members were inserted first and shadow inherited ones with the same name and descriptor
+  forEachInherited([this](Klass* klass) {
+    klass->method_table_.forEach([this](Method* method) { method_table_.insert(method); });
+    klass->field_table_.forEach([this](Field* field) { field_table_.insert(field); });
+  });
+  member_tables_flattened_ = true;
 }
 
 // void Klass::linkNativeMethods(runtime::Method* method) {
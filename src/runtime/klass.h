@@ -1,12 +1,18 @@
 #pragma once
 
-#include <vector>
+#include <array>
+#include <atomic>
+#include <span>
+#include <string_view>
+#include <thread>
 
 #include "common/access_flags.hpp"
 #include "constant_pool.h"
 #include "field.h"
+#include "member_table.h"
 #include "method.h"
 #include "slot.h"
+#include "symbol.h"
 
 namespace jvm::class_loader {
 class ClassLoader;
@@ -18,58 +24,189 @@ namespace jvm::runtime {
 
 class Object;
 
-// enum class KlassState {
-//   LOADED,
-//   LINKED,
-//   PREPARING,
-//   INITIALIZING,
-//   INITIALIZED,
-//   ERROR,
-// };
+// Where a class is in its life cycle (JVMS §5.5). A class read from a class file is kLinked
+// once its loader has prepared it, and initialized on first active use by the interpreter;
+// the synthetic classes of the VM are born initialized.
+enum class KlassState : U1 {
+  kLoaded,
+  kLinked,
+  kInitializing,
+  kInitialized,
+  kError,
+};
 
+// A class defined by a class loader lives in that loader's Metaspace, with its method and field
+// arrays, member tables, constant pool entries, static slots and supertype lists next to it, and
+// is destroyed when the loader is. The synthetic classes of the VM take theirs from an arena of
+// the VM's own.
 class Klass {
  public:
   explicit Klass(class_loader::ClassFile* class_file, class_loader::ClassLoader* loader);
+  // Synthetic class defined by the VM itself; it has no class file, members or loader
+  Klass(std::string_view name, AccessFlags<flags::Class> access_flags, Klass* super_class);
+  Klass(const Klass&)            = delete;
+  Klass(Klass&&)                 = delete;
+  Klass& operator=(const Klass&) = delete;
+  Klass& operator=(Klass&&)      = delete;
+  ~Klass();
 
   class_loader::ClassLoader* getClassLoader() const { return loader_; }
   class_loader::ClassFile*   getClassFile() const { return class_file_; }
+  std::string_view           getName() const { return name_->view(); }
+  AccessFlags<flags::Class>  getAccessFlags() const { return access_flags_; }
+  const Symbol*              getNameSymbol() const { return name_; }
   void                       setSuperClass(Klass* super_class) { super_class_ = super_class; }
   Klass*                     getSuperClass() const { return super_class_; }
   void setInterface(U2 index, Klass* interface) { interfaces_[index] = interface; }
-  const std::vector<Klass*>& getInterfaces() const { return interfaces_; }
+  std::span<Klass* const>    getInterfaces() const { return interfaces_; }
   RuntimeConstantPool&       getRuntimeConstantPool() { return constant_pool_; }
+  std::span<const Method>    getMethods() const { return methods_.first(method_count_); }
+  std::span<const Field>     getFields() const { return fields_.first(field_count_); }
   size_t                     getInstanceSlotCount() const { return instance_slot_count_; }
   size_t                     getStaticSlotCount() const { return static_slot_count_; }
-  Method*                    findMethod(const std::string& name, const std::string& descriptor);
-  Field*                     findField(const std::string& name, const std::string& descriptor);
   Slot&                      getStaticSlot(size_t index) { return statics_[index]; }
 
+  /**
+   * @brief Finds a method declared by this class or inherited from a superclass; matching is
+   * by symbol identity
+   */
+  Method* findMethod(const Symbol* name, const Symbol* descriptor);
+  Field*  findField(const Symbol* name, const Symbol* descriptor);
+
+  /**
+   * @brief Same lookups by string, for names that do not come from a class file. No symbol
+   * is created: a string that was never interned cannot name a member
+   */
+  Method* findMethod(std::string_view name, std::string_view descriptor);
+  Field*  findField(std::string_view name, std::string_view descriptor);
+
+  bool isInterface() const { return access_flags_.has(flags::Class::INTERFACE); }
+
+  /**
+   * @brief Whether this class is `other`, a subclass of it or an implementation of it. Against
+   * a class within kPrimarySuperLimit of the root this is one load and a compare; against an
+   * interface or a deeper class, a hit in the secondary super cache is too, and a miss scans
+   * the secondary supers and fills the cache.
+   */
+  bool isSubtypeOf(const Klass* other) const {
+    U1 index = other->super_check_index_;
+    if (super_display_[index].load(std::memory_order_relaxed) == other) {
+      return true;
+    }
+    // a primary supertype is always found at its depth
+    return index == kSecondarySuperCache && isSecondarySubtypeOf(other);
+  }
+
+  KlassState getState() const { return state_.load(std::memory_order_acquire); }
+  bool       isInitialized() const { return getState() == KlassState::kInitialized; }
+
+  enum class InitClaim : U1 {
+    kDone,       // initialized, or being initialized by the calling thread
+    kClaimed,    // the caller runs <clinit>, then calls finishInitialization
+    kErroneous,  // an earlier initialization failed
+  };
+
+  /**
+   * @brief Steps 1 to 6 of the initialization procedure (JVMS §5.5): waits while another thread
+   * initializes the class, then marks it kInitializing by the calling thread unless it is
+   * already past that. Initializing the superclass first is up to the caller.
+   */
+  InitClaim claimInitialization();
+  /**
+   * @brief Marks a claimed class kInitialized, or kError if its initializer threw, and wakes
+   * the threads waiting for it
+   */
+  void finishInitialization(bool succeeded);
+  // The class initialization method this class declares (JVMS §2.9.2), nullptr if it has none
+  Method* getClassInitializer();
+
  private:
+  // Depths of the primary super display. Classes deeper than that are secondary supers, like
+  // interfaces; the last slot of the display caches the latest secondary super found.
+  static constexpr U1 kPrimarySuperLimit   = 8;
+  static constexpr U1 kSecondarySuperCache = kPrimarySuperLimit;
+
   class_loader::ClassLoader* loader_;
   class_loader::ClassFile*
     class_file_;  // class_file should be initialized first for constant_pool to be valid
 
-  std::string               name_;
+  const Symbol*             name_;
   AccessFlags<flags::Class> access_flags_;
   Klass*                    super_class_;
-  std::vector<Klass*>       interfaces_;
+  std::span<Klass*>         interfaces_;
   RuntimeConstantPool       constant_pool_;
-  std::vector<Method>       methods_;
-  std::vector<Field>        fields_;
-  std::vector<Slot>         statics_;
+  std::span<Slot>           statics_;
+
+  // storage in the loader's metaspace, of which the first method_count_ / field_count_ are
+  // constructed; nothing moves once added
+  std::span<Method> methods_;
+  std::span<Field>  fields_;
+  size_t            method_count_{0};
+  size_t            field_count_{0};
+
+  // (name, descriptor) indexes over methods_ and fields_, built at link time. With
+  // VMOptions::flatten_member_tables they also hold every inherited member, and lookups never
+  // walk up to the superclass.
+  MemberTable<Method> method_table_;
+  MemberTable<Field>  field_table_;
+  bool                member_tables_flattened_{false};
 
   size_t instance_slot_count_{};
   size_t static_slot_count_{};
 
   Object* mirror_class_object_;
 
+  // Subtype checks (see isSubtypeOf), filled in by linkSupertypes. super_display_[d] is the
+  // superclass at depth d, this class included; a check against this class reads the slot at
+  // super_check_index_, its depth or kSecondarySuperCache.
+  mutable std::array<std::atomic<const Klass*>, kPrimarySuperLimit + 1> super_display_{};
+  U1                                                                    super_check_index_{0};
+  U2                                                                    super_depth_{0};
+  std::span<const Klass*>                                               secondary_supers_;
+
+  // Users of the class file bytes (ClassFile::source): each method whose Code attribute is not
+  // decoded yet, and the loader until the class is prepared. The last to go releases them.
+  std::atomic<size_t> class_bytes_users_{1};
+
+  std::atomic<KlassState> state_{KlassState::kLoaded};
+  std::thread::id         initializing_thread_;  // while kInitializing
+
   // define class
   void prepareRuntimeConstantPool(class_loader::ClassFile* class_file);
   void prepareMethods(class_loader::ClassFile* class_file);
   void prepareFieldsAndStatics(class_loader::ClassFile* class_file);
+  void buildMemberTables();
+  // Builds the super display and the secondary supers once the superclass and interfaces are
+  // linked, from theirs
+  void linkSupertypes();
+  bool isSecondarySubtypeOf(const Klass* other) const;
+  // Where the tables of this class are allocated
+  Metaspace& getMetaspace() const;
+
+  // Room for the members, allocated from the loader's metaspace before any is added
+  void    allocateMembers(size_t method_count, size_t field_count);
+  Method& emplaceMethod(AccessFlags<flags::Method> access_flags, const Symbol* name,
+                        const Symbol* descriptor);
+  // One member, declared by the class file or restored from the shared archive. A method
+  // without code (native or abstract) has an empty `code`; a field gets the next free slot.
+  void addMethod(AccessFlags<flags::Method> access_flags, const Symbol* name,
+                 const Symbol* descriptor, U2 max_stack, U2 max_locals,
+                 std::span<const U1> code, std::span<const ExceptionHandler> handlers);
+  // A method whose Code attribute body is decoded on its first invocation
+  void addMethod(AccessFlags<flags::Method> access_flags, const Symbol* name,
+                 const Symbol* descriptor, std::span<const U1> code_attribute);
+  void addField(AccessFlags<flags::Field> access_flags, const Symbol* name,
+                const Symbol* descriptor);
+  // Sizes the static slots once every field is added, all zero
+  void allocateStatics();
+  // Drops one user of the class file bytes, releasing them if it was the last
+  void releaseClassBytes();
+  // Once the class is prepared, its members are immutable and it may be initialized
+  void markLinked() { state_.store(KlassState::kLinked, std::memory_order_release); }
   // void linkNativeMethods(runtime::Method* method);
 
   friend class class_loader::ClassLoader;
+  friend class Method;
 };
 
 }  // namespace jvm::runtime
\ No newline at end of file
@@ -10,12 +10,20 @@
  */
 #pragma once
 
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 #include "runtime/slot.h"
 
 namespace jvm::runtime {
 
+// The local variable slots of a frame, max_locals of them, in a heap vector of their own.
+// Unlike the frame header they are not carved from the thread's stack mapping (see
+// runtime::Stack), so -Xss bounds the number of frames but not the memory their locals and
+// operand stacks take: deep recursion through methods with many locals can use several times
+// the -Xss size before StackOverflowError.
 class LocalVariables {
  public:
   LocalVariables() = default;
@@ -27,63 +35,82 @@ class LocalVariables {
   ~LocalVariables()                                = default;
 
   U2 getSize() const { return variables_.size(); }
+  // Every slot, for scanning
+  std::span<const Slot> getSlots() const { return variables_; }
 
+  template <bool kChecked = true>
   void setInt(U2 index, Jint value) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     variables_[index].i = value;
   }
+  template <bool kChecked = true>
   Jint getInt(U2 index) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     return variables_[index].i;
   }
+  template <bool kChecked = true>
   void setFloat(U2 index, Jfloat value) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     variables_[index].f = value;
   }
+  template <bool kChecked = true>
   Jfloat getFloat(U2 index) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     return variables_[index].f;
   }
+  template <bool kChecked = true>
   void setLong(U2 index, Jlong value) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     variables_[index].l = value;
   }
+  template <bool kChecked = true>
   Jlong getLong(U2 index) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     return variables_[index].l;
   }
+  template <bool kChecked = true>
   void setDouble(U2 index, Jdouble value) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     variables_[index].d = value;
   }
+  template <bool kChecked = true>
   Jdouble getDouble(U2 index) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     return variables_[index].d;
   }
+  template <bool kChecked = true>
   void setRef(U2 index, Jref value) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     variables_[index].r = value;
   }
+  template <bool kChecked = true>
   Jref getRef(U2 index) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     return variables_[index].r;
   }
 
+  template <bool kChecked = true>
   void setSlot(U2 index, Slot value) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     variables_[index] = value;
   }
+  template <bool kChecked = true>
   Slot getSlot(U2 index) {
-    checkBounds(index);
+    checkBounds<kChecked>(index);
     return variables_[index];
   }
 
  private:
   std::vector<Slot> variables_;
 
+  // compiled out for kChecked = false, see engine::Fast
+  template <bool kChecked>
   void checkBounds(U2 index) {
-    if (index >= variables_.size()) {
-      throw std::out_of_range("Index out of bounds in local variables: " + std::to_string(index));
+    if constexpr (kChecked) {
+      if (index >= variables_.size()) {
+        throw std::out_of_range("Index out of bounds in local variables: " +
+                                std::to_string(index));
+      }
     }
   }
 };
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+
+#include "metaspace.h"
+#include "symbol.h"
+
+namespace jvm::runtime {
+
+// Open-addressing hash table from (name, descriptor) to a class member (Method or Field),
+// built once at link time. Keys are interned symbols, so a probe compares two pointers and
+// never touches the member itself. Linear probing over a power-of-two table kept at most half
+// full; an empty table has no storage and every lookup misses.
+//
+// The entries live in a metaspace. Growing leaves the old ones behind in the arena, so a class
+// reserves the final size before inserting anything.
+template <typename Member>
+class MemberTable {
+ public:
+  explicit MemberTable(Metaspace& metaspace) : metaspace_(&metaspace) {}
+
+  // Sizes the table for `count` members so that inserting them does not rehash
+  void reserve(size_t count) {
+    if (count * 2 > entries_.size()) {
+      rehash(std::bit_ceil(count * 2));
+    }
+  }
+
+  /**
+   * @brief Adds `member` unless a member with the same name and descriptor is already present
+   * @return false if the key was taken; the first member added wins, which is how a table that
+   * is filled with a class's own members before its superclass's lets them shadow inherited ones
+   */
+  bool insert(Member* member) {
+    if ((size_ + 1) * 2 > entries_.size()) {
+      rehash(std::max<size_t>(8, entries_.size() * 2));
+    }
+    return insertEntry({.name       = member->getNameSymbol(),
+                        .descriptor = member->getDescriptorSymbol(),
+                        .member     = member});
+  }
+
+  Member* find(const Symbol* name, const Symbol* descriptor) const {
+    if (entries_.empty()) {
+      return nullptr;
+    }
+    size_t mask = entries_.size() - 1;
+    for (size_t i = hashOf(name, descriptor) & mask;; i = (i + 1) & mask) {
+      const auto& entry = entries_[i];
+      if (entry.member == nullptr) {
+        return nullptr;
+      }
+      if (entry.name == name && entry.descriptor == descriptor) {
+        return entry.member;
+      }
+    }
+  }
+
+  size_t size() const { return size_; }
+  size_t capacity() const { return entries_.size(); }
+
+  /**
+   * @brief Calls `fn(Member*)` for every member, in no particular order
+   */
+  template <typename Fn>
+  void forEach(Fn&& fn) const {
+    for (const auto& entry : entries_) {
+      if (entry.member != nullptr) {
+        fn(entry.member);
+      }
+    }
+  }
+
+ private:
+  struct Entry {
+    const Symbol* name{nullptr};
+    const Symbol* descriptor{nullptr};
+    Member*       member{nullptr};  // nullptr marks an empty bucket
+  };
+
+  static size_t hashOf(const Symbol* name, const Symbol* descriptor) {
+    // the symbol hashes are already well mixed; the multiply spreads the descriptor's bits so
+    // that overloads of one name do not collide
+    return name->hash() ^ (descriptor->hash() * 0x9E37'79B9'7F4A'7C15ULL);
+  }
+
+  bool insertEntry(const Entry& new_entry) {
+    size_t mask = entries_.size() - 1;
+    for (size_t i = hashOf(new_entry.name, new_entry.descriptor) & mask;; i = (i + 1) & mask) {
+      auto& entry = entries_[i];
+      if (entry.member == nullptr) {
+        entry = new_entry;
+        size_++;
+        return true;
+      }
+      if (entry.name == new_entry.name && entry.descriptor == new_entry.descriptor) {
+        return false;
+      }
+    }
+  }
+
+  void rehash(size_t capacity) {
+    auto old = entries_;
+    entries_ = {metaspace_->allocate<Entry>(capacity), capacity};
+    std::uninitialized_fill(entries_.begin(), entries_.end(), Entry{});
+    size_ = 0;
+    for (const auto& entry : old) {
+      if (entry.member != nullptr) {
+        insertEntry(entry);
+      }
+    }
+  }
+
+  Metaspace*       metaspace_;
+  std::span<Entry> entries_;
+  size_t           size_{0};
+};
+
+}  // namespace jvm::runtime
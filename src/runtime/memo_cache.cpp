@@ -0,0 +1,125 @@
+#include "memo_cache.h"
+
+#include <algorithm>
+#include <bit>
+#include <memory>
+#include <mutex>
+
+#include "class_loader/class_loader.h"
+#include "klass.h"
+#include "metaspace.h"
+#include "method.h"
+#include "purity.h"
+#include "vm_options.h"
+
+namespace jvm::runtime {
+
+MemoCache::MemoCache(size_t capacity, std::string_view descriptor)
+  : entries_(std::bit_ceil(std::max<size_t>(capacity, 1))),
+    index_bits_(static_cast<U1>(std::countr_zero(entries_.size()))) {
+  // descriptors of pure methods only contain primitive types
+  size_t i = 1;
+  for (; descriptor[i] != ')'; i++) {
+    if (descriptor[i] == 'J' || descriptor[i] == 'D') {
+      wide_slots_ |= 0b11U << arg_slot_count_;
+      arg_slot_count_ += 2;
+    } else {
+      arg_slot_count_++;
+    }
+  }
+  returns_wide_ = descriptor[i + 1] == 'J' || descriptor[i + 1] == 'D';
+}
+
+MemoCache::Key MemoCache::makeKey(LocalVariables& args) const {
+  // only the bytes a value actually occupies are significant
+  Key key{};
+  for (U2 i = 0; i < arg_slot_count_; i++) {
+    auto slot = args.getSlot(i);
+    key[i]    = (wide_slots_ >> i & 1U) != 0 ? std::bit_cast<U8>(slot.l)
+                                            : static_cast<U8>(std::bit_cast<U4>(slot.i));
+  }
+  return key;
+}
+
+std::optional<Slot> MemoCache::lookup(const Key& key) {
+  auto& entry    = entries_[bucketOf(key)];
+  U4    sequence = entry.sequence.load(std::memory_order_acquire);
+  if (sequence != 0 && (sequence & 1U) == 0) {
+    Key stored{};
+    for (size_t i = 0; i < stored.size(); i++) {
+      stored[i] = std::atomic_ref(entry.key[i]).load(std::memory_order_relaxed);
+    }
+    U8 result = std::atomic_ref(entry.result).load(std::memory_order_relaxed);
+    // the entry was read whole if no insert began meanwhile
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (entry.sequence.load(std::memory_order_relaxed) == sequence && stored == key) {
+      hits_.fetch_add(1, std::memory_order_relaxed);
+      return std::bit_cast<Slot>(result);
+    }
+  }
+  misses_.fetch_add(1, std::memory_order_relaxed);
+  return std::nullopt;
+}
+
+void MemoCache::insert(const Key& key, Slot result) {
+  auto& entry    = entries_[bucketOf(key)];
+  U4    sequence = entry.sequence.load(std::memory_order_relaxed);
+  if ((sequence & 1U) != 0 ||
+      !entry.sequence.compare_exchange_strong(sequence, sequence + 1, std::memory_order_relaxed)) {
+    return;  // another thread is writing the bucket
+  }
+  std::atomic_thread_fence(std::memory_order_release);
+
+  bool other_key = false;
+  for (size_t i = 0; i < key.size(); i++) {
+    auto word = std::atomic_ref(entry.key[i]);
+    other_key = other_key || word.load(std::memory_order_relaxed) != key[i];
+    word.store(key[i], std::memory_order_relaxed);
+  }
+  std::atomic_ref(entry.result).store(std::bit_cast<U8>(result), std::memory_order_relaxed);
+  entry.sequence.store(sequence + 2, std::memory_order_release);
+  if (sequence != 0 && other_key) {
+    evictions_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+MemoCache::Stats MemoCache::getStats() const {
+  return {.hits      = hits_.load(std::memory_order_relaxed),
+          .misses    = misses_.load(std::memory_order_relaxed),
+          .evictions = evictions_.load(std::memory_order_relaxed)};
+}
+
+size_t MemoCache::bucketOf(const Key& key) const {
+  // fold the words, then Fibonacci hashing: the top bits of the product spread nearby
+  // arguments (the common case, small ints) over distinct buckets
+  // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+  U8 folded = 0;
+  for (size_t i = 0; i < key.size(); i++) {
+    folded ^= std::rotl(key[i], static_cast<int>(i * 17));
+  }
+  U8 hash = folded * 0x9E3779B97F4A7C15ULL;
+  return index_bits_ == 0 ? 0 : hash >> (64U - index_bits_);
+  // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+}
+
+MemoCache* getMemoCache(Method* method) {
+  if (auto* cache = method->memo_cache_.load(std::memory_order_acquire)) {
+    return cache;
+  }
+  if (method->getArgSlotCount() > MemoCache::kMaxArgSlots || !isPure(method)) {
+    return nullptr;
+  }
+  // once per memoized method, so a single lock is not contended
+  static std::mutex create_mutex;
+  std::lock_guard   lock(create_mutex);
+  if (auto* cache = method->memo_cache_.load(std::memory_order_relaxed)) {
+    return cache;  // another thread created it while this one waited
+  }
+  auto& metaspace = method->getOwnerKlass()->getClassLoader()->getMetaspace();
+  auto* cache     = metaspace.create<MemoCache>(VMOptions::getInstance().memo_cache_size,
+                                            method->getDescriptor());
+  method->memo_cache_.store(cache, std::memory_order_release);
+  return cache;
+}
+
+}  // namespace jvm::runtime
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include "common/types.h"
+#include "local_variables.h"
+#include "slot.h"
+
+namespace jvm::runtime {
+
+class Method;
+
+// Bounded cache of a pure static method's results, keyed by its argument slots, consulted by
+// INVOKESTATIC when memoization is enabled (-XX:+MemoizePureMethods). The table is
+// direct-mapped: a new result replaces whatever occupied its bucket, which counts as an
+// eviction. Every thread calling the method shares it: each entry is a sequence lock, so a
+// lookup that races an insert into its bucket misses rather than reading a torn entry, and an
+// insert that races another one into the same bucket is dropped.
+class MemoCache {
+ public:
+  // Methods with more argument slots are not memoized
+  static constexpr U2 kMaxArgSlots = 4;
+
+  using Key = std::array<U8, kMaxArgSlots>;
+
+  // A snapshot of the counters
+  struct Stats {
+    U8 hits{0};
+    U8 misses{0};
+    U8 evictions{0};
+
+    double hitRate() const {
+      auto lookups = hits + misses;
+      return lookups == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(lookups);
+    }
+  };
+
+  /**
+   * @param capacity Number of entries, rounded up to a power of two
+   * @param descriptor Method descriptor, which tells the width of each argument and the result
+   */
+  MemoCache(size_t capacity, std::string_view descriptor);
+
+  /**
+   * @brief Builds the key from the argument slots of a frame about to be entered
+   */
+  Key makeKey(LocalVariables& args) const;
+
+  /**
+   * @brief Looks up a result, counting a hit or a miss
+   * @return The cached result, or std::nullopt
+   */
+  std::optional<Slot> lookup(const Key& key);
+
+  void insert(const Key& key, Slot result);
+
+  bool   returnsWide() const { return returns_wide_; }
+  size_t getCapacity() const { return entries_.size(); }
+  Stats  getStats() const;
+
+ private:
+  // The key and result are accessed through std::atomic_ref, as readers may race a writer
+  struct Entry {
+    std::atomic<U4> sequence{0};  // odd while being written, 0 while empty
+    Key             key{};
+    U8              result{0};  // the Slot's bits
+  };
+
+  size_t bucketOf(const Key& key) const;
+
+  std::vector<Entry> entries_;
+  U1                 index_bits_{0};  // log2 of the capacity
+  U2                 arg_slot_count_{0};
+  U4                 wide_slots_{0};  // bit i set: argument slot i is half of a long/double
+  bool               returns_wide_{false};
+  std::atomic<U8>    hits_{0};
+  std::atomic<U8>    misses_{0};
+  std::atomic<U8>    evictions_{0};
+};
+
+/**
+ * @brief Returns the memo cache of `method`, created in its loader's metaspace on first use, or
+ * nullptr if the method cannot be memoized (not pure, or too many argument slots); safe to call
+ * from several threads
+ */
+MemoCache* getMemoCache(Method* method);
+
+}  // namespace jvm::runtime
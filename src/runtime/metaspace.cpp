@@ -0,0 +1,56 @@
+#include "metaspace.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace jvm::runtime {
+
+namespace {
+
+size_t paddingFor(const std::byte* cursor, size_t alignment) {
+  auto address = reinterpret_cast<std::uintptr_t>(cursor);  // NOLINT
+  return (alignment - address % alignment) % alignment;
+}
+
+}  // namespace
+
+Metaspace::~Metaspace() {
+  // the chunks go when the members are destroyed
+  for (auto it = destructors_.rbegin(); it != destructors_.rend(); ++it) {
+    it->second(it->first);
+  }
+}
+
+void* Metaspace::allocateBytes(size_t size, size_t alignment) {
+  std::lock_guard lock(mutex_);
+  size_t          padding = paddingFor(cursor_, alignment);
+  if (size + padding > remaining_) {
+    // each chunk is as large as all before it together, and has room for the request however
+    // its start is aligned
+    size_t chunk_size =
+      chunks_.empty() ? kMinChunkSize : std::min(reserved_bytes_, kMaxChunkSize);
+    chunk_size = std::max(chunk_size, size + alignment - 1);
+    chunks_.push_back(std::make_unique<std::byte[]>(chunk_size));  // NOLINT(*-avoid-c-arrays)
+    cursor_    = chunks_.back().get();
+    remaining_ = chunk_size;
+    padding    = paddingFor(cursor_, alignment);
+    reserved_bytes_ += chunk_size;
+  }
+  auto* storage = cursor_ + padding;
+  cursor_ += padding + size;
+  remaining_ -= padding + size;
+  used_bytes_ += size;
+  return storage;
+}
+
+size_t Metaspace::getReservedBytes() const {
+  std::lock_guard lock(mutex_);
+  return reserved_bytes_;
+}
+
+size_t Metaspace::getUsedBytes() const {
+  std::lock_guard lock(mutex_);
+  return used_bytes_;
+}
+
+}  // namespace jvm::runtime
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace jvm::runtime {
+
+// Arena for the class metadata of one class loader. Klass objects and their method and field
+// arrays are bump-allocated from chunks no other loader uses, so the metadata of a loader is
+// contiguous, allocating it takes only this arena's lock, and nothing ever moves. Chunks start
+// small and double up to kMaxChunkSize, so a loader with a handful of classes reserves little.
+//
+// Nothing is freed on its own. When the loader is destroyed the arena runs the destructors of
+// the objects that own heap memory, most recent first, and then releases its chunks together.
+class Metaspace {
+ public:
+  Metaspace() = default;
+  Metaspace(const Metaspace&)            = delete;
+  Metaspace(Metaspace&&)                 = delete;
+  Metaspace& operator=(const Metaspace&) = delete;
+  Metaspace& operator=(Metaspace&&)      = delete;
+  ~Metaspace();
+
+  /**
+   * @brief Uninitialized storage for `count` objects of type T, over-aligned ones included; the
+   * caller constructs them and destroys any it constructed
+   */
+  template <typename T>
+  T* allocate(size_t count = 1) {
+    return static_cast<T*>(allocateBytes(sizeof(T) * count, alignof(T)));
+  }
+
+  /**
+   * @brief Constructs a T in the arena; its destructor runs when the arena is destroyed
+   */
+  template <typename T, typename... Args>
+  T* create(Args&&... args) {
+    auto* object = new (allocate<T>()) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      std::lock_guard lock(mutex_);
+      destructors_.emplace_back(object, [](void* storage) { static_cast<T*>(storage)->~T(); });
+    }
+    return object;
+  }
+
+  // Bytes of chunks reserved, and the part of them handed out
+  size_t getReservedBytes() const;
+  size_t getUsedBytes() const;
+
+ private:
+  static constexpr size_t kMinChunkSize = 4 * 1024;
+  static constexpr size_t kMaxChunkSize = 64 * 1024;
+
+  void* allocateBytes(size_t size, size_t alignment);
+
+  mutable std::mutex                             mutex_;
+  std::vector<std::unique_ptr<std::byte[]>>      chunks_;  // NOLINT(*-avoid-c-arrays)
+  std::byte*                                     cursor_{nullptr};
+  size_t                                         remaining_{0};
+  size_t                                         reserved_bytes_{0};
+  size_t                                         used_bytes_{0};
+  std::vector<std::pair<void*, void (*)(void*)>> destructors_;
+};
+
+}  // namespace jvm::runtime
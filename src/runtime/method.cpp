@@ -0,0 +1,126 @@
+#include "method.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "class_loader/attributes.hpp"
+#include "class_loader/class_loader.h"
+#include "klass.h"
+
+namespace jvm::runtime {
+
+namespace {
+
+// NOLINTBEGIN(readability-function-cognitive-complexity)
+U2 calculateArgSlotCount(std::string_view descriptor) {
+  U2 slot_count = 0;
+  for (size_t i = 1; i < descriptor.length(); ++i) {
+    char c = descriptor[i];
+    if (c == ')') {
+      break;
+    }
+    if (c == 'L') {
+      // object reference: Ljava/lang/String;
+      // skip until ';'
+      while (descriptor[i] != ';') {
+        i++;
+      }
+      slot_count++;
+    } else if (c == '[') {
+      // array: [[I or [Ljava/lang/String;
+      // array reference only takes 1 slot, skip all '['
+      while (descriptor[i + 1] == '[') {
+        i++;
+      }
+      if (descriptor[i + 1] == 'L') {
+        i++;
+        while (descriptor[i] != ';') {
+          i++;
+        }
+      } else {
+        i++;  // skip basic type characters
+      }
+      slot_count++;
+    } else if (c == 'J' || c == 'D') {
+      // long or double takes 2 slots
+      slot_count += 2;
+    } else {
+      // other basic types (I, F, B, C, S, Z) take 1 slot
+      slot_count++;
+    }
+  }
+  return slot_count;
+}
+// NOLINTEND(readability-function-cognitive-complexity)
+
+}  // namespace
+
+Method::Method(AccessFlags<flags::Method> access_flags, const Symbol* name,
+               const Symbol* descriptor, Klass* owner_klass)
+  : name_(name), descriptor_(descriptor) {
+  hot_.access_flags   = access_flags;
+  hot_.arg_slot_count = calculateArgSlotCount(descriptor->view());
+  hot_.owner_klass    = owner_klass;
+}
+
+void Method::decode() const {
+  // once per method that runs, so a single lock is not contended
+  static std::mutex decode_mutex;
+  std::lock_guard   lock(decode_mutex);
+  if (hot_.decoded.load(std::memory_order_relaxed)) {
+    return;  // another thread decoded it while this one waited
+  }
+
+  auto body       = class_loader::CodeAttribute::decode(code_attribute_);
+  hot_.max_stack  = body.max_stack;
+  hot_.max_locals = body.max_locals;
+  setCode(body.code);
+  std::vector<ExceptionHandler> handlers;
+  handlers.reserve(body.exception_table.size());
+  for (const auto& entry : body.exception_table) {
+    handlers.push_back({.start_pc   = entry.start_pc,
+                        .end_pc     = entry.end_pc,
+                        .handler_pc = entry.handler_pc,
+                        .catch_type = entry.catch_type});
+  }
+  exception_table_ = ExceptionHandlerTable(handlers);
+  if (isStatic() && !isSynchronized()) {
+    trivial_ = TrivialMethod::match(body.code, hot_.arg_slot_count);
+  }
+  hot_.decoded.store(true, std::memory_order_release);
+  code_attribute_ = {};
+  hot_.owner_klass->releaseClassBytes();
+}
+
+void Method::patchOpcode(size_t pc, U1 opcode) {
+  std::atomic_ref<U1>(ensureDecoded().hot_.code[pc]).store(opcode, std::memory_order_release);
+}
+
+void Method::setCode(std::span<const U1> code) const {
+  if (code.empty()) {
+    return;
+  }
+  auto& metaspace = hot_.owner_klass->getClassLoader()->getMetaspace();
+  auto* copy      = metaspace.allocate<U1>(code.size());
+  std::ranges::copy(code, copy);
+  hot_.code        = copy;
+  hot_.code_length = static_cast<U4>(code.size());
+}
+
+std::atomic<U4>* Method::createImplicitExceptionCounts() {
+  auto& metaspace = hot_.owner_klass->getClassLoader()->getMetaspace();
+  auto* counts    = metaspace.allocate<std::atomic<U4>>(hot_.code_length);
+  std::uninitialized_value_construct_n(counts, hot_.code_length);
+  // a thread that loses the race leaves its counters unused in the arena
+  std::atomic<U4>* installed = nullptr;
+  if (implicit_exception_counts_.compare_exchange_strong(installed, counts,
+                                                         std::memory_order_acq_rel,
+                                                         std::memory_order_acquire)) {
+    return counts;
+  }
+  return installed;
+}
+
+}  // namespace jvm::runtime
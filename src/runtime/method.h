@@ -1,9 +1,15 @@
 #pragma once
 
-#include <string>
-#include <vector>
+#include <atomic>
+#include <memory>
+#include <span>
+#include <string_view>
 
 #include "common/access_flags.hpp"
+#include "exception_table.h"
+#include "memo_cache.h"
+#include "symbol.h"
+#include "trivial_method.h"
 
 namespace jvm::runtime {
 
@@ -11,39 +17,143 @@ class Frame;  // avoid circular dependency
 class Klass;
 // using NativeMethod = void (*)(Frame*);
 
+// Laid out hot first: what an invocation reads sits in the method's first cache line, and
+// the names, the Code attribute and the per-method tables follow it. The bytecode itself is
+// copied into the owner's metaspace, next to that of the other methods of its loader.
 class Method {
  public:
-  bool                   isStatic() const { return access_flags_.has(flags::Method::STATIC); }
-  bool                   isNative() const { return access_flags_.has(flags::Method::NATIVE); }
-  const std::string&     getName() const { return name_; }
-  const std::string&     getDescriptor() const { return descriptor_; }
-  Klass*                 getOwnerKlass() const { return owner_klass_; }
-  const std::vector<U1>& getCode() const { return code_; }
-  U2                     getMaxStack() const { return max_stack_; }
-  U2                     getMaxLocals() const { return max_locals_; }
+  AccessFlags<flags::Method> getAccessFlags() const { return hot_.access_flags; }
+
+  bool             isStatic() const { return hot_.access_flags.has(flags::Method::STATIC); }
+  bool             isNative() const { return hot_.access_flags.has(flags::Method::NATIVE); }
+  bool isSynchronized() const { return hot_.access_flags.has(flags::Method::SYNCHRONIZED); }
+  std::string_view getName() const { return name_->view(); }
+  std::string_view getDescriptor() const { return descriptor_->view(); }
+  const Symbol*    getNameSymbol() const { return name_; }
+  const Symbol*    getDescriptorSymbol() const { return descriptor_; }
+  Klass*           getOwnerKlass() const { return hot_.owner_klass; }
+
+  // The body is decoded from the Code attribute the first time one of these is called
+  std::span<const U1> getCode() const {
+    const auto& hot = ensureDecoded().hot_;
+    return {hot.code, hot.code_length};
+  }
+  U2 getMaxStack() const { return ensureDecoded().hot_.max_stack; }
+  U2 getMaxLocals() const { return ensureDecoded().hot_.max_locals; }
+  const ExceptionHandlerTable& getExceptionTable() const {
+    return ensureDecoded().exception_table_;
+  }
+  // Shape of the body if it is simple enough to be executed without a frame
+  const TrivialMethod& getTrivialMethod() const { return ensureDecoded().trivial_; }
+  // kStaticGetter: the static slot the getter reads, set once the field's class is initialized
+  // and published with a release store
+  Slot* getStaticGetterSlot() const { return static_getter_slot_.load(std::memory_order_acquire); }
+  void  setStaticGetterSlot(Slot* slot) const {
+    static_getter_slot_.store(slot, std::memory_order_release);
+  }
+  bool isDecoded() const { return hot_.decoded.load(std::memory_order_acquire); }
+
+  // Slots taken by the arguments, not counting `this`
+  U2 getArgSlotCount() const { return hot_.arg_slot_count; }
+  // Results cache, only present once a memoized call ran (see runtime::getMemoCache)
+  const MemoCache* getMemoCache() const { return memo_cache_.load(std::memory_order_acquire); }
+
+  /**
+   * @brief Rewrites the opcode of the instruction at `pc` to its quick form (engine/opcode.h).
+   * A single byte is stored atomically, so a thread running the same code reads one opcode or
+   * the other. The store is a release: a thread that reads the quick form and then issues an
+   * acquire fence (see engine::loadOpcode) sees everything the patching thread saw, the
+   * initialized statics included.
+   */
+  void patchOpcode(size_t pc, U1 opcode);
+
+  // Counts an implicit exception raised by the instruction at `pc`; returns the new count.
+  // Threads running the method at once may count concurrently.
+  U4 countImplicitException(size_t pc) {
+    auto* counts = implicit_exception_counts_.load(std::memory_order_acquire);
+    if (counts == nullptr) [[unlikely]] {
+      counts = createImplicitExceptionCounts();
+    }
+    return counts[pc].fetch_add(1, std::memory_order_relaxed) + 1;
+  }
+
+  // Profile counters, only maintained by interpreters running with engine::Profiled
+  U4   getInvocationCount() const { return profile_.invocation_count; }
+  U4   getBackedgeCount() const { return profile_.backedge_count; }
+  void incrementInvocationCount() { ++profile_.invocation_count; }
+  void incrementBackedgeCount() { ++profile_.backedge_count; }
 
  private:
+  static constexpr size_t kCacheLineSize = 64;
+
   Method() = default;
-  Method(AccessFlags<flags::Method> access_flags, std::string name, std::string descriptor,
-         Klass* owner_klass)
-    : access_flags_(access_flags),
-      name_(std::move(name)),
-      descriptor_(std::move(descriptor)),
-      owner_klass_(owner_klass) {}
+  Method(AccessFlags<flags::Method> access_flags, const Symbol* name, const Symbol* descriptor,
+         Klass* owner_klass);
+
+  const Method& ensureDecoded() const {
+    if (!isDecoded()) {
+      decode();
+    }
+    return *this;
+  }
+  void decode() const;
+  // Copies `code` into the metaspace of the owner's loader
+  void setCode(std::span<const U1> code) const;
+  // Zeroed implicit exception counters for the code, installed unless another thread did first
+  std::atomic<U4>* createImplicitExceptionCounts();
+
+  // Read on every invocation: the frame size, the bytecode and the owner's constant pool.
+  // decode() fills in the body, hence mutable. Nothing here is written once the method runs.
+  struct Hot {
+    U1*                        code{nullptr};
+    U4                         code_length{0};
+    AccessFlags<flags::Method> access_flags;
+    U2                         arg_slot_count{0};
+    U2                         max_stack{0};
+    U2                         max_locals{0};
+    std::atomic<bool>          decoded{false};
+    Klass*                     owner_klass{nullptr};
+  };
+  static_assert(sizeof(Hot) <= kCacheLineSize);
+
+  alignas(kCacheLineSize) mutable Hot hot_;
+
+  // read when a static method is invoked, so first after the hot line
+  mutable TrivialMethod      trivial_;
+  mutable std::atomic<Slot*> static_getter_slot_{nullptr};
+
+  const Symbol* name_{nullptr};
+  const Symbol* descriptor_{nullptr};
+
+  // the Code attribute body, a view into the class file bytes that decode() reads once and
+  // then lets go of (see Klass::releaseClassBytes)
+  mutable std::span<const U1>   code_attribute_;
+  mutable ExceptionHandlerTable exception_table_;
 
-  AccessFlags<flags::Method> access_flags_;
-  std::string                name_;
-  std::string                descriptor_;
+  // one per code byte, allocated on the first implicit exception the method raises: most
+  // methods never raise one
+  std::atomic<std::atomic<U4>*> implicit_exception_counts_{nullptr};
 
-  Klass* owner_klass_{nullptr};
+  // see purity.h, computed on demand
+  // both published with release stores, as other threads may run the method meanwhile
+  enum class Purity : U1 { kUnknown, kPure, kImpure };
+  std::atomic<Purity>     purity_{Purity::kUnknown};
+  std::atomic<MemoCache*> memo_cache_{nullptr};  // created by getMemoCache(), in the metaspace
 
-  U2              max_stack_{};
-  U2              max_locals_{};
-  std::vector<U1> code_;
+  // Written on every invocation and loop iteration when profiling. On a line of their own, the
+  // last of the method, so that these stores do not invalidate the hot line other threads
+  // running the method read.
+  struct Profile {
+    U4 invocation_count{0};
+    U4 backedge_count{0};
+  };
+  alignas(kCacheLineSize) Profile profile_;
 
   // NativeMethod native_function_;
 
   friend class Klass;
+  friend bool       isPure(Method* method);
+  friend MemoCache* getMemoCache(Method* method);
 };
 
 }  // namespace jvm::runtime
\ No newline at end of file
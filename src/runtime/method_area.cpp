@@ -1,21 +1,130 @@
 #include "method_area.h"
 
+#include <cstdint>
+
+#include "symbol.h"
+
 namespace jvm::runtime {
 
-void MethodArea::addClass(ClassIdentifier identifier, ClassData class_data) {
-  classes_.emplace(std::move(identifier), std::move(class_data));
+MethodArea::KeyView MethodArea::keyOf(const class_loader::ClassLoader* loader,
+                                      std::string_view name) {
+  // std::hash of a pointer is the identity, so the pair is combined and then run through the
+  // MurmurHash3 finalizer, which spreads every input bit over the shard and bucket bits
+  U8 hash = std::hash<std::string_view>{}(name);
+  hash ^= reinterpret_cast<std::uintptr_t>(loader) + 0x9E3779B97F4A7C15 + (hash << 6) +  // NOLINT
+          (hash >> 2);
+  hash ^= hash >> 33;
+  hash *= 0xFF51AFD7ED558CCD;
+  hash ^= hash >> 33;
+  hash *= 0xC4CEB9FE1A85EC53;
+  hash ^= hash >> 33;
+  return {.loader = loader, .name = name, .hash = hash};
+}
+
+bool MethodArea::addClass(ClassIdentifier identifier, ClassData class_data) {
+  auto  view  = keyOf(identifier.first, identifier.second);
+  auto* klass = class_data.first;
+  Key   key{.loader = view.loader, .name = std::move(identifier.second), .hash = view.hash};
+
+  auto& shard = shardOf(key.hash);
+  {
+    std::unique_lock lock(shard.mutex);
+    if (!shard.classes.try_emplace(std::move(key), std::move(class_data)).second) {
+      return false;
+    }
+  }
+  std::lock_guard lock(loaders_mutex_);
+  loaders_[view.loader].push_back(klass);
+  return true;
+}
+
+void MethodArea::removeClass(const class_loader::ClassLoader* loader, std::string_view name) {
+  auto      key   = keyOf(loader, name);
+  auto&     shard = shardOf(key.hash);
+  ClassData removed;
+  {
+    std::unique_lock lock(shard.mutex);
+    auto             it = shard.classes.find(key);
+    if (it == shard.classes.end()) {
+      return;
+    }
+    removed = std::move(it->second);
+    shard.classes.erase(it);
+  }
+  {
+    std::lock_guard lock(loaders_mutex_);
+    if (auto it = loaders_.find(loader); it != loaders_.end()) {
+      std::erase(it->second, removed.first);
+    }
+  }
+  // the class file is destroyed here, after the locks are released
+}
+
+Klass* MethodArea::getClass(const class_loader::ClassLoader* loader,
+                            std::string_view name) const {
+  auto             key   = keyOf(loader, name);
+  const auto&      shard = shardOf(key.hash);
+  std::shared_lock lock(shard.mutex);
+  auto             it = shard.classes.find(key);
+  return it == shard.classes.end() ? nullptr : it->second.first;
+}
+
+bool MethodArea::hasClass(const class_loader::ClassLoader* loader, std::string_view name) const {
+  return getClass(loader, name) != nullptr;
 }
 
-Klass* MethodArea::getClass(const ClassIdentifier& identifier) {
-  auto it = classes_.find(identifier);
-  if (it != classes_.end()) {
-    return it->second.first.get();
+std::vector<Klass*> MethodArea::getClasses(const class_loader::ClassLoader* loader) const {
+  std::lock_guard lock(loaders_mutex_);
+  auto            it = loaders_.find(loader);
+  return it == loaders_.end() ? std::vector<Klass*>{} : it->second;
+}
+
+size_t MethodArea::unloadClasses(const class_loader::ClassLoader* loader) {
+  {
+    std::lock_guard lock(loaders_mutex_);
+    if (loaders_.erase(loader) == 0) {
+      return 0;
+    }
   }
-  return nullptr;
+
+  // unloading is rare, so the shards are scanned rather than indexed by loader; the class
+  // files are destroyed after the locks are released
+  std::vector<ClassData> unloaded;
+  for (auto& shard : shards_) {
+    std::unique_lock lock(shard.mutex);
+    for (auto it = shard.classes.begin(); it != shard.classes.end();) {
+      if (it->first.loader == loader) {
+        unloaded.push_back(std::move(it->second));
+        it = shard.classes.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  size_t count = unloaded.size();
+  unloaded.clear();
+  // the symbols only these class files referred to; the names held by the classes themselves
+  // go with the loader's metaspace, and with the next unloading
+  SymbolTable::getInstance().purge();
+  return count;
 }
 
-bool MethodArea::hasClass(const ClassIdentifier& identifier) const {
-  return classes_.find(identifier) != classes_.end();
+size_t MethodArea::size() const {
+  size_t count = 0;
+  for (const auto& shard : shards_) {
+    std::shared_lock lock(shard.mutex);
+    count += shard.classes.size();
+  }
+  return count;
+}
+
+void MethodArea::reset() {
+  for (auto& shard : shards_) {
+    std::unique_lock lock(shard.mutex);
+    shard.classes.clear();
+  }
+  std::lock_guard lock(loaders_mutex_);
+  loaders_.clear();
 }
 
-}  // namespace jvm::runtime
\ No newline at end of file
+}  // namespace jvm::runtime
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <array>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
+#include <string_view>
 #include <unordered_map>
+#include <vector>
 
 #include "class_loader/class_file.h"
 #include "class_loader/class_loader.h"
@@ -15,17 +20,17 @@
 
 namespace jvm::runtime {
 
-struct ClassIdentifierHash {
-  std::size_t operator()(const std::pair<class_loader::ClassLoader*, std::string>& p) const {
-    return std::hash<void*>{}(p.first) ^ (std::hash<std::string>{}(p.second) << 1U);
-  }
-};
-
-// Singleton
+// Singleton holding every class a class loader defined, keyed by the defining loader and the
+// binary name, until that loader is destroyed and unloads them. The table is split into
+// kShardCount shards by a well-mixed hash of the pair, each behind its own reader-writer lock,
+// so threads defining or looking up different classes rarely meet on a lock. Lookups take the
+// name as a std::string_view and allocate nothing. The classes of each loader are also listed
+// on their own, so one loader's classes can be walked without scanning every shard.
 class MethodArea {
  public:
   using ClassIdentifier = std::pair<class_loader::ClassLoader*, std::string>;
-  using ClassData = std::pair<std::unique_ptr<Klass>, std::unique_ptr<class_loader::ClassFile>>;
+  // The Klass lives in its loader's metaspace; the class file is owned here
+  using ClassData = std::pair<Klass*, std::unique_ptr<class_loader::ClassFile>>;
 
   // Meyer's singleton
   static MethodArea& getInstance() {
@@ -33,10 +38,44 @@ class MethodArea {
     return instance;
   }
 
-  void   addClass(ClassIdentifier identifier, ClassData class_data);
-  Klass* getClass(const ClassIdentifier& identifier);
-  bool   hasClass(const ClassIdentifier& identifier) const;
-  void   reset() { classes_.clear(); }
+  /**
+   * @brief Adds a class
+   * @return false if the same loader already defined a class under the same name; that one is
+   * kept, and `class_data` is destroyed with its class file
+   */
+  bool   addClass(ClassIdentifier identifier, ClassData class_data);
+  /**
+   * @brief Removes a class its loader failed to prepare and destroys its class file, so that
+   * the name may be defined again; nothing may refer to the class any more
+   */
+  void   removeClass(const class_loader::ClassLoader* loader, std::string_view name);
+  Klass* getClass(const class_loader::ClassLoader* loader, std::string_view name) const;
+  bool   hasClass(const class_loader::ClassLoader* loader, std::string_view name) const;
+  Klass* getClass(const ClassIdentifier& identifier) const {
+    return getClass(identifier.first, identifier.second);
+  }
+  bool hasClass(const ClassIdentifier& identifier) const {
+    return hasClass(identifier.first, identifier.second);
+  }
+
+  /**
+   * @brief The classes `loader` defined, in the order it defined them
+   */
+  std::vector<Klass*> getClasses(const class_loader::ClassLoader* loader) const;
+
+  /**
+   * @brief Removes every class `loader` defined and destroys their class files; the loader
+   * calls it from its destructor, then frees its metaspace with the classes themselves
+   * @return The number of classes unloaded
+   *
+   * Nothing else may refer to these classes any more: no frame runs their code and no object
+   * of theirs is reachable. Classes of other loaders only refer to them through delegation, so
+   * loaders that delegate to `loader` must be destroyed first.
+   */
+  size_t unloadClasses(const class_loader::ClassLoader* loader);
+
+  size_t size() const;
+  void   reset();
 
   // modernize-use-equals-delete
   // Implements rule 12.5.1 to explicitly default or delete special member functions
@@ -49,7 +88,48 @@ class MethodArea {
   MethodArea()  = default;
   ~MethodArea() = default;
 
-  std::unordered_map<ClassIdentifier, ClassData, ClassIdentifierHash> classes_;
+  static constexpr size_t kShardCount = 16;
+
+  // Stored keys own the name; lookups build a Key viewing the caller's. The hash is computed
+  // once per lookup and kept with the stored key, so neither probing nor rehashing rehashes.
+  struct Key {
+    const class_loader::ClassLoader* loader;
+    std::string                      name;
+    size_t                           hash;
+  };
+  struct KeyView {
+    const class_loader::ClassLoader* loader;
+    std::string_view                 name;
+    size_t                           hash;
+  };
+  struct KeyHash {
+    using is_transparent = void;
+    size_t operator()(const Key& key) const { return key.hash; }
+    size_t operator()(const KeyView& key) const { return key.hash; }
+  };
+  struct KeyEqual {
+    using is_transparent = void;
+    template <typename A, typename B>
+    bool operator()(const A& a, const B& b) const {
+      return a.loader == b.loader && std::string_view(a.name) == std::string_view(b.name);
+    }
+  };
+
+  struct Shard {
+    mutable std::shared_mutex                             mutex;
+    std::unordered_map<Key, ClassData, KeyHash, KeyEqual> classes;
+  };
+
+  static KeyView keyOf(const class_loader::ClassLoader* loader, std::string_view name);
+
+  // the low bits of the hash pick the bucket within a shard, the high bits the shard
+  Shard&       shardOf(size_t hash) { return shards_[(hash >> 56) % kShardCount]; }
+  const Shard& shardOf(size_t hash) const { return shards_[(hash >> 56) % kShardCount]; }
+
+  std::array<Shard, kShardCount> shards_;
+
+  mutable std::mutex                                                        loaders_mutex_;
+  std::unordered_map<const class_loader::ClassLoader*, std::vector<Klass*>> loaders_;
 };
 
-}  // namespace jvm::runtime
\ No newline at end of file
+}  // namespace jvm::runtime
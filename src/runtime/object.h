@@ -0,0 +1,23 @@
+#pragma once
+
+namespace jvm::runtime {
+
+class Klass;
+
+// Header shared by every heap object; a non-null Jref always points to an Object.
+class Object {
+ public:
+  explicit Object(Klass* klass) : klass_(klass) {}
+  Object(const Object&)            = delete;
+  Object(Object&&)                 = delete;
+  Object& operator=(const Object&) = delete;
+  Object& operator=(Object&&)      = delete;
+  virtual ~Object()                = default;
+
+  Klass* getKlass() const { return klass_; }
+
+ private:
+  Klass* klass_;
+};
+
+}  // namespace jvm::runtime
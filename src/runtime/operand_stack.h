@@ -11,6 +11,8 @@
 #pragma once
 
 #include <stack>
+#include <stdexcept>
+#include <utility>
 
 #include "runtime/slot.h"
 
@@ -25,52 +27,78 @@ class OperandStack {
   OperandStack& operator=(OperandStack&&)      = default;
   ~OperandStack()                              = default;
 
-  U2 getSize() const { return stack_.size(); }
+  U2   getSize() const { return stack_.size(); }
+  void clear() { stack_ = {}; }
+
+  // Calls `fn(const Slot&)` for every slot, bottom first; for scanning, not on any hot path
+  template <typename Fn>
+  void forEachSlot(Fn&& fn) const {
+    // std::stack only exposes its container to derived classes
+    struct Container : std::stack<Slot> {
+      static const container_type& of(const std::stack<Slot>& stack) {
+        return stack.*&Container::c;
+      }
+    };
+    for (const auto& slot : Container::of(stack_)) {
+      std::forward<Fn>(fn)(slot);
+    }
+  }
 
   void pushSlot(Slot value) { stack_.push(value); }
+  // kChecked = false skips the underflow check, see engine::Fast
+  template <bool kChecked = true>
   Slot popSlot() {
-    if (stack_.empty()) {
-      throw std::runtime_error("Operand stack is empty");
+    if constexpr (kChecked) {
+      if (stack_.empty()) {
+        throw std::runtime_error("Operand stack is empty");
+      }
     }
     auto value = stack_.top();
     stack_.pop();
     return value;
   }
 
-  void   pushInt(Jint value) { stack_.push({.i = value}); }
-  Jint   popInt() { return popSlot().i; }
-  void   pushFloat(Jfloat value) { stack_.push({.f = value}); }
-  Jfloat popFloat() { return popSlot().f; }
-  void   pushLong(Jlong value) {
+  void pushInt(Jint value) { stack_.push({.i = value}); }
+  template <bool kChecked = true>
+  Jint popInt() {
+    return popSlot<kChecked>().i;
+  }
+  void pushFloat(Jfloat value) { stack_.push({.f = value}); }
+  template <bool kChecked = true>
+  Jfloat popFloat() {
+    return popSlot<kChecked>().f;
+  }
+  void pushLong(Jlong value) {
     // Long values occupy 2 slots in the operand stack
-    // Push a placeholder first (second slot), then push the actual value (first slot)
-    // When popped, the value is on top, then the placeholder
-    stack_.push({.i = 0});      // Push a placeholder slot first (second slot)
-    stack_.push({.l = value});  // Push the actual value (first slot, on top)
+    // Push the actual value first (first slot), then a placeholder (second slot), so that an
+    // invoke copying the argument slots in order puts the value at the lower local index
+    stack_.push({.l = value});  // Push the actual value (first slot)
+    stack_.push({.l = 0});      // Push a placeholder slot (second slot, on top)
   }
+  template <bool kChecked = true>
   Jlong popLong() {
     // Long values occupy 2 slots, pop both
-    // The value is on top, then the placeholder
-    Jlong value = popSlot().l;  // Pop the first slot with the actual value
-    popSlot();                  // Pop the second (placeholder) slot
-    return value;
+    // The placeholder is on top, then the value
+    popSlot<kChecked>();           // Pop the second (placeholder) slot
+    return popSlot<kChecked>().l;  // Pop the first slot with the actual value
   }
   void pushDouble(Jdouble value) {
-    // Double values occupy 2 slots in the operand stack
-    // Push a placeholder first (second slot), then push the actual value (first slot)
-    // When popped, the value is on top, then the placeholder
-    stack_.push({.i = 0});      // Push a placeholder slot first (second slot)
-    stack_.push({.d = value});  // Push the actual value (first slot, on top)
+    // Double values occupy 2 slots in the operand stack, laid out like longs
+    stack_.push({.d = value});  // Push the actual value (first slot)
+    stack_.push({.l = 0});      // Push a placeholder slot (second slot, on top)
   }
+  template <bool kChecked = true>
   Jdouble popDouble() {
     // Double values occupy 2 slots, pop both
-    // The value is on top, then the placeholder
-    Jdouble value = popSlot().d;  // Pop the first slot with the actual value
-    popSlot();                    // Pop the second (placeholder) slot
-    return value;
+    // The placeholder is on top, then the value
+    popSlot<kChecked>();           // Pop the second (placeholder) slot
+    return popSlot<kChecked>().d;  // Pop the first slot with the actual value
   }
   void pushRef(Jref value) { stack_.push({.r = value}); }
-  Jref popRef() { return popSlot().r; }
+  template <bool kChecked = true>
+  Jref popRef() {
+    return popSlot<kChecked>().r;
+  }
 
  private:
   std::stack<Slot> stack_;
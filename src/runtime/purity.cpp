@@ -0,0 +1,125 @@
+#include "purity.h"
+
+#include <atomic>
+#include <exception>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "engine/bytecode_reader.h"
+#include "engine/opcode.h"
+#include "klass.h"
+#include "method.h"
+
+namespace jvm::runtime {
+
+namespace {
+
+// Instructions whose effect only depends on the operand stack and the locals. Everything
+// that touches the heap or statics, allocates, synchronizes or makes a non-static call is
+// left out; INVOKESTATIC is allowed here and its target checked separately.
+bool isPureInstruction(U1 opcode) {
+  using namespace engine;  // NOLINT(google-build-using-namespace)
+  if (opcode <= LDC2_W) {
+    return true;  // constants
+  }
+  if ((opcode >= ILOAD && opcode <= ALOAD_3) || (opcode >= ISTORE && opcode <= ASTORE_3)) {
+    return true;  // locals, array loads and stores excluded
+  }
+  if (opcode >= POP && opcode <= GOTO) {
+    return true;  // stack, arithmetic, conversions, comparisons and branches
+  }
+  switch (opcode) {
+    case TABLESWITCH:
+    case LOOKUPSWITCH:
+    case IRETURN:
+    case LRETURN:
+    case FRETURN:
+    case DRETURN:
+    case INVOKESTATIC:
+    case WIDE:
+    case GOTO_W:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool hasPrimitiveSignature(std::string_view descriptor) {
+  return descriptor.find_first_of("L[") == std::string_view::npos && !descriptor.ends_with(")V");
+}
+
+// Checks `method` on its own and appends the targets of its INVOKESTATICs to `callees`
+bool isLocallyPure(Method* method, std::vector<Method*>& callees) {
+  if (!method->isStatic() || method->isNative() || method->isSynchronized() ||
+      !hasPrimitiveSignature(method->getDescriptor())) {
+    return false;
+  }
+  const auto& code = method->getCode();
+  for (size_t pc = 0; pc < code.size(); pc += engine::instructionLength(code, pc)) {
+    auto opcode = engine::unquickened(code[pc]);
+    if (!isPureInstruction(opcode)) {
+      return false;
+    }
+    if (opcode == engine::INVOKESTATIC) {
+      auto    index  = static_cast<U2>(code[pc + 1] << 8U | code[pc + 2]);
+      auto&   rt_cp  = method->getOwnerKlass()->getRuntimeConstantPool();
+      Method* callee = nullptr;
+      try {
+        callee = rt_cp.resolveMethod(index);
+      } catch (const std::exception&) {
+        return false;  // leave the error to the call, if it is ever executed
+      }
+      if (callee == nullptr) {
+        return false;
+      }
+      callees.push_back(callee);
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+bool isPure(Method* method) {
+  // threads that get here at once all reach the same answer and store it
+  if (auto purity = method->purity_.load(std::memory_order_acquire);
+      purity != Method::Purity::kUnknown) {
+    return purity == Method::Purity::kPure;
+  }
+
+  // every method reachable through INVOKESTATIC must be locally pure; cycles (recursion)
+  // are fine since each method is visited once
+  std::vector<Method*>        worklist{method};
+  std::unordered_set<Method*> visited{method};
+  std::vector<Method*>        callees;
+  bool                        pure = true;
+  while (pure && !worklist.empty()) {
+    auto* current = worklist.back();
+    worklist.pop_back();
+    if (auto purity = current->purity_.load(std::memory_order_acquire);
+        purity != Method::Purity::kUnknown) {
+      pure = purity == Method::Purity::kPure;
+      continue;
+    }
+    callees.clear();
+    pure = isLocallyPure(current, callees);
+    for (auto* callee : callees) {
+      if (visited.insert(callee).second) {
+        worklist.push_back(callee);
+      }
+    }
+  }
+
+  if (pure) {
+    // a visited method only reaches methods visited here, so it is pure as well
+    for (auto* visited_method : visited) {
+      visited_method->purity_.store(Method::Purity::kPure, std::memory_order_release);
+    }
+  } else {
+    method->purity_.store(Method::Purity::kImpure, std::memory_order_release);
+  }
+  return pure;
+}
+
+}  // namespace jvm::runtime
@@ -0,0 +1,18 @@
+#pragma once
+
+namespace jvm::runtime {
+
+class Method;
+
+/**
+ * @brief Whether `method` is pure: its result depends on nothing but its arguments and it has
+ * no side effects, so calls with equal arguments may share one result
+ *
+ * A pure method is static, not synchronized or native, takes and returns primitives only,
+ * and uses no instruction that reads or writes the heap or statics, allocates, or invokes
+ * anything but other pure static methods. The answer is computed on first query, resolving
+ * the static call graph reachable from `method`, and cached on the Method.
+ */
+bool isPure(Method* method);
+
+}  // namespace jvm::runtime
@@ -0,0 +1,32 @@
+#include "safepoint.h"
+
+#include <utility>
+
+namespace jvm::runtime {
+
+void Safepoint::request(std::function<void()> operation) {
+  std::lock_guard lock(mutex_);
+  operations_.push_back(std::move(operation));
+  requested_.store(true, std::memory_order_release);
+}
+
+void Safepoint::runPending() {
+  std::vector<std::function<void()>> operations;
+  {
+    std::lock_guard lock(mutex_);
+    operations.swap(operations_);
+    requested_.store(false, std::memory_order_relaxed);
+  }
+  // run outside the lock so that an operation may request another one
+  for (auto& operation : operations) {
+    operation();
+  }
+}
+
+void Safepoint::reset() {
+  std::lock_guard lock(mutex_);
+  operations_.clear();
+  requested_.store(false, std::memory_order_relaxed);
+}
+
+}  // namespace jvm::runtime
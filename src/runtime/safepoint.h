@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+namespace jvm::runtime {
+
+// VM operations deferred to the next safepoint poll. An operation queued with request() runs
+// once, on whichever thread polls first; interpreters poll at method entry and on loop
+// back-edges. This is not a rendezvous: the other threads are not stopped and keep running
+// bytecode meanwhile, so an operation must not rely on them being parked. The poll is a single
+// relaxed load on the fast path.
+class Safepoint {
+ public:
+  Safepoint(const Safepoint&)            = delete;
+  Safepoint(Safepoint&&)                 = delete;
+  Safepoint& operator=(const Safepoint&) = delete;
+  Safepoint& operator=(Safepoint&&)      = delete;
+  ~Safepoint()                           = default;
+
+  // Meyer's singleton
+  static Safepoint& getInstance() {
+    static Safepoint instance;
+    return instance;
+  }
+
+  /**
+   * @brief Queues a VM operation to run at the next safepoint poll, by any thread
+   */
+  void request(std::function<void()> operation);
+
+  bool isRequested() const { return requested_.load(std::memory_order_relaxed); }
+
+  void poll() {
+    if (isRequested()) [[unlikely]] {
+      runPending();
+    }
+  }
+
+  /**
+   * @brief Runs the pending VM operations on the calling thread; called from poll() once one is
+   * requested
+   */
+  void runPending();
+
+  void reset();
+
+ private:
+  Safepoint() = default;
+
+  std::atomic<bool>                  requested_{false};
+  std::mutex                         mutex_;
+  std::vector<std::function<void()>> operations_;
+};
+
+}  // namespace jvm::runtime
@@ -0,0 +1,139 @@
+#include "stack.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <utility>
+
+#include "implicit_checks.h"
+#include "vm_options.h"
+
+namespace jvm::runtime {
+
+namespace {
+
+constexpr size_t kYellowZonePages = 2;
+constexpr size_t kRedZonePages    = 1;
+
+size_t pageSize() {
+  static const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  return page_size;
+}
+
+}  // namespace
+
+Stack::Stack() : Stack(VMOptions::getInstance().thread_stack_size) {}
+
+Stack::Stack(size_t size) {
+  installImplicitCheckHandlers();
+
+  size_t page_size   = pageSize();
+  size_t usable_size = (size + page_size - 1) / page_size * page_size;
+  size_t guard_size  = (kYellowZonePages + kRedZonePages) * page_size;
+  mapping_size_      = usable_size + guard_size;
+
+  // reserve the whole region inaccessible, then open the usable part
+  void* mapping = mmap(nullptr, mapping_size_, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (mapping == MAP_FAILED) {
+    throw std::bad_alloc();
+  }
+  mapping_ = static_cast<std::byte*>(mapping);
+  if (mprotect(mapping_, usable_size, PROT_READ | PROT_WRITE) != 0) {
+    munmap(mapping_, mapping_size_);
+    throw std::bad_alloc();
+  }
+  yellow_zone_ = mapping_ + usable_size;
+  base_        = reinterpret_cast<Frame*>(mapping_);
+  top_         = base_;
+}
+
+Stack::Stack(Stack&& other) noexcept
+  : mapping_(std::exchange(other.mapping_, nullptr)),
+    mapping_size_(std::exchange(other.mapping_size_, 0)),
+    yellow_zone_(std::exchange(other.yellow_zone_, nullptr)),
+    yellow_zone_open_(std::exchange(other.yellow_zone_open_, false)),
+    base_(std::exchange(other.base_, nullptr)),
+    top_(std::exchange(other.top_, nullptr)) {}
+
+Stack& Stack::operator=(Stack&& other) noexcept {
+  if (this != &other) {
+    release();
+    mapping_          = std::exchange(other.mapping_, nullptr);
+    mapping_size_     = std::exchange(other.mapping_size_, 0);
+    yellow_zone_      = std::exchange(other.yellow_zone_, nullptr);
+    yellow_zone_open_ = std::exchange(other.yellow_zone_open_, false);
+    base_             = std::exchange(other.base_, nullptr);
+    top_              = std::exchange(other.top_, nullptr);
+  }
+  return *this;
+}
+
+Stack::~Stack() { release(); }
+
+void Stack::release() {
+  while (!empty()) {
+    pop();
+  }
+  if (mapping_ != nullptr) {
+    munmap(mapping_, mapping_size_);
+    mapping_ = nullptr;
+  }
+}
+
+bool Stack::push(Frame&& frame) {
+  Frame* slot = top_;
+  auto*  last = reinterpret_cast<std::byte*>(slot + 1) - 1;
+  // probe the last byte of the slot: slots are filled upwards, so it is the first one to reach
+  // the guard zone
+#if JVM_IMPLICIT_CHECKS
+  bool fits = stackBang(last);
+#else
+  bool fits = last < (yellow_zone_open_ ? yellow_zone_ + kYellowZonePages * pageSize()
+                                        : yellow_zone_);
+#endif
+  if (!fits) [[unlikely]] {
+    return overflow();
+  }
+  new (slot) Frame(std::move(frame));
+  top_++;
+  return true;
+}
+
+bool Stack::overflow() {
+  if (yellow_zone_open_) {
+    // overflowed again while handling a StackOverflowError: the red zone was hit
+    std::fputs("Fatal error: Java thread stack overflowed into its red zone\n", stderr);
+    std::abort();
+  }
+  mprotect(yellow_zone_, kYellowZonePages * pageSize(), PROT_READ | PROT_WRITE);
+  yellow_zone_open_ = true;
+  return false;
+}
+
+void Stack::reguard() {
+  if (yellow_zone_open_ && reinterpret_cast<std::byte*>(top_) <= yellow_zone_) {
+    mprotect(yellow_zone_, kYellowZonePages * pageSize(), PROT_NONE);
+    yellow_zone_open_ = false;
+  }
+}
+
+void Stack::pop() {
+  if (empty()) {
+    throw std::runtime_error("Stack is empty");
+  }
+  top_--;
+  top_->~Frame();
+}
+
+Frame& Stack::top() {
+  if (empty()) {
+    throw std::runtime_error("Stack is empty");
+  }
+  return top_[-1];
+}
+
+}  // namespace jvm::runtime
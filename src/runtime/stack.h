@@ -1,37 +1,69 @@
 #pragma once
 
-#include <stack>
+#include <cstddef>
 
 #include "frame.h"
 
 namespace jvm::runtime {
 
+/**
+ * @brief A Java thread stack
+ *
+ * Frames live in one mmap'd region sized by -Xss and followed by PROT_NONE guard zones, so
+ * pushing a frame costs no depth check: the store into the new slot faults once the usable
+ * area is exhausted.
+ *
+ *   [ usable frames ... ][ yellow zone ][ red zone ]
+ *
+ * Reaching the yellow zone makes push() fail, which the interpreter turns into a
+ * StackOverflowError; the yellow zone is opened meanwhile so that the error can be
+ * dispatched and handled, and closed again by reguard() once the stack has unwound. Reaching
+ * the red zone, i.e. overflowing again while the yellow zone is open, is fatal.
+ *
+ * Only the Frame objects live in the mapping. Their local variables and operand stacks are on
+ * the heap, so -Xss limits the depth of the stack rather than all of its memory.
+ */
 class Stack {
  public:
-  Stack()                        = default;
-  Stack(const Stack&)            = delete;
-  Stack(Stack&&)                 = default;
+  Stack();  // sized by VMOptions::thread_stack_size
+  explicit Stack(size_t size);
+  Stack(const Stack&) = delete;
+  Stack(Stack&& other) noexcept;
   Stack& operator=(const Stack&) = delete;
-  Stack& operator=(Stack&&)      = default;
-  ~Stack()                       = default;
-
-  void push(Frame&& frame) { frames_.push(std::move(frame)); }
-  void pop() {
-    if (frames_.empty()) {
-      throw std::runtime_error("Stack is empty");
-    }
-    frames_.pop();
-  }
-  Frame& top() {
-    if (frames_.empty()) {
-      throw std::runtime_error("Stack is empty");
-    }
-    return frames_.top();
-  }
-  bool empty() { return frames_.empty(); }
+  Stack& operator=(Stack&& other) noexcept;
+  ~Stack();
+
+  /**
+   * @brief Pushes a frame
+   * @return false if the stack overflowed into the yellow zone, in which case nothing is pushed
+   */
+  bool   push(Frame&& frame);
+  void   pop();
+  Frame& top();
+  bool   empty() const { return top_ == base_; }
+  size_t size() const { return top_ - base_; }
+
+  // frames from the bottom (oldest) to the top (current)
+  Frame* begin() { return base_; }
+  Frame* end() { return top_; }
+
+  /**
+   * @brief Closes the yellow zone again if it was opened by an overflow and the frames that
+   * used it are gone
+   */
+  void reguard();
 
  private:
-  std::stack<Frame> frames_;
+  bool overflow();
+  void release();
+
+  std::byte* mapping_{nullptr};
+  size_t     mapping_size_{0};
+  std::byte* yellow_zone_{nullptr};
+  bool       yellow_zone_open_{false};
+
+  Frame* base_{nullptr};
+  Frame* top_{nullptr};
 };
 
-}  // namespace jvm::runtime
\ No newline at end of file
+}  // namespace jvm::runtime
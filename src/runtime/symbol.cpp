@@ -0,0 +1,128 @@
+#include "symbol.h"
+
+#include <algorithm>
+#include <cstring>
+#include <mutex>
+#include <new>
+
+namespace jvm::runtime {
+
+namespace {
+
+// The header, then the characters and a terminating NUL, rounded up for the next header
+size_t storageSize(size_t length) {
+  size_t size = sizeof(Symbol) + length + 1;
+  return (size + alignof(Symbol) - 1) & ~(alignof(Symbol) - 1);
+}
+
+}  // namespace
+
+Symbol* SymbolTable::Shard::allocate(std::string_view string, size_t hash) {
+  size_t     size    = storageSize(string.size());
+  std::byte* storage = nullptr;
+  if (auto it = free_storage.find(size); it != free_storage.end() && !it->second.empty()) {
+    storage = it->second.back();
+    it->second.pop_back();
+  } else {
+    storage = bump(size);
+  }
+
+  auto* chars = reinterpret_cast<char*>(storage + sizeof(Symbol));  // NOLINT
+  std::memcpy(chars, string.data(), string.size());
+  chars[string.size()] = '\0';
+  return new (storage) Symbol(chars, static_cast<U4>(string.size()), hash);
+}
+
+std::byte* SymbolTable::Shard::bump(size_t size) {
+  if (size > remaining) {
+    size_t chunk_size = std::max(kChunkSize, size);
+    chunks.push_back(std::make_unique<std::byte[]>(chunk_size));  // NOLINT(*-avoid-c-arrays)
+    cursor    = chunks.back().get();
+    remaining = chunk_size;
+    arena_bytes += chunk_size;
+  }
+  auto* storage = cursor;
+  cursor += size;
+  remaining -= size;
+  return storage;
+}
+
+const Symbol* SymbolTable::intern(std::string_view string) {
+  auto  hash  = std::hash<std::string_view>{}(string);
+  auto& shard = shardOf(hash);
+  {
+    // purge() takes the exclusive lock, so a symbol found here is not reclaimed under us
+    std::shared_lock lock(shard.mutex);
+    if (auto it = shard.symbols.find(string); it != shard.symbols.end()) {
+      retain(it->second);
+      return it->second;
+    }
+  }
+
+  std::unique_lock lock(shard.mutex);
+  // another thread may have interned it between the two locks
+  if (auto it = shard.symbols.find(string); it != shard.symbols.end()) {
+    retain(it->second);
+    return it->second;
+  }
+  auto* symbol = shard.allocate(string, hash);
+  retain(symbol);
+  shard.symbols.emplace(symbol->view(), symbol);
+  return symbol;
+}
+
+void SymbolTable::retain(const Symbol* symbol) {
+  symbol->references_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void SymbolTable::release(const Symbol* symbol) {
+  symbol->references_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+size_t SymbolTable::purge() {
+  size_t purged = 0;
+  for (auto& shard : shards_) {
+    std::unique_lock lock(shard.mutex);
+    for (auto it = shard.symbols.begin(); it != shard.symbols.end();) {
+      auto* symbol = it->second;
+      if (symbol->references_.load(std::memory_order_relaxed) != 0) {
+        ++it;
+        continue;
+      }
+      it          = shard.symbols.erase(it);
+      size_t size = storageSize(symbol->size());
+      symbol->~Symbol();
+      shard.free_storage[size].push_back(reinterpret_cast<std::byte*>(symbol));  // NOLINT
+      purged++;
+    }
+  }
+  return purged;
+}
+
+const Symbol* SymbolTable::lookup(std::string_view string) const {
+  auto             hash  = std::hash<std::string_view>{}(string);
+  const auto&      shard = shardOf(hash);
+  std::shared_lock lock(shard.mutex);
+  auto             it = shard.symbols.find(string);
+  return it == shard.symbols.end() ? nullptr : it->second;
+}
+
+size_t SymbolTable::size() const {
+  size_t count = 0;
+  for (const auto& shard : shards_) {
+    std::shared_lock lock(shard.mutex);
+    count += shard.symbols.size();
+  }
+  return count;
+}
+
+size_t SymbolTable::getArenaBytes() const {
+  size_t bytes = 0;
+  for (const auto& shard : shards_) {
+    std::shared_lock lock(shard.mutex);
+    bytes += shard.arena_bytes;
+  }
+  return bytes;
+}
+
+}  // namespace jvm::runtime
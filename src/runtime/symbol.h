@@ -0,0 +1,125 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "common/types.h"
+
+namespace jvm::runtime {
+
+// An interned Modified UTF-8 string: a class, field or method name, a descriptor, or any other
+// constant pool Utf8 entry. The SymbolTable holds exactly one Symbol per distinct string, so
+// two symbols are equal iff they are the same object and comparing them is a pointer
+// comparison. Symbols are immutable and reference counted: the constant pools, classes and
+// archives that refer to one hold a reference, and the table reclaims it once none is left.
+class Symbol {
+ public:
+  Symbol(const Symbol&)            = delete;
+  Symbol(Symbol&&)                 = delete;
+  Symbol& operator=(const Symbol&) = delete;
+  Symbol& operator=(Symbol&&)      = delete;
+  ~Symbol()                        = default;
+
+  std::string_view view() const { return {data_, length_}; }
+  std::string      str() const { return std::string(view()); }
+  const char*      data() const { return data_; }  // NUL-terminated
+  size_t           size() const { return length_; }
+  size_t           hash() const { return hash_; }
+
+ private:
+  Symbol(const char* data, U4 length, size_t hash) : data_(data), length_(length), hash_(hash) {}
+
+  const char*             data_;
+  U4                      length_;
+  mutable std::atomic<U4> references_{0};
+  size_t                  hash_;
+
+  friend class SymbolTable;
+};
+
+// Process-wide table of interned symbols. Lookups take a shared lock on one of kShardCount
+// shards chosen by the string's hash, so concurrent class loading rarely contends; only
+// inserting a new symbol takes the shard's exclusive lock. Symbol storage is bump-allocated
+// from per-shard arena chunks. purge() drops the symbols nothing refers to any more and keeps
+// their storage for new symbols of the same rounded size, so loading and unloading classes with
+// fresh names does not grow the arena beyond what the live symbols once needed.
+class SymbolTable {
+ public:
+  SymbolTable(const SymbolTable&)            = delete;
+  SymbolTable(SymbolTable&&)                 = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+  SymbolTable& operator=(SymbolTable&&)      = delete;
+  ~SymbolTable()                             = default;
+
+  // Meyer's singleton
+  static SymbolTable& getInstance() {
+    static SymbolTable instance;
+    return instance;
+  }
+
+  /**
+   * @brief Returns the symbol for `string`, creating it on first use, with a reference the
+   * caller owns: it gives it back with release(), or keeps the symbol for good
+   */
+  const Symbol* intern(std::string_view string);
+
+  /**
+   * @brief Adds a reference to, and gives back a reference to, a symbol; a symbol whose last
+   * reference is gone stays in the table, and may be interned again, until the next purge()
+   */
+  static void retain(const Symbol* symbol);
+  static void release(const Symbol* symbol);
+
+  /**
+   * @brief Reclaims the symbols without references; class unloading calls it
+   * @return The number of symbols reclaimed
+   */
+  size_t purge();
+
+  /**
+   * @brief Returns the symbol for `string` if it was interned before, nullptr otherwise
+   *
+   * Lookups by name from outside the class file (e.g. a name given by the embedder) use this:
+   * a string that was never interned cannot name any loaded class or member. It adds no
+   * reference, so the result is only meaningful while a loaded class refers to the symbol.
+   */
+  const Symbol* lookup(std::string_view string) const;
+
+  size_t size() const;
+  // Bytes of arena memory reserved for symbols
+  size_t getArenaBytes() const;
+
+ private:
+  SymbolTable() = default;
+
+  static constexpr size_t kShardCount = 16;
+  static constexpr size_t kChunkSize  = 64 * 1024;
+
+  struct Shard {
+    mutable std::shared_mutex                     mutex;
+    std::unordered_map<std::string_view, Symbol*> symbols;  // keys point into the arena
+    std::vector<std::unique_ptr<std::byte[]>>     chunks;   // NOLINT(*-avoid-c-arrays)
+    std::byte*                                    cursor{nullptr};
+    size_t                                        remaining{0};
+    size_t                                        arena_bytes{0};
+    // storage of purged symbols, by size
+    std::unordered_map<size_t, std::vector<std::byte*>> free_storage;
+
+    Symbol*    allocate(std::string_view string, size_t hash);
+    std::byte* bump(size_t size);  // fresh storage from the current chunk, or a new one
+  };
+
+  Shard&       shardOf(size_t hash) { return shards_[hash % kShardCount]; }
+  const Shard& shardOf(size_t hash) const { return shards_[hash % kShardCount]; }
+
+  std::array<Shard, kShardCount> shards_;
+};
+
+}  // namespace jvm::runtime
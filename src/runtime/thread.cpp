@@ -0,0 +1,34 @@
+#include "thread.h"
+
+#include <algorithm>
+
+namespace jvm::runtime {
+
+Throwable* Thread::newThrowable(Klass* klass, std::string message) {
+  if (throwables_.size() >= sweep_threshold_) {
+    sweepThrowables();
+  }
+  throwables_.push_back(std::make_unique<Throwable>(klass, std::move(message)));
+  return throwables_.back().get();
+}
+
+void Thread::sweepThrowables() {
+  // conservative: a slot of any type whose bits equal the address of a throwable keeps it
+  std::vector<Jref> roots;
+  for (auto& frame : stack_) {
+    for (const auto& slot : frame.getLocalVariables().getSlots()) {
+      roots.push_back(slot.r);
+    }
+    frame.getOperandStack().forEachSlot([&roots](const Slot& slot) { roots.push_back(slot.r); });
+  }
+  std::ranges::sort(roots);
+
+  std::erase_if(throwables_, [this, &roots](const std::unique_ptr<Throwable>& throwable) {
+    Jref ref = static_cast<Object*>(throwable.get());
+    return throwable.get() != pending_exception_ && !throwable->isPinned() &&
+           !std::ranges::binary_search(roots, ref);
+  });
+  sweep_threshold_ = std::max(kMinSweepThreshold, throwables_.size() * 2);
+}
+
+}  // namespace jvm::runtime
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 #include "stack.h"
+#include "throwable.h"
 
 namespace jvm::runtime {
 
@@ -20,14 +25,38 @@ class Thread {
   void   incrementPC(size_t n = 1) { pc_ += n; }
 
   Stack& getStack() { return stack_; }
-  void   pushFrame(Frame frame) { stack_.push(std::move(frame)); }
+  // false if the frame does not fit, see Stack::push()
+  bool   pushFrame(Frame frame) { return stack_.push(std::move(frame)); }
   void   popFrame() { stack_.pop(); }
   Frame& getCurrentFrame() { return stack_.top(); }
   bool   isStackEmpty() { return stack_.empty(); }
 
+  // Exception being dispatched; set by a throwing instruction, cleared once a handler is entered
+  Throwable* getPendingException() const { return pending_exception_; }
+  bool       hasPendingException() const { return pending_exception_ != nullptr; }
+  void       setPendingException(Throwable* exception) { pending_exception_ = exception; }
+  void       clearPendingException() { pending_exception_ = nullptr; }
+
+  /**
+   * @brief Allocates a throwable of the given class. Until there is a heap, the thread owns
+   * the exceptions it creates. Once it owns twice as many as survived the last sweep, it frees
+   * those that are neither pending, pinned nor held by a slot of one of its frames, so a
+   * thread that keeps throwing and catching holds at most about twice what is live.
+   */
+  Throwable* newThrowable(Klass* klass, std::string message);
+  size_t     getThrowableCount() const { return throwables_.size(); }
+
  private:
+  static constexpr size_t kMinSweepThreshold = 64;
+
   size_t pc_{0};
   Stack  stack_;
+
+  Throwable*                              pending_exception_{nullptr};
+  std::vector<std::unique_ptr<Throwable>> throwables_;
+  size_t                                  sweep_threshold_{kMinSweepThreshold};
+
+  void sweepThrowables();
 };
 
 }  // namespace jvm::runtime
\ No newline at end of file
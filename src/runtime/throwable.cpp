@@ -0,0 +1,65 @@
+#include "throwable.h"
+
+#include <algorithm>
+#include <iterator>
+#include <sstream>
+
+#include "klass.h"
+#include "stack.h"
+
+namespace jvm::runtime {
+
+void Throwable::fillInStackTrace(Stack& stack, size_t pc) {
+  backtrace_.clear();
+  backtrace_.reserve(stack.size());
+  size_t frame_pc = pc;
+  for (auto it = stack.end(); it != stack.begin();) {
+    --it;
+    backtrace_.push_back({.method = it->getMethod(), .pc = static_cast<U4>(frame_pc)});
+    // the next frame down is suspended in the invoke that ends just before its resume address
+    if (it != stack.begin()) {
+      frame_pc = std::prev(it)->getCallerPC();
+      frame_pc = frame_pc > 0 ? frame_pc - 1 : 0;
+    }
+  }
+}
+
+std::vector<StackTraceElement> Throwable::getStackTrace() const {
+  std::vector<StackTraceElement> trace;
+  trace.reserve(backtrace_.size());
+  for (const auto& entry : backtrace_) {
+    std::string declaring_class(entry.method->getOwnerKlass()->getName());
+    std::ranges::replace(declaring_class, '/', '.');
+    trace.push_back({.declaring_class = std::move(declaring_class),
+                     .method_name     = std::string(entry.method->getName()),
+                     .pc              = entry.pc});
+  }
+  return trace;
+}
+
+std::string Throwable::toString() const {
+  std::string result(getKlass()->getName());
+  std::ranges::replace(result, '/', '.');
+  if (!message_.empty()) {
+    result += ": " + message_;
+  }
+  return result;
+}
+
+void Throwable::printStackTrace(std::ostream& out) const {
+  out << toString() << '\n';
+  for (const auto& element : getStackTrace()) {
+    out << "\tat " << element.declaring_class << '.' << element.method_name
+        << "(pc: " << element.pc << ")\n";
+  }
+}
+
+std::string UncaughtException::describe(Throwable* throwable) {
+  std::ostringstream out;
+  throwable->printStackTrace(out);
+  auto description = out.str();
+  description.pop_back();  // trailing newline
+  return description;
+}
+
+}  // namespace jvm::runtime
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "common/types.h"
+#include "object.h"
+
+namespace jvm::runtime {
+
+class Method;
+class Stack;
+
+// A materialized java.lang.StackTraceElement
+struct StackTraceElement {
+  std::string declaring_class;  // binary name, e.g. "java.lang.Object"
+  std::string method_name;
+  U4          pc;  // the throwing instruction for the top frame, inside the invoke for callers
+};
+
+// An instance of java.lang.Throwable or one of its subclasses
+class Throwable : public Object {
+ public:
+  Throwable(Klass* klass, std::string message) : Object(klass), message_(std::move(message)) {}
+
+  const std::string& getMessage() const { return message_; }
+
+  /**
+   * @brief Records the current Java stack, `pc` being the throwing instruction of the top frame.
+   * Only (Method*, pc) pairs are copied; names are resolved by getStackTrace().
+   */
+  void fillInStackTrace(Stack& stack, size_t pc);
+
+  std::vector<StackTraceElement> getStackTrace() const;
+
+  // "java.lang.ArithmeticException: / by zero", as Throwable.toString() would print it
+  std::string toString() const;
+
+  // toString() followed by one "\tat class.method(pc: n)" line per frame, top frame first
+  void printStackTrace(std::ostream& out) const;
+
+  // Set once the throwable is stored where no frame of its thread sees it, a static field;
+  // the thread keeps it from then on (see Thread::newThrowable)
+  void pin() { pinned_.store(true, std::memory_order_relaxed); }
+  bool isPinned() const { return pinned_.load(std::memory_order_relaxed); }
+
+ private:
+  struct BacktraceEntry {
+    const Method* method;
+    U4            pc;
+  };
+
+  std::string                 message_;
+  std::vector<BacktraceEntry> backtrace_;
+  std::atomic<bool>           pinned_{false};
+};
+
+// Raised to the embedder when a Java exception unwinds past the last frame of a thread.
+// Java code never observes this type: inside the interpreter, exceptions travel as the
+// thread's pending exception and are dispatched without C++ unwinding.
+class UncaughtException : public std::runtime_error {
+ public:
+  explicit UncaughtException(Throwable* throwable)
+    : std::runtime_error("Uncaught exception: " + describe(throwable)), throwable_(throwable) {}
+
+  // Owned by the thread that threw it, on which it stays pending; valid until that thread
+  // throws again or dies
+  Throwable* getThrowable() const { return throwable_; }
+
+ private:
+  static std::string describe(Throwable* throwable);
+
+  Throwable* throwable_;
+};
+
+}  // namespace jvm::runtime
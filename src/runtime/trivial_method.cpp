@@ -0,0 +1,172 @@
+#include "trivial_method.h"
+
+#include <optional>
+#include <string_view>
+
+#include "engine/opcode.h"
+
+namespace jvm::runtime {
+
+namespace {
+
+// NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+// The longest trivial body: ILOAD a; ILOAD b; op; IRETURN
+constexpr size_t kMaxCodeLength = 6;
+
+// A pushed value and its type as a descriptor letter ('A' for any reference)
+struct Push {
+  TrivialOperand operand;
+  char           type;
+};
+
+bool isWide(char type) { return type == 'J' || type == 'D'; }
+
+char returnType(U1 opcode) {
+  switch (opcode) {
+    case engine::IRETURN:
+      return 'I';
+    case engine::LRETURN:
+      return 'J';
+    case engine::FRETURN:
+      return 'F';
+    case engine::DRETURN:
+      return 'D';
+    case engine::ARETURN:
+      return 'A';
+    default:
+      return '\0';
+  }
+}
+
+bool isIntBinaryOp(U1 opcode) {
+  switch (opcode) {
+    case engine::IADD:
+    case engine::ISUB:
+    case engine::IMUL:
+    case engine::IAND:
+    case engine::IOR:
+    case engine::IXOR:
+    case engine::ISHL:
+    case engine::ISHR:
+    case engine::IUSHR:
+      return true;
+    default:
+      return false;  // IDIV and IREM can throw
+  }
+}
+
+// Reads past the end of the code yield NOP, which no shape accepts
+class CodeCursor {
+ public:
+  explicit CodeCursor(std::span<const U1> code) : code_(code) {}
+
+  U1 peek() const { return pc_ < code_.size() ? code_[pc_] : engine::NOP; }
+  U1 readU1() {
+    auto value = peek();
+    pc_++;
+    return value;
+  }
+  U2 readU2() {
+    U1 high = readU1();
+    return static_cast<U2>(high << 8U) | readU1();
+  }
+  bool atEnd() const { return pc_ == code_.size(); }
+
+ private:
+  std::span<const U1> code_;
+  size_t              pc_{0};
+};
+
+std::optional<Push> decodePush(CodeCursor& cursor, U2 arg_slot_count) {
+  auto constant = [](Slot value, char type) {
+    return Push{.operand = {.constant = value}, .type = type};
+  };
+  auto arg = [arg_slot_count](U2 slot, char type) -> std::optional<Push> {
+    if (slot + (isWide(type) ? 2 : 1) > arg_slot_count) {
+      return std::nullopt;  // a local that is not an argument
+    }
+    return Push{.operand = {.is_arg = true, .arg_slot = static_cast<U1>(slot)}, .type = type};
+  };
+  constexpr std::string_view kLoadTypes = "IJFDA";  // ILOAD_0 ... ALOAD_3, four of each
+
+  auto opcode = cursor.readU1();
+  if (opcode >= engine::ICONST_M1 && opcode <= engine::ICONST_5) {
+    return constant({.i = opcode - engine::ICONST_0}, 'I');
+  }
+  if (opcode >= engine::ILOAD_0 && opcode < engine::ILOAD_0 + 4 * kLoadTypes.size()) {
+    auto offset = opcode - engine::ILOAD_0;
+    return arg(offset % 4, kLoadTypes[offset / 4]);
+  }
+  switch (opcode) {
+    case engine::ACONST_NULL:
+      return constant({.r = nullptr}, 'A');
+    case engine::LCONST_0:
+    case engine::LCONST_1:
+      return constant({.l = opcode - engine::LCONST_0}, 'J');
+    case engine::FCONST_0:
+    case engine::FCONST_1:
+    case engine::FCONST_2:
+      return constant({.f = static_cast<Jfloat>(opcode - engine::FCONST_0)}, 'F');
+    case engine::DCONST_0:
+    case engine::DCONST_1:
+      return constant({.d = static_cast<Jdouble>(opcode - engine::DCONST_0)}, 'D');
+    case engine::BIPUSH:
+      return constant({.i = static_cast<Jbyte>(cursor.readU1())}, 'I');
+    case engine::SIPUSH:
+      return constant({.i = static_cast<Jshort>(cursor.readU2())}, 'I');
+    case engine::ILOAD:
+    case engine::LLOAD:
+    case engine::FLOAD:
+    case engine::DLOAD:
+    case engine::ALOAD:
+      return arg(cursor.readU1(), kLoadTypes[opcode - engine::ILOAD]);
+    default:
+      return std::nullopt;
+  }
+}
+
+// NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
+
+}  // namespace
+
+TrivialMethod TrivialMethod::match(std::span<const U1> code, U2 arg_slot_count) {
+  if (code.size() > kMaxCodeLength || arg_slot_count > kMaxArgSlots) {
+    return {};
+  }
+  CodeCursor cursor(code);
+
+  if (cursor.peek() == engine::GETSTATIC) {
+    cursor.readU1();
+    auto field_index = cursor.readU2();
+    auto type        = returnType(cursor.readU1());
+    if (!cursor.atEnd() || type == '\0' || isWide(type)) {
+      return {};
+    }
+    return {.kind = Kind::kStaticGetter, .field_index = field_index};
+  }
+
+  auto lhs = decodePush(cursor, arg_slot_count);
+  if (!lhs) {
+    return {};
+  }
+  if (returnType(cursor.peek()) == lhs->type) {
+    cursor.readU1();
+    if (!cursor.atEnd()) {
+      return {};
+    }
+    return {.kind = Kind::kValue, .wide = isWide(lhs->type), .lhs = lhs->operand};
+  }
+
+  auto rhs = decodePush(cursor, arg_slot_count);
+  if (!rhs || lhs->type != 'I' || rhs->type != 'I') {
+    return {};
+  }
+  auto opcode = cursor.readU1();
+  if (!isIntBinaryOp(opcode) || cursor.readU1() != engine::IRETURN || !cursor.atEnd()) {
+    return {};
+  }
+  return {.kind = Kind::kIntBinaryOp, .opcode = opcode, .lhs = lhs->operand, .rhs = rhs->operand};
+}
+
+}  // namespace jvm::runtime
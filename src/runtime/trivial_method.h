@@ -0,0 +1,50 @@
+#pragma once
+
+#include <span>
+
+#include "common/types.h"
+#include "slot.h"
+
+namespace jvm::runtime {
+
+// Operand of a trivial method: one of its argument slots or a constant
+struct TrivialOperand {
+  bool is_arg{false};
+  U1   arg_slot{0};
+  Slot constant{};
+};
+
+// A method whose whole body is one of a few bytecode shapes, recognized at link time so that
+// the interpreter can execute call sites to it in place, without building a frame:
+//   kValue        - push; xRETURN             e.g. ICONST_1; IRETURN or ALOAD_0; ARETURN
+//   kIntBinaryOp  - push; push; op; IRETURN   e.g. ILOAD_0; ILOAD_1; IADD; IRETURN
+//   kStaticGetter - GETSTATIC; xRETURN        for a single-slot static field
+// None of these shapes can throw, loop or call, so eliding the frame is unobservable.
+struct TrivialMethod {
+  enum class Kind : U1 {
+    kNone,
+    kValue,
+    kIntBinaryOp,
+    kStaticGetter,
+  };
+
+  // Arguments are copied off the caller's operand stack before the body is evaluated
+  static constexpr U2 kMaxArgSlots = 8;
+
+  Kind           kind{Kind::kNone};
+  bool           wide{false};  // kValue: the result takes two slots (long, double)
+  U1             opcode{0};    // kIntBinaryOp: IADD, ISUB, ...
+  TrivialOperand lhs{};        // kValue: the result
+  TrivialOperand rhs{};
+  U2             field_index{0};  // kStaticGetter: Fieldref in the owner's constant pool
+
+  bool isTrivial() const { return kind != Kind::kNone; }
+
+  /**
+   * @brief Matches the code of a static method against the trivial shapes
+   * @return The shape, or a TrivialMethod of kind kNone if the method is not trivial
+   */
+  static TrivialMethod match(std::span<const U1> code, U2 arg_slot_count);
+};
+
+}  // namespace jvm::runtime
@@ -0,0 +1,101 @@
+#include "vm_options.h"
+
+#include <charconv>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace jvm::runtime {
+
+namespace {
+
+// "512", "512k", "4m", "1g" (case-insensitive suffix), as accepted by -Xss/-Xmx
+size_t parseMemorySize(std::string_view option, std::string_view value) {
+  size_t size = 0;
+
+  auto [ptr, error] = std::from_chars(value.data(), value.data() + value.size(), size);
+  if (error != std::errc() || ptr == value.data()) {
+    throw std::invalid_argument("Invalid memory size: " + std::string(option));
+  }
+
+  std::string_view suffix(ptr, value.data() + value.size() - ptr);
+  size_t           multiplier = 1;
+  if (suffix == "k" || suffix == "K") {
+    multiplier = size_t{1} << 10U;
+  } else if (suffix == "m" || suffix == "M") {
+    multiplier = size_t{1} << 20U;
+  } else if (suffix == "g" || suffix == "G") {
+    multiplier = size_t{1} << 30U;
+  } else if (!suffix.empty()) {
+    throw std::invalid_argument("Invalid memory size: " + std::string(option));
+  }
+  if (size == 0) {
+    throw std::invalid_argument("Memory size must be positive: " + std::string(option));
+  }
+  if (size > std::numeric_limits<size_t>::max() / multiplier) {
+    throw std::invalid_argument("Memory size too large: " + std::string(option));
+  }
+  return size * multiplier;
+}
+
+size_t parseCount(std::string_view option, std::string_view value, size_t minimum = 1) {
+  size_t count = 0;
+
+  auto [ptr, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+  if (error != std::errc() || ptr != value.data() + value.size() || count < minimum) {
+    throw std::invalid_argument("Invalid value: " + std::string(option));
+  }
+  return count;
+}
+
+}  // namespace
+
+bool VMOptions::parse(std::string_view option) {
+  if (option.starts_with("-Xss")) {
+    thread_stack_size = parseMemorySize(option, option.substr(4));
+    return true;
+  }
+  if (option == "-XX:+MemoizePureMethods" || option == "-XX:-MemoizePureMethods") {
+    memoize_pure_methods = option[4] == '+';
+    return true;
+  }
+  if (option.starts_with("-XX:MemoCacheSize=")) {
+    memo_cache_size = parseCount(option, option.substr(option.find('=') + 1));
+    return true;
+  }
+  if (option == "-XX:+FlattenMemberTables" || option == "-XX:-FlattenMemberTables") {
+    flatten_member_tables = option[4] == '+';
+    return true;
+  }
+  if (option == "-XX:+ParallelClassLoading" || option == "-XX:-ParallelClassLoading") {
+    parallel_class_loading = option[4] == '+';
+    return true;
+  }
+  if (option.starts_with("-Xshare:")) {
+    auto mode = option.substr(8);
+    if (mode == "off") {
+      share_mode = ShareMode::kOff;
+    } else if (mode == "auto") {
+      share_mode = ShareMode::kAuto;
+    } else if (mode == "on") {
+      share_mode = ShareMode::kOn;
+    } else if (mode == "dump") {
+      share_mode = ShareMode::kDump;
+    } else {
+      throw std::invalid_argument("Invalid value: " + std::string(option));
+    }
+    return true;
+  }
+  if (option.starts_with("-XX:SharedArchiveFile=")) {
+    shared_archive_file = option.substr(option.find('=') + 1);
+    return true;
+  }
+  if (option.starts_with("-XX:ClassLoadingThreads=")) {
+    // 0 sizes the pool by the hardware
+    class_loading_threads = parseCount(option, option.substr(option.find('=') + 1), 0);
+    return true;
+  }
+  return false;
+}
+
+}  // namespace jvm::runtime
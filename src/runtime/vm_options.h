@@ -0,0 +1,70 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+#include "common/types.h"
+
+namespace jvm::runtime {
+
+// Use of the class data sharing archive (-Xshare:)
+enum class ShareMode : U1 {
+  kOff,   // never
+  kAuto,  // when the archive exists and matches the classpath and its current contents
+  kOn,    // always; an unusable archive is an error
+  kDump,  // write the archive when the application's class loader is destroyed
+};
+
+// VM-wide tunables, the counterpart of HotSpot's -X/-XX flags
+struct VMOptions {
+  // Implicit exceptions (null, divide by zero, bounds, ...) raised more than
+  // `fast_throw_threshold` times from the same bytecode reuse a preallocated instance with no
+  // stack trace, like -XX:+OmitStackTraceInFastThrow
+  bool omit_stack_trace_in_fast_throw = true;
+  U4   fast_throw_threshold           = 1000;
+
+  // Usable size of each Java thread stack in bytes, excluding its guard zones (-Xss)
+  size_t thread_stack_size = 1024 * 1024;
+
+  // Cache the results of pure static methods (see runtime::isPure) per argument values, in a
+  // table of `memo_cache_size` entries per method (-XX:+MemoizePureMethods,
+  // -XX:MemoCacheSize=)
+  bool   memoize_pure_methods = false;
+  size_t memo_cache_size      = 256;
+
+  // Give each class one member table that also holds the members it inherits, so that
+  // resolving an inherited method or field is a single probe instead of one per superclass,
+  // at the cost of a table entry per inherited member (-XX:+FlattenMemberTables)
+  bool flatten_member_tables = false;
+
+  // Read and parse the supertypes of a loaded class before linking asks for them, on one
+  // VM-wide pool of `class_loading_threads` workers (0: one per hardware thread), started on
+  // first use; defining them stays on the loading thread (-XX:+ParallelClassLoading,
+  // -XX:ClassLoadingThreads=)
+  bool   parallel_class_loading = true;
+  size_t class_loading_threads  = 0;
+
+  // Class data sharing: class loaders whose classpath matches the archive at
+  // `shared_archive_file` define its classes from it instead of parsing their class files
+  // (-Xshare:, -XX:SharedArchiveFile=)
+  ShareMode   share_mode = ShareMode::kAuto;
+  std::string shared_archive_file;
+
+  // Meyer's singleton
+  static VMOptions& getInstance() {
+    static VMOptions instance;
+    return instance;
+  }
+
+  void reset() { *this = VMOptions{}; }
+
+  /**
+   * @brief Applies one command-line option, e.g. "-Xss512k" or "-XX:+MemoizePureMethods"
+   * @return false if the option is not a VM option
+   * @throws std::invalid_argument if the option is recognized but its value is malformed
+   */
+  bool parse(std::string_view option);
+};
+
+}  // namespace jvm::runtime
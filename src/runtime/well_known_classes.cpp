@@ -0,0 +1,107 @@
+#include "well_known_classes.h"
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string>
+
+#include "klass.h"
+#include "throwable.h"
+
+namespace jvm::runtime {
+
+namespace {
+
+struct WellKnownClassInfo {
+  WellKnownClass   id;
+  std::string_view name;  // internal form
+  WellKnownClass   super;  // kCount for java.lang.Throwable, whose super (Object) is not modeled
+};
+
+// Listed so that every class comes after its superclass
+constexpr std::array<WellKnownClassInfo, static_cast<size_t>(WellKnownClass::kCount)> kInfos = {{
+  {WellKnownClass::kThrowable, "java/lang/Throwable", WellKnownClass::kCount},
+  {WellKnownClass::kException, "java/lang/Exception", WellKnownClass::kThrowable},
+  {WellKnownClass::kRuntimeException, "java/lang/RuntimeException", WellKnownClass::kException},
+  {WellKnownClass::kArithmeticException, "java/lang/ArithmeticException",
+   WellKnownClass::kRuntimeException},
+  {WellKnownClass::kNullPointerException, "java/lang/NullPointerException",
+   WellKnownClass::kRuntimeException},
+  {WellKnownClass::kClassCastException, "java/lang/ClassCastException",
+   WellKnownClass::kRuntimeException},
+  {WellKnownClass::kArrayStoreException, "java/lang/ArrayStoreException",
+   WellKnownClass::kRuntimeException},
+  {WellKnownClass::kIndexOutOfBoundsException, "java/lang/IndexOutOfBoundsException",
+   WellKnownClass::kRuntimeException},
+  {WellKnownClass::kArrayIndexOutOfBoundsException, "java/lang/ArrayIndexOutOfBoundsException",
+   WellKnownClass::kIndexOutOfBoundsException},
+  {WellKnownClass::kNegativeArraySizeException, "java/lang/NegativeArraySizeException",
+   WellKnownClass::kRuntimeException},
+  {WellKnownClass::kError, "java/lang/Error", WellKnownClass::kThrowable},
+  {WellKnownClass::kLinkageError, "java/lang/LinkageError", WellKnownClass::kError},
+  {WellKnownClass::kNoClassDefFoundError, "java/lang/NoClassDefFoundError",
+   WellKnownClass::kLinkageError},
+  {WellKnownClass::kExceptionInInitializerError, "java/lang/ExceptionInInitializerError",
+   WellKnownClass::kLinkageError},
+  {WellKnownClass::kVirtualMachineError, "java/lang/VirtualMachineError", WellKnownClass::kError},
+  {WellKnownClass::kStackOverflowError, "java/lang/StackOverflowError",
+   WellKnownClass::kVirtualMachineError},
+  {WellKnownClass::kOutOfMemoryError, "java/lang/OutOfMemoryError",
+   WellKnownClass::kVirtualMachineError},
+}};
+
+class WellKnownClasses {
+ public:
+  static WellKnownClasses& getInstance() {
+    static WellKnownClasses instance;
+    return instance;
+  }
+
+  Klass* get(WellKnownClass id) const { return klasses_[static_cast<size_t>(id)].get(); }
+
+  Throwable* getPreallocated(WellKnownClass id) const {
+    return preallocated_[static_cast<size_t>(id)].get();
+  }
+
+  Klass* find(std::string_view internal_name) const {
+    for (const auto& info : kInfos) {
+      if (info.name == internal_name) {
+        return get(info.id);
+      }
+    }
+    return nullptr;
+  }
+
+ private:
+  WellKnownClasses() {
+    for (const auto& info : kInfos) {
+      Klass* super = info.super == WellKnownClass::kCount ? nullptr : get(info.super);
+      klasses_[static_cast<size_t>(info.id)] = std::unique_ptr<Klass>(
+        new Klass(std::string(info.name), AccessFlags<flags::Class>(kPublicSuper), super));
+      preallocated_[static_cast<size_t>(info.id)] =
+        std::make_unique<Throwable>(get(info.id), std::string());
+    }
+  }
+
+  static constexpr U2 kPublicSuper =
+    static_cast<U2>(flags::Class::PUBLIC) | static_cast<U2>(flags::Class::SUPER);
+
+  std::array<std::unique_ptr<Klass>, kInfos.size()>     klasses_;
+  std::array<std::unique_ptr<Throwable>, kInfos.size()> preallocated_;
+};
+
+}  // namespace
+
+Klass* getWellKnownClass(WellKnownClass id) { return WellKnownClasses::getInstance().get(id); }
+
+Throwable* getPreallocatedException(WellKnownClass id) {
+  return WellKnownClasses::getInstance().getPreallocated(id);
+}
+
+Klass* findWellKnownClass(std::string_view binary_name) {
+  std::string internal_name(binary_name);
+  std::ranges::replace(internal_name, '.', '/');
+  return WellKnownClasses::getInstance().find(internal_name);
+}
+
+}  // namespace jvm::runtime
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string_view>
+
+namespace jvm::runtime {
+
+class Klass;
+class Throwable;
+
+// Classes the VM itself needs to instantiate (implicit exceptions and errors). Until a class
+// library is available on the boot classpath, the VM defines them as synthetic classes with
+// the standard java.lang hierarchy so that Java handlers can catch them by type.
+enum class WellKnownClass : unsigned char {
+  kThrowable,
+  kException,
+  kRuntimeException,
+  kArithmeticException,
+  kNullPointerException,
+  kClassCastException,
+  kArrayStoreException,
+  kIndexOutOfBoundsException,
+  kArrayIndexOutOfBoundsException,
+  kNegativeArraySizeException,
+  kError,
+  kLinkageError,
+  kNoClassDefFoundError,
+  kExceptionInInitializerError,
+  kVirtualMachineError,
+  kStackOverflowError,
+  kOutOfMemoryError,
+
+  kCount,
+};
+
+/**
+ * @brief Returns the synthetic Klass of a well-known class
+ */
+Klass* getWellKnownClass(WellKnownClass id);
+
+/**
+ * @brief Looks up a well-known class by its binary name (e.g. "java.lang.ArithmeticException")
+ * @return The Klass, or nullptr if the VM does not define a class of that name
+ */
+Klass* findWellKnownClass(std::string_view binary_name);
+
+/**
+ * @brief Returns the VM-wide preallocated instance of a well-known exception class, thrown in
+ * place of a fresh one at hot implicit-exception sites. It has no message and no stack trace.
+ */
+Throwable* getPreallocatedException(WellKnownClass id);
+
+}  // namespace jvm::runtime
@@ -0,0 +1,112 @@
+package tests.data.java;
+
+public class ClassInitTest {
+    // The initializers that ran, one digit each, in order
+    static int trace;
+
+    static int record(int step) {
+        trace = trace * 10 + step;
+        return step;
+    }
+
+    static int zero() {
+        return 0;
+    }
+
+    // ============================================================================
+    // Classes to initialize
+    // ============================================================================
+    static class Base {
+        static int value = record(1);
+    }
+
+    static class Derived extends Base {
+        static int value = record(2);
+    }
+
+    static class Counted {
+        static int runs;
+        static int value;
+
+        static {
+            runs = runs + 1;
+            value = 7;
+        }
+    }
+
+    static class Config {
+        static int limit = 42;
+
+        static int getLimit() {
+            return limit;
+        }
+    }
+
+    static class Failing {
+        static int value = 1 / zero();
+    }
+
+    static class FailingChild extends Failing {
+        static int own = 5;
+    }
+
+    // ============================================================================
+    // Callers
+    // ============================================================================
+    public static int initOrder() {
+        int value = Derived.value;
+        return trace;
+    }
+
+    public static int readTwice() {
+        return Counted.value + Counted.value;
+    }
+
+    public static int countedRuns() {
+        int value = Counted.value;
+        return Counted.runs;
+    }
+
+    public static int callGetter() {
+        return Config.getLimit();
+    }
+
+    public static int initFailure() {
+        int result = 0;
+        try {
+            result = Failing.value;
+        } catch (ExceptionInInitializerError e) {
+            result += 1;
+        }
+        try {
+            result = Failing.value;
+        } catch (NoClassDefFoundError e) {
+            result += 10;
+        }
+        return result;
+    }
+
+    // FailingChild fails with its superclass, and stays erroneous
+    public static int subclassInitFailure() {
+        int result = 0;
+        try {
+            result = FailingChild.own;
+        } catch (ExceptionInInitializerError e) {
+            result += 1;
+        }
+        try {
+            result = FailingChild.own;
+        } catch (NoClassDefFoundError e) {
+            result += 10;
+        }
+        return result;
+    }
+
+    public static int subclassOfErroneous() {
+        try {
+            return FailingChild.own;
+        } catch (NoClassDefFoundError e) {
+            return -1;
+        }
+    }
+}
@@ -0,0 +1,221 @@
+package tests.data.java;
+
+public class ExceptionTest {
+    static int finallyCount;
+    static int depth;
+
+    public static int divide(int a, int b) {
+        return a / b;
+    }
+
+    // ============================================================================
+    // Handler in the throwing frame
+    // ============================================================================
+    public static int catchArithmetic(int a, int b) {
+        try {
+            return a / b;
+        } catch (ArithmeticException e) {
+            return -1;
+        }
+    }
+
+    // catch type is a superclass of the thrown exception
+    public static int catchRuntimeException(int a, int b) {
+        try {
+            return a / b;
+        } catch (RuntimeException e) {
+            return -2;
+        }
+    }
+
+    public static long catchLongRemainder(long a, long b) {
+        try {
+            return a % b;
+        } catch (ArithmeticException e) {
+            return -4L;
+        }
+    }
+
+    // inner handler does not match, the outer one does
+    public static int nestedHandlers(int a, int b) {
+        try {
+            try {
+                return a / b;
+            } catch (NullPointerException e) {
+                return -5;
+            }
+        } catch (ArithmeticException e) {
+            return -6;
+        }
+    }
+
+    // ============================================================================
+    // Unwinding through callee frames
+    // ============================================================================
+    public static int catchFromCallee(int a, int b) {
+        try {
+            return divide(a, b);
+        } catch (ArithmeticException e) {
+            return -3;
+        }
+    }
+
+    public static int rethrow(int a, int b) {
+        try {
+            return a / b;
+        } catch (ArithmeticException e) {
+            throw e;
+        }
+    }
+
+    public static int catchRethrown(int a, int b) {
+        try {
+            return rethrow(a, b);
+        } catch (ArithmeticException e) {
+            return -7;
+        }
+    }
+
+    // athrow of null raises NullPointerException
+    public static int throwNull() {
+        try {
+            throw null;
+        } catch (NullPointerException e) {
+            return -8;
+        }
+    }
+
+    // ============================================================================
+    // finally (catch-all handler)
+    // ============================================================================
+    public static int withFinally(int a, int b) {
+        try {
+            return a / b;
+        } finally {
+            finallyCount++;
+        }
+    }
+
+    public static int finallyCountAfter(int a, int b) {
+        finallyCount = 0;
+        try {
+            withFinally(a, b);
+        } catch (ArithmeticException e) {
+            finallyCount += 10;
+        }
+        return finallyCount;
+    }
+
+    // exceptions thrown and caught repeatedly in a loop
+    public static int countZeroDivisors(int n) {
+        int caught = 0;
+        for (int i = 0; i < n; i++) {
+            try {
+                divide(i, i % 2);
+            } catch (ArithmeticException e) {
+                caught++;
+            }
+        }
+        return caught;
+    }
+
+    // ============================================================================
+    // Stack overflow
+    // ============================================================================
+    public static void recurse() {
+        depth++;
+        recurse();
+    }
+
+    public static int catchStackOverflow() {
+        depth = 0;
+        try {
+            recurse();
+        } catch (StackOverflowError e) {
+            return depth;
+        }
+        return -1;
+    }
+
+    // the guard zone must be back in place for the second overflow to be caught as well
+    public static int overflowTwice() {
+        catchStackOverflow();
+        return catchStackOverflow();
+    }
+
+    // ============================================================================
+    // instanceof and checkcast on caught exceptions
+    // ============================================================================
+    public static int classifyCaught(int a, int b) {
+        try {
+            return a / b;
+        } catch (Throwable t) {
+            int kind = 0;
+            if (t instanceof RuntimeException) {
+                kind += 1;
+            }
+            if (t instanceof ArithmeticException) {
+                kind += 2;
+            }
+            if (t instanceof Error) {
+                kind += 4;
+            }
+            return -kind;
+        }
+    }
+
+    public static int castCaught(int a, int b) {
+        try {
+            return a / b;
+        } catch (Throwable t) {
+            try {
+                Error e = (Error) t;
+                return -1;
+            } catch (ClassCastException e) {
+                return -2;
+            }
+        }
+    }
+
+    // null passes any cast and is an instance of nothing
+    public static int castNull() {
+        Throwable t = null;
+        RuntimeException e = (RuntimeException) t;
+        return t instanceof RuntimeException ? 1 : 0;
+    }
+
+    public static int castUncaught(int a, int b) {
+        try {
+            return a / b;
+        } catch (Throwable t) {
+            Error e = (Error) t;
+            return -1;
+        }
+    }
+
+    // ============================================================================
+    // Uncaught exceptions escape the interpreter
+    // ============================================================================
+    public static int uncaught(int a, int b) {
+        return divide(a, b);
+    }
+
+    // ============================================================================
+    // Catch type missing at run time
+    // ============================================================================
+    // run without MissingCatchType.class on the classpath: its handler is passed over
+    public static int catchPastMissingType(int a, int b) {
+        try {
+            try {
+                return a / b;
+            } catch (MissingCatchType e) {
+                return -1;
+            }
+        } catch (ArithmeticException e) {
+            return -2;
+        }
+    }
+}
+
+class MissingCatchType extends RuntimeException {
+}
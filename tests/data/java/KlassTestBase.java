@@ -0,0 +1,16 @@
+package tests.data.java;
+
+public class KlassTestBase {
+    public int baseField;
+    public int shared;
+
+    public static int baseStatic;
+
+    public int describe() {
+        return 1;
+    }
+
+    public int baseOnly() {
+        return 10;
+    }
+}
@@ -0,0 +1,14 @@
+package tests.data.java;
+
+public class KlassTestDerived extends KlassTestBase {
+    public long shared;  // hides KlassTestBase.shared, a different descriptor
+
+    @Override
+    public int describe() {
+        return 2;
+    }
+
+    public int derivedOnly() {
+        return 20;
+    }
+}
@@ -0,0 +1,71 @@
+package tests.data.java;
+
+public class MemoizationTest {
+    static int counter;
+
+    // ============================================================================
+    // Pure methods
+    // ============================================================================
+    static int score(int x) {
+        int result = x * x;
+        return result + 1;
+    }
+
+    static int fib(int n) {
+        if (n < 2) {
+            return n;
+        }
+        return fib(n - 1) + fib(n - 2);
+    }
+
+    static long mix(long a, int b) {
+        return a * 31 + b;
+    }
+
+    // ============================================================================
+    // Impure methods
+    // ============================================================================
+    static int bump(int x) {
+        counter = counter + x;
+        return counter;
+    }
+
+    static int readCounter(int x) {
+        return counter + x;
+    }
+
+    static int callsBump(int x) {
+        return bump(x) + 1;
+    }
+
+    // ============================================================================
+    // Callers
+    // ============================================================================
+    public static int testScoreLoop(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum = sum + score(i % 10);
+        }
+        return sum;
+    }
+
+    public static int testFib(int n) {
+        return fib(n);
+    }
+
+    public static long testMix(long a, int b) {
+        return mix(a, b);
+    }
+
+    public static int testBumpLoop(int n) {
+        int last = 0;
+        for (int i = 0; i < n; i++) {
+            last = callsBump(1);
+        }
+        return last;
+    }
+
+    public static int testReadCounter(int x) {
+        return readCounter(x);
+    }
+}
@@ -0,0 +1,35 @@
+package tests.data.java;
+
+// Type hierarchies for the subtype checks of runtime::Klass
+public class SubtypeTest {
+    interface Shape {}
+
+    interface Polygon extends Shape {}
+
+    interface Named {}
+
+    static class Quad implements Polygon {}
+
+    static class Square extends Quad implements Named {}
+
+    // a chain of classes deeper than the primary super display
+    static class D1 {}
+
+    static class D2 extends D1 {}
+
+    static class D3 extends D2 {}
+
+    static class D4 extends D3 {}
+
+    static class D5 extends D4 {}
+
+    static class D6 extends D5 {}
+
+    static class D7 extends D6 {}
+
+    static class D8 extends D7 {}
+
+    static class D9 extends D8 {}
+
+    static class D10 extends D9 implements Named {}
+}
@@ -0,0 +1,118 @@
+package tests.data.java;
+
+public class TrivialMethodTest {
+    static int counter;
+
+    // ============================================================================
+    // Trivial helpers - executed in place by the interpreter
+    // ============================================================================
+    static int one() {
+        return 1;
+    }
+
+    static int minusOne() {
+        return -1;
+    }
+
+    static int thousand() {
+        return 1000;
+    }
+
+    static long longOne() {
+        return 1L;
+    }
+
+    static int identity(int x) {
+        return x;
+    }
+
+    static int second(int a, int b) {
+        return b;
+    }
+
+    static int add(int a, int b) {
+        return a + b;
+    }
+
+    static int sub(int a, int b) {
+        return a - b;
+    }
+
+    static int inc(int x) {
+        return x + 1;
+    }
+
+    static int shl(int a, int b) {
+        return a << b;
+    }
+
+    static int getCounter() {
+        return counter;
+    }
+
+    // ============================================================================
+    // Not trivial - the division may throw, and two operators need a frame
+    // ============================================================================
+    static int div(int a, int b) {
+        return a / b;
+    }
+
+    static int addThree(int a, int b, int c) {
+        return a + b + c;
+    }
+
+    // ============================================================================
+    // Callers
+    // ============================================================================
+    public static int testConstants() {
+        return one() + minusOne() + thousand();
+    }
+
+    public static long testLongConstant() {
+        return longOne();
+    }
+
+    public static int testIdentity(int x) {
+        return identity(x);
+    }
+
+    public static int testSecond(int a, int b) {
+        return second(a, b);
+    }
+
+    public static int testAdd(int a, int b) {
+        return add(a, b);
+    }
+
+    public static int testSub(int a, int b) {
+        return sub(a, b);
+    }
+
+    public static int testInc(int x) {
+        return inc(inc(x));
+    }
+
+    public static int testShl(int a, int b) {
+        return shl(a, b);
+    }
+
+    public static int testGetCounter() {
+        return getCounter();
+    }
+
+    public static int testDiv(int a, int b) {
+        return div(a, b);
+    }
+
+    public static int testAddThree(int a, int b, int c) {
+        return addThree(a, b, c);
+    }
+
+    public static int testSumLoop(int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum = add(sum, i);
+        }
+        return sum;
+    }
+}
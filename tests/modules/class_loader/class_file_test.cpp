@@ -2,6 +2,7 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -53,7 +54,10 @@ TEST_F(ClassFileTest, ParseConstantPool) {
   EXPECT_EQ(constant_pool.size(), 26);
   EXPECT_EQ(constant_pool.getUtf8String(4), "java/lang/Object");
   EXPECT_EQ(constant_pool.getClassName(2), "java/lang/Object");
-  EXPECT_THROW(constant_pool.getConstantInfo(0), std::invalid_argument);
+  EXPECT_EQ(constant_pool.getTag(2), class_loader::ConstantTag::kClass);
+  EXPECT_EQ(constant_pool.getTag(4), class_loader::ConstantTag::kUtf8);
+  EXPECT_THROW(constant_pool.getTag(0), std::invalid_argument);
+  EXPECT_THROW(constant_pool.getClassName(4), std::runtime_error);
 }
 
 TEST_F(ClassFileTest, ParseAccessFlags) {
@@ -101,4 +105,23 @@ TEST_F(ClassFileTest, ParseMethods) {
 TEST_F(ClassFileTest, ParseAttributes) {
   auto class_file = parser_->parse();
   EXPECT_EQ(class_file->attributes.getAttributes().size(), 0);
-}
\ No newline at end of file
+}
+
+TEST_F(ClassFileTest, RejectsMalformedCodeAttribute) {
+  // find the code_length of main's Code attribute in the class file bytes
+  auto        class_file = parser_->parse();
+  const auto& main       = class_file->methods.getMembers()[1];
+  auto*       code       = main->attributes.getAttribute<class_loader::CodeAttribute>();
+  ASSERT_NE(code, nullptr);
+  auto code_length_offset = static_cast<size_t>(code->info.data() - class_file_data_.data()) + 4;
+
+  // longer than the attribute holds
+  auto truncated                    = class_file_data_;
+  truncated[code_length_offset + 2] = 0xFF;
+  EXPECT_THROW(class_loader::ClassFileParser(truncated).parse(), std::runtime_error);
+
+  // no code at all
+  auto empty = class_file_data_;
+  std::fill_n(empty.begin() + static_cast<std::ptrdiff_t>(code_length_offset), 4, 0);
+  EXPECT_THROW(class_loader::ClassFileParser(empty).parse(), std::runtime_error);
+}
@@ -2,11 +2,17 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "runtime/klass.h"
 #include "runtime/method_area.h"
+#include "runtime/vm_options.h"
 
 using namespace jvm;
 
@@ -109,6 +115,72 @@ TEST_F(ClassLoaderTest, ClassRegisteredInMethodArea) {
   EXPECT_EQ(retrieved_klass, klass) << "Retrieved class should match loaded class";
 }
 
+TEST_F(ClassLoaderTest, FailedPreparationLeavesNoClassBehind) {
+  // HelloWorld with its "Code" attribute name renamed: its methods have no code, which is
+  // only found once the class is defined and being prepared
+  auto base = std::filesystem::temp_directory_path() / "class_loader_test_no_code";
+  std::filesystem::remove_all(base);
+  std::filesystem::create_directories(base / "tests/data/java");
+  {
+    auto              original = std::filesystem::path(TEST_CLASS_PATH) / "tests/data/java";
+    std::ifstream     in(original / "HelloWorld.class", std::ios::binary);
+    std::vector<char> bytes(std::istreambuf_iterator<char>(in), {});
+    const std::string code = "Code";
+    auto              it   = std::search(bytes.begin(), bytes.end(), code.begin(), code.end());
+    ASSERT_NE(it, bytes.end());
+    *(it + 1) = 'x';
+    std::ofstream(base / "tests/data/java/HelloWorld.class", std::ios::binary)
+      .write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+  }
+
+  class_loader::ClassLoader loader(nullptr, {base.string()});
+  std::string               class_name = "tests.data.java.HelloWorld";
+  EXPECT_THROW(loader.loadClass(class_name), std::runtime_error);
+  EXPECT_FALSE(runtime::MethodArea::getInstance().hasClass(&loader, class_name));
+  // a second attempt starts over and fails the same way
+  EXPECT_THROW(loader.loadClass(class_name), std::runtime_error);
+  EXPECT_FALSE(runtime::MethodArea::getInstance().hasClass(&loader, class_name));
+  EXPECT_TRUE(runtime::MethodArea::getInstance().getClasses(&loader).empty());
+
+  std::filesystem::remove_all(base);
+}
+
+TEST_F(ClassLoaderTest, CompactsClassFileAfterPreparation) {
+  auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+
+  // the Klass holds the members; the class file keeps only what linked code reads
+  auto* class_file = klass->getClassFile();
+  ASSERT_NE(class_file, nullptr);
+  EXPECT_TRUE(class_file->methods.getMembers().empty());
+  EXPECT_TRUE(class_file->fields.getMembers().empty());
+  EXPECT_EQ(class_file->constant_pool.getClassName(class_file->this_class_index),
+            "tests/data/java/KlassTestData");
+
+  // Code attributes are still decoded from the class file bytes
+  auto* add_method = klass->findMethod("add", "(II)I");
+  ASSERT_NE(add_method, nullptr);
+  EXPECT_EQ(add_method->getCode().size(), 4U);
+  EXPECT_NE(klass->findField("sd", "D"), nullptr);
+}
+
+TEST_F(ClassLoaderTest, ReleasesClassBytesOnceDecoded) {
+  auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+  const auto& source = klass->getClassFile()->source;
+  EXPECT_FALSE(source.getBytes().empty());
+
+  auto methods = klass->getMethods();
+  ASSERT_GT(methods.size(), 1U);
+  for (const auto& method : methods.first(methods.size() - 1)) {
+    EXPECT_FALSE(method.getCode().empty());
+  }
+  // the last method still to be decoded views them
+  EXPECT_FALSE(source.getBytes().empty());
+  EXPECT_FALSE(methods.back().getCode().empty());
+  EXPECT_TRUE(source.getBytes().empty());
+}
+
 TEST_F(ClassLoaderTest, ParentClassLoader) {
   // Test parent class loader
   auto parent_loader = std::make_unique<class_loader::ClassLoader>(nullptr, classpath_list_);
@@ -145,3 +217,46 @@ TEST_F(ClassLoaderTest, InvalidClasspath) {
   std::string class_name = "tests.data.java.HelloWorld";
   EXPECT_THROW(invalid_loader->loadClass(class_name), std::runtime_error);
 }
+
+TEST_F(ClassLoaderTest, ConcurrentLoadsDefineOnce) {
+  constexpr int                kThreads = 8;
+  std::vector<runtime::Klass*> derived(kThreads);
+  std::vector<runtime::Klass*> base(kThreads);
+  std::vector<std::thread>     threads;
+  threads.reserve(kThreads);
+  for (int t = 0; t < kThreads; t++) {
+    // half start from the subclass, half from the superclass it links
+    threads.emplace_back([this, &derived, &base, t] {
+      if (t % 2 == 0) {
+        derived[t] = loader_->loadClass("tests.data.java.KlassTestDerived");
+        base[t]    = loader_->loadClass("tests.data.java.KlassTestBase");
+      } else {
+        base[t]    = loader_->loadClass("tests.data.java.KlassTestBase");
+        derived[t] = loader_->loadClass("tests.data.java.KlassTestDerived");
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  ASSERT_NE(derived[0], nullptr);
+  EXPECT_EQ(derived[0]->getSuperClass(), base[0]);
+  for (int t = 1; t < kThreads; t++) {
+    EXPECT_EQ(derived[t], derived[0]);
+    EXPECT_EQ(base[t], base[0]);
+  }
+  EXPECT_EQ(
+    runtime::MethodArea::getInstance().getClass({loader_.get(), "tests.data.java.KlassTestBase"}),
+    base[0]);
+}
+
+TEST_F(ClassLoaderTest, SerialLoading) {
+  // the loader reads the option when it first loads a class
+  runtime::VMOptions::getInstance().parallel_class_loading = false;
+  auto* derived = loader_->loadClass("tests.data.java.KlassTestDerived");
+  runtime::VMOptions::getInstance().reset();
+
+  ASSERT_NE(derived, nullptr);
+  EXPECT_EQ(derived->getSuperClass(), loader_->loadClass("tests.data.java.KlassTestBase"));
+}
@@ -0,0 +1,150 @@
+#include "class_loader/class_prefetcher.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "class_loader/class_file_parser.h"
+#include "class_loader/classpath_index.h"
+
+using namespace jvm;
+
+namespace {
+
+class ClassPrefetcherTest : public ::testing::Test {
+ protected:
+  // Parses from the test classpath, counting the classes it is asked for
+  std::unique_ptr<class_loader::ClassFile> fetch(const std::string& name) {
+    {
+      std::lock_guard lock(mutex_);
+      fetches_[name]++;
+    }
+    auto bytes = classpath_.read(name);
+    if (!bytes.has_value()) {
+      return nullptr;
+    }
+    auto class_file    = class_loader::ClassFileParser(bytes->getBytes()).parse();
+    class_file->source = std::move(*bytes);
+    return class_file;
+  }
+
+  class_loader::ClassPrefetcher::Fetch fetcher() {
+    return [this](const std::string& name) { return fetch(name); };
+  }
+
+  int fetchCount(const std::string& name) {
+    std::lock_guard lock(mutex_);
+    return fetches_.contains(name) ? fetches_.at(name) : 0;
+  }
+
+  // Waits until a worker has started on `name`
+  bool waitForFetch(const std::string& name) {
+    for (int i = 0; i < 1000; i++) {
+      if (fetchCount(name) > 0) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+
+  class_loader::ClasspathIndex classpath_{{TEST_CLASS_PATH}};
+  std::mutex                   mutex_;
+  std::map<std::string, int>   fetches_;
+};
+
+}  // namespace
+
+TEST_F(ClassPrefetcherTest, ParsesSupertypes) {
+  auto derived = fetch("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+
+  class_loader::ClassPrefetcher prefetcher(fetcher());
+  prefetcher.submit(*derived);
+  ASSERT_TRUE(waitForFetch("tests.data.java.KlassTestBase"));
+
+  // a worker has it: take() waits for the parse to finish
+  auto base = prefetcher.take("tests.data.java.KlassTestBase");
+  ASSERT_NE(base, nullptr);
+  EXPECT_EQ(base->constant_pool.getClassName(base->this_class_index),
+            "tests/data/java/KlassTestBase");
+  // handed over once
+  EXPECT_EQ(prefetcher.take("tests.data.java.KlassTestBase"), nullptr);
+}
+
+TEST_F(ClassPrefetcherTest, UnknownAndMissingClasses) {
+  auto derived = fetch("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+
+  class_loader::ClassPrefetcher prefetcher(fetcher());
+  // never submitted
+  EXPECT_EQ(prefetcher.take("tests.data.java.HelloWorld"), nullptr);
+  // KlassTestBase refers to java.lang.Object, which the test classpath does not have
+  prefetcher.submit(*derived);
+  ASSERT_TRUE(waitForFetch("java.lang.Object"));
+  EXPECT_EQ(prefetcher.take("java.lang.Object"), nullptr);
+}
+
+TEST_F(ClassPrefetcherTest, EachClassFetchedOnce) {
+  auto derived = fetch("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+  {
+    class_loader::ClassPrefetcher prefetcher(fetcher());
+    for (int i = 0; i < 10; i++) {
+      prefetcher.submit(*derived);
+    }
+    ASSERT_TRUE(waitForFetch("java.lang.Object"));
+  }
+
+  std::lock_guard lock(mutex_);
+  for (const auto& [name, count] : fetches_) {
+    EXPECT_EQ(count, 1) << name;
+  }
+}
+
+TEST_F(ClassPrefetcherTest, OnlySupertypesAreFetched) {
+  auto hello = fetch("tests.data.java.HelloWorld");
+  ASSERT_NE(hello, nullptr);
+
+  class_loader::ClassPrefetcher prefetcher(fetcher());
+  prefetcher.submit(*hello);
+  ASSERT_TRUE(waitForFetch("java.lang.Object"));
+  // main() refers to System and PrintStream, which are resolved only when it runs
+  EXPECT_EQ(fetchCount("java.lang.System"), 0);
+  EXPECT_EQ(fetchCount("java.io.PrintStream"), 0);
+}
+
+TEST_F(ClassPrefetcherTest, ReleaseDropsUntakenClasses) {
+  auto derived = fetch("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+
+  class_loader::ClassPrefetcher prefetcher(fetcher());
+  prefetcher.submit(*derived);
+  // Object is queued once KlassTestBase is parsed
+  ASSERT_TRUE(waitForFetch("java.lang.Object"));
+  EXPECT_GT(prefetcher.getPendingCount(), 0);
+
+  prefetcher.release();
+  EXPECT_EQ(prefetcher.take("tests.data.java.KlassTestBase"), nullptr);
+  // a class still being parsed is freed by its worker
+  for (int i = 0; i < 1000 && prefetcher.getPendingCount() > 0; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(prefetcher.getPendingCount(), 0);
+}
+
+TEST_F(ClassPrefetcherTest, ReleaseKeepsOtherThreadsClasses) {
+  auto derived = fetch("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+
+  class_loader::ClassPrefetcher prefetcher(fetcher());
+  prefetcher.submit(*derived);
+  ASSERT_TRUE(waitForFetch("java.lang.Object"));
+  std::thread([&prefetcher] { prefetcher.release(); }).join();
+  EXPECT_NE(prefetcher.take("tests.data.java.KlassTestBase"), nullptr);
+}
@@ -0,0 +1,91 @@
+#include "class_loader/classpath_index.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <string>
+
+using namespace jvm;
+
+namespace {
+
+class ClasspathIndexTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // two roots sharing a package: `first` has HelloWorld, `second` has HelloWorld and
+    // KlassTestData
+    auto classes = std::filesystem::path(TEST_CLASS_PATH) / "tests/data/java";
+    base_        = std::filesystem::temp_directory_path() / "classpath_index_test";
+    std::filesystem::remove_all(base_);
+    for (const auto* root : {"first", "second"}) {
+      std::filesystem::create_directories(base_ / root / "tests/data/java");
+    }
+    std::filesystem::copy_file(classes / "HelloWorld.class",
+                               base_ / "first/tests/data/java/HelloWorld.class");
+    std::filesystem::copy_file(classes / "HelloWorld.class",
+                               base_ / "second/tests/data/java/HelloWorld.class");
+    std::filesystem::copy_file(classes / "KlassTestData.class",
+                               base_ / "second/tests/data/java/KlassTestData.class");
+  }
+
+  void TearDown() override { std::filesystem::remove_all(base_); }
+
+  std::string root(const char* name) const { return (base_ / name).string(); }
+
+  std::filesystem::path base_;
+};
+
+}  // namespace
+
+TEST_F(ClasspathIndexTest, FindsClassesInAnyRoot) {
+  class_loader::ClasspathIndex index({root("first"), root("second")});
+
+  auto hello_world = index.read("tests.data.java.HelloWorld");
+  ASSERT_TRUE(hello_world.has_value());
+  EXPECT_EQ(hello_world->getBytes().size(),
+            std::filesystem::file_size(base_ / "first/tests/data/java/HelloWorld.class"));
+  EXPECT_TRUE(index.read("tests.data.java.KlassTestData").has_value());
+
+  // both lookups were answered from one indexing of the package
+  EXPECT_EQ(index.getIndexedPackageCount(), 1U);
+  EXPECT_EQ(index.getNegativeCacheSize(), 0U);
+}
+
+TEST_F(ClasspathIndexTest, EarlierRootWins) {
+  // make the copies distinguishable by size
+  std::filesystem::resize_file(base_ / "second/tests/data/java/HelloWorld.class", 4);
+
+  class_loader::ClasspathIndex first_then_second({root("first"), root("second")});
+  auto                         from_first = first_then_second.read("tests.data.java.HelloWorld");
+  ASSERT_TRUE(from_first.has_value());
+  EXPECT_GT(from_first->getBytes().size(), 4U);
+
+  class_loader::ClasspathIndex second_then_first({root("second"), root("first")});
+  auto                         from_second = second_then_first.read("tests.data.java.HelloWorld");
+  ASSERT_TRUE(from_second.has_value());
+  EXPECT_EQ(from_second->getBytes().size(), 4U);
+}
+
+TEST_F(ClasspathIndexTest, MissesAreCached) {
+  class_loader::ClasspathIndex index({root("first"), root("second"), root("missing")});
+
+  EXPECT_FALSE(index.read("tests.data.java.Missing").has_value());
+  EXPECT_FALSE(index.read("no.such.pkg.Missing").has_value());
+  EXPECT_EQ(index.getNegativeCacheSize(), 2U);
+
+  // a class file that appears later is not seen: the package was indexed already and the
+  // name is cached as absent
+  std::filesystem::copy_file(base_ / "first/tests/data/java/HelloWorld.class",
+                             base_ / "first/tests/data/java/Missing.class");
+  EXPECT_FALSE(index.read("tests.data.java.Missing").has_value());
+  EXPECT_EQ(index.getIndexedPackageCount(), 2U);
+}
+
+TEST_F(ClasspathIndexTest, RemovedFileBecomesMiss) {
+  class_loader::ClasspathIndex index({root("second")});
+  EXPECT_TRUE(index.read("tests.data.java.HelloWorld").has_value());
+
+  std::filesystem::remove(base_ / "second/tests/data/java/KlassTestData.class");
+  EXPECT_FALSE(index.read("tests.data.java.KlassTestData").has_value());
+  EXPECT_EQ(index.getNegativeCacheSize(), 1U);
+}
@@ -0,0 +1,184 @@
+#include "class_loader/jar_file.h"
+
+#include <gtest/gtest.h>
+#include <zlib.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "class_loader/class_loader.h"
+#include "runtime/klass.h"
+#include "runtime/method_area.h"
+
+using namespace jvm;
+
+namespace {
+
+std::vector<U1> readWholeFile(const std::string& path) {
+  std::ifstream file(path, std::ios::binary);
+  return {std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()};
+}
+
+void putU2(std::vector<U1>& out, U2 value) {
+  out.push_back(static_cast<U1>(value));
+  out.push_back(static_cast<U1>(value >> 8));
+}
+
+void putU4(std::vector<U1>& out, U4 value) {
+  putU2(out, static_cast<U2>(value));
+  putU2(out, static_cast<U2>(value >> 16));
+}
+
+std::vector<U1> rawDeflate(const std::vector<U1>& data) {
+  z_stream stream{};
+  deflateInit2(&stream, Z_BEST_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+  std::vector<U1> out(deflateBound(&stream, data.size()));
+  stream.next_in   = const_cast<U1*>(data.data());  // NOLINT(*-const-cast)
+  stream.avail_in  = data.size();
+  stream.next_out  = out.data();
+  stream.avail_out = out.size();
+  deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+  return out;
+}
+
+// Minimal ZIP writer: local headers, central directory and end record, no extra fields
+class ZipWriter {
+ public:
+  void add(const std::string& name, const std::vector<U1>& data, bool deflated) {
+    std::vector<U1> body   = deflated ? rawDeflate(data) : data;
+    U2              method = deflated ? Z_DEFLATED : 0;
+    U4              crc    = crc32(0, data.data(), data.size());
+    U4              offset = archive_.size();
+
+    putU4(archive_, 0x04034B50);
+    putU2(archive_, 20);  // version needed
+    putU2(archive_, 0);   // flags
+    putU2(archive_, method);
+    putU4(archive_, 0);  // time and date
+    putU4(archive_, crc);
+    putU4(archive_, body.size());
+    putU4(archive_, data.size());
+    putU2(archive_, name.size());
+    putU2(archive_, 0);  // extra length
+    archive_.insert(archive_.end(), name.begin(), name.end());
+    archive_.insert(archive_.end(), body.begin(), body.end());
+
+    putU4(central_, 0x02014B50);
+    putU2(central_, 20);  // version made by
+    putU2(central_, 20);  // version needed
+    putU2(central_, 0);   // flags
+    putU2(central_, method);
+    putU4(central_, 0);  // time and date
+    putU4(central_, crc);
+    putU4(central_, body.size());
+    putU4(central_, data.size());
+    putU2(central_, name.size());
+    putU2(central_, 0);  // extra length
+    putU2(central_, 0);  // comment length
+    putU2(central_, 0);  // disk number
+    putU2(central_, 0);  // internal attributes
+    putU4(central_, 0);  // external attributes
+    putU4(central_, offset);
+    central_.insert(central_.end(), name.begin(), name.end());
+    count_++;
+  }
+
+  void write(const std::filesystem::path& path) const {
+    std::vector<U1> out = archive_;
+    out.insert(out.end(), central_.begin(), central_.end());
+    putU4(out, 0x06054B50);
+    putU2(out, 0);  // disk number
+    putU2(out, 0);  // disk with the central directory
+    putU2(out, count_);
+    putU2(out, count_);
+    putU4(out, central_.size());
+    putU4(out, archive_.size());
+    putU2(out, 0);  // comment length
+    std::ofstream(path, std::ios::binary)
+      .write(reinterpret_cast<const char*>(out.data()),  // NOLINT(*-reinterpret-cast)
+             static_cast<std::streamsize>(out.size()));
+  }
+
+ private:
+  std::vector<U1> archive_;
+  std::vector<U1> central_;
+  U2              count_{0};
+};
+
+class JarFileTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    std::string classes = std::string(TEST_CLASS_PATH) + "/tests/data/java/";
+    hello_world_        = readWholeFile(classes + "HelloWorld.class");
+    klass_test_data_    = readWholeFile(classes + "KlassTestData.class");
+
+    ZipWriter zip;
+    zip.add("tests/data/java/HelloWorld.class", hello_world_, false);
+    zip.add("tests/data/java/KlassTestData.class", klass_test_data_, true);
+    jar_path_ = std::filesystem::temp_directory_path() / "jar_file_test.jar";
+    zip.write(jar_path_);
+
+    runtime::MethodArea::getInstance().reset();
+  }
+
+  void TearDown() override { std::filesystem::remove(jar_path_); }
+
+  std::vector<U1>       hello_world_;
+  std::vector<U1>       klass_test_data_;
+  std::filesystem::path jar_path_;
+};
+
+}  // namespace
+
+TEST_F(JarFileTest, IndexesCentralDirectory) {
+  auto jar = class_loader::JarFile::open(jar_path_.string());
+  ASSERT_NE(jar, nullptr);
+  EXPECT_EQ(jar->size(), 2U);
+  EXPECT_TRUE(jar->contains("tests/data/java/HelloWorld.class"));
+  EXPECT_TRUE(jar->contains("tests/data/java/KlassTestData.class"));
+  EXPECT_FALSE(jar->contains("tests/data/java/Missing.class"));
+  EXPECT_FALSE(jar->read("tests/data/java/Missing.class").has_value());
+}
+
+TEST_F(JarFileTest, ReadsStoredAndDeflatedEntries) {
+  auto jar = class_loader::JarFile::open(jar_path_.string());
+  ASSERT_NE(jar, nullptr);
+
+  auto stored = jar->read("tests/data/java/HelloWorld.class");
+  ASSERT_TRUE(stored.has_value());
+  EXPECT_TRUE(std::ranges::equal(stored->getBytes(), hello_world_));
+
+  auto deflated = jar->read("tests/data/java/KlassTestData.class");
+  ASSERT_TRUE(deflated.has_value());
+  EXPECT_TRUE(std::ranges::equal(deflated->getBytes(), klass_test_data_));
+}
+
+TEST_F(JarFileTest, RejectsNonArchives) {
+  EXPECT_EQ(class_loader::JarFile::open(jar_path_.string() + ".missing"), nullptr);
+
+  auto not_zip = std::filesystem::temp_directory_path() / "jar_file_test_not_zip.jar";
+  std::ofstream(not_zip) << "not a zip archive";
+  EXPECT_THROW(class_loader::JarFile::open(not_zip.string()), std::runtime_error);
+  std::filesystem::remove(not_zip);
+}
+
+TEST_F(JarFileTest, ClassLoaderSearchesJar) {
+  class_loader::ClassLoader loader(nullptr, {jar_path_.string()});
+
+  auto* hello_world = loader.loadClass("tests.data.java.HelloWorld");
+  ASSERT_NE(hello_world, nullptr);
+  EXPECT_EQ(hello_world->getClassLoader(), &loader);
+
+  auto* klass_test_data = loader.loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass_test_data, nullptr);
+  EXPECT_NE(klass_test_data->findMethod("add", "(II)I"), nullptr);
+
+  EXPECT_THROW(loader.loadClass("tests.data.java.Missing"), std::runtime_error);
+}
@@ -0,0 +1,81 @@
+#include "class_loader/mapped_file.h"
+
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "class_loader/class_file.h"
+#include "class_loader/class_file_parser.h"
+
+using namespace jvm;
+
+namespace {
+
+std::string helloWorldPath() {
+  return std::string(TEST_CLASS_PATH) + "/tests/data/java/HelloWorld.class";
+}
+
+}  // namespace
+
+TEST(MappedFileTest, MapsWholeFile) {
+  auto file = class_loader::MappedFile::open(helloWorldPath());
+  ASSERT_TRUE(file.has_value());
+  EXPECT_EQ(file->size(), std::filesystem::file_size(helloWorldPath()));
+
+  auto bytes = file->getBytes();
+  ASSERT_GE(bytes.size(), 4U);
+  EXPECT_EQ(bytes[0], 0xCA);
+  EXPECT_EQ(bytes[1], 0xFE);
+  EXPECT_EQ(bytes[2], 0xBA);
+  EXPECT_EQ(bytes[3], 0xBE);
+}
+
+TEST(MappedFileTest, MissingFileOrDirectory) {
+  EXPECT_FALSE(class_loader::MappedFile::open(helloWorldPath() + ".missing").has_value());
+  EXPECT_FALSE(class_loader::MappedFile::open(TEST_CLASS_PATH).has_value());
+}
+
+TEST(MappedFileTest, EmptyFile) {
+  auto path = std::filesystem::temp_directory_path() / "mapped_file_test_empty";
+  std::ofstream(path).close();
+  auto file = class_loader::MappedFile::open(path.string());
+  ASSERT_TRUE(file.has_value());
+  EXPECT_EQ(file->size(), 0U);
+  EXPECT_TRUE(file->getBytes().empty());
+  std::filesystem::remove(path);
+}
+
+TEST(MappedFileTest, MoveTransfersMapping) {
+  auto file = class_loader::MappedFile::open(helloWorldPath());
+  ASSERT_TRUE(file.has_value());
+  const auto* data = file->getBytes().data();
+
+  class_loader::MappedFile moved = std::move(file.value());
+  EXPECT_EQ(moved.getBytes().data(), data);
+  EXPECT_EQ(file->size(), 0U);  // NOLINT(bugprone-use-after-move)
+}
+
+TEST(MappedFileTest, ParsesInPlace) {
+  auto file = class_loader::MappedFile::open(helloWorldPath());
+  ASSERT_TRUE(file.has_value());
+
+  class_loader::ClassFileParser parser(file->getBytes());
+  auto                          class_file = parser.parse();
+  EXPECT_EQ(class_file->constant_pool.getClassName(class_file->this_class_index),
+            "tests/data/java/HelloWorld");
+
+  // uninterpreted attributes are views into the mapping, not copies
+  auto bytes = file->getBytes();
+  class_file->source = class_loader::ClassBytes(
+    std::make_shared<const class_loader::MappedFile>(std::move(file.value())), bytes);
+  for (auto& attribute : class_file->attributes.getAttributes()) {
+    auto* generic = dynamic_cast<class_loader::GenericAttribute*>(attribute.get());
+    if (generic != nullptr && !generic->info.empty()) {
+      EXPECT_GE(generic->info.data(), bytes.data());
+      EXPECT_LE(generic->info.data() + generic->info.size(), bytes.data() + bytes.size());
+    }
+  }
+}
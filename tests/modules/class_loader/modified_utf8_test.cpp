@@ -0,0 +1,78 @@
+#include "class_loader/modified_utf8.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "class_loader/byte_reader.hpp"
+#include "class_loader/constant_pool.h"
+
+using namespace jvm;
+
+namespace {
+
+std::span<const U1> bytesOf(std::string_view string) {
+  return {reinterpret_cast<const U1*>(string.data()), string.size()};  // NOLINT
+}
+
+// long enough to be scanned a vector at a time
+const std::string kAscii = "java/lang/invoke/MethodHandleNatives$CallSiteContext.linkCallSite";
+
+}  // namespace
+
+TEST(ModifiedUtf8Test, AcceptsWellFormed) {
+  EXPECT_TRUE(class_loader::isValidModifiedUtf8(bytesOf("")));
+  EXPECT_TRUE(class_loader::isValidModifiedUtf8(bytesOf(kAscii)));
+  EXPECT_TRUE(class_loader::isValidModifiedUtf8(bytesOf("a\xC0\x80" "b")));         // U+0000
+  EXPECT_TRUE(class_loader::isValidModifiedUtf8(bytesOf(kAscii + "caf\xC3\xA9")));  // U+00E9
+  EXPECT_TRUE(class_loader::isValidModifiedUtf8(bytesOf("\xE2\x82\xAC")));          // U+20AC
+  // U+1F600 as its two surrogates
+  EXPECT_TRUE(class_loader::isValidModifiedUtf8(bytesOf("\xED\xA0\xBD\xED\xB8\x80")));
+}
+
+TEST(ModifiedUtf8Test, RejectsMalformed) {
+  EXPECT_FALSE(class_loader::isValidModifiedUtf8(bytesOf(std::string("a\0b", 3))));
+  auto with_nul = kAscii;
+  with_nul[40]  = '\0';
+  EXPECT_FALSE(class_loader::isValidModifiedUtf8(bytesOf(with_nul)));
+  EXPECT_FALSE(class_loader::isValidModifiedUtf8(bytesOf("\x80")));              // continuation
+  EXPECT_FALSE(class_loader::isValidModifiedUtf8(bytesOf("\xF0\x9F\x98\x80")));  // 4-byte form
+  EXPECT_FALSE(class_loader::isValidModifiedUtf8(bytesOf(kAscii + "\xE2\x82")));  // truncated
+  EXPECT_FALSE(class_loader::isValidModifiedUtf8(bytesOf("\xC3" "a")));
+}
+
+TEST(ModifiedUtf8Test, DecodesToUtf16) {
+  std::u16string ascii(kAscii.begin(), kAscii.end());
+  EXPECT_EQ(class_loader::modifiedUtf8ToUtf16(bytesOf(kAscii)), ascii);
+  EXPECT_EQ(class_loader::modifiedUtf8ToUtf16(bytesOf(kAscii + "\xC0\x80\xE2\x82\xAC")),
+            ascii + u'\0' + u'€');
+  EXPECT_EQ(class_loader::modifiedUtf8ToUtf16(bytesOf("\xED\xA0\xBD\xED\xB8\x80")),
+            u"\U0001F600");
+  EXPECT_THROW(class_loader::modifiedUtf8ToUtf16(bytesOf("\xC3")), std::runtime_error);
+}
+
+TEST(ModifiedUtf8Test, DecodesToLatin1) {
+  EXPECT_EQ(class_loader::modifiedUtf8ToLatin1(bytesOf(kAscii)), kAscii);
+  EXPECT_EQ(class_loader::modifiedUtf8ToLatin1(bytesOf("caf\xC3\xA9\xC0\x80")),
+            std::string("caf\xE9\0", 5));
+  // U+20AC does not fit in a byte
+  EXPECT_EQ(class_loader::modifiedUtf8ToLatin1(bytesOf("\xE2\x82\xAC")), std::nullopt);
+  EXPECT_THROW(class_loader::modifiedUtf8ToLatin1(bytesOf("\xE2\x82\xAC\x80")),
+               std::runtime_error);
+}
+
+TEST(ModifiedUtf8Test, ConstantPoolRejectsMalformedUtf8) {
+  // tag 1 (Utf8), length, bytes
+  std::vector<U1> valid = {0x01, 0x00, 0x03, 'a', 0xC0, 0x80};
+  class_loader::ConstantPool pool(3);
+  class_loader::ByteReader   valid_reader(valid);
+  pool.readEntry(1, valid_reader);
+  EXPECT_EQ(pool.getUtf8String(1), "a\xC0\x80");  // symbols keep the class file bytes
+
+  std::vector<U1>          malformed = {0x01, 0x00, 0x02, 'a', 0x00};
+  class_loader::ByteReader malformed_reader(malformed);
+  EXPECT_THROW(pool.readEntry(2, malformed_reader), std::runtime_error);
+}
@@ -0,0 +1,204 @@
+#include "class_loader/shared_archive.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "class_loader/class_loader.h"
+#include "runtime/klass.h"
+#include "runtime/method_area.h"
+#include "runtime/vm_options.h"
+
+using namespace jvm;
+using namespace std::chrono_literals;
+
+namespace {
+
+class SharedArchiveTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    // a classpath of its own, so the classes can be removed after dumping
+    base_ = std::filesystem::temp_directory_path() / "shared_archive_test";
+    std::filesystem::remove_all(base_);
+    auto from = std::filesystem::path(TEST_CLASS_PATH) / "tests/data/java";
+    auto to   = base_ / "classes/tests/data/java";
+    std::filesystem::create_directories(to);
+    for (const auto* name : {"KlassTestBase", "KlassTestDerived", "KlassTestData"}) {
+      std::string file_name = std::string(name) + ".class";
+      std::filesystem::copy_file(from / file_name, to / file_name);
+    }
+    classpath_ = {(base_ / "classes").string()};
+    archive_   = (base_ / "app.jsa").string();
+    runtime::MethodArea::getInstance().reset();
+  }
+
+  void TearDown() override {
+    runtime::VMOptions::getInstance().reset();
+    std::filesystem::remove_all(base_);
+  }
+
+  // Loads the test classes with -Xshare:dump and writes the archive
+  void dump() {
+    runtime::VMOptions::getInstance().share_mode = runtime::ShareMode::kDump;
+    class_loader::ClassLoader loader(nullptr, classpath_);
+    loader.loadClass("tests.data.java.KlassTestDerived");
+    loader.loadClass("tests.data.java.KlassTestData");
+    loader.dumpSharedArchive(archive_);
+    runtime::VMOptions::getInstance().reset();
+  }
+
+  // Replaces the class files with zeros of the same size and modification time, so that the
+  // archive still matches the classpath but the classes can only come from it. Classes already
+  // mapped keep the bytes of the files replaced.
+  void blankClassFiles() {
+    for (const auto& file : std::filesystem::recursive_directory_iterator(base_ / "classes")) {
+      if (file.is_regular_file()) {
+        auto modified_time = file.last_write_time();
+        auto blank         = base_ / "blank";
+        std::ofstream(blank, std::ios::binary) << std::string(file.file_size(), '\0');
+        std::filesystem::last_write_time(blank, modified_time);
+        std::filesystem::rename(blank, file.path());
+      }
+    }
+  }
+
+  void useArchive(runtime::ShareMode mode) {
+    runtime::VMOptions::getInstance().share_mode          = mode;
+    runtime::VMOptions::getInstance().shared_archive_file = archive_;
+  }
+
+  std::filesystem::path    base_;
+  std::vector<std::string> classpath_;
+  std::string              archive_;
+};
+
+}  // namespace
+
+TEST_F(SharedArchiveTest, DumpsLoadedClasses) {
+  dump();
+  auto archive = class_loader::SharedArchive::open(archive_);
+  ASSERT_NE(archive, nullptr);
+  EXPECT_EQ(archive->getClasspath(), classpath_);
+  EXPECT_EQ(archive->size(), 3U);
+  EXPECT_TRUE(archive->contains("tests/data/java/KlassTestBase"));
+  EXPECT_TRUE(archive->contains("tests/data/java/KlassTestDerived"));
+  EXPECT_TRUE(archive->contains("tests/data/java/KlassTestData"));
+  EXPECT_FALSE(archive->restore("tests/data/java/HelloWorld").has_value());
+}
+
+TEST_F(SharedArchiveTest, DumpsWhenLoaderIsDestroyed) {
+  runtime::VMOptions::getInstance().share_mode          = runtime::ShareMode::kDump;
+  runtime::VMOptions::getInstance().shared_archive_file = archive_;
+  {
+    class_loader::ClassLoader loader(nullptr, classpath_);
+    loader.loadClass("tests.data.java.KlassTestData");
+  }
+  auto archive = class_loader::SharedArchive::open(archive_);
+  ASSERT_NE(archive, nullptr);
+  EXPECT_TRUE(archive->matchesClasspath(classpath_));
+  EXPECT_TRUE(archive->contains("tests/data/java/KlassTestData"));
+}
+
+TEST_F(SharedArchiveTest, RestoresWithoutClassFiles) {
+  // the reference: the same class parsed from its class file
+  class_loader::ClassLoader reference_loader(nullptr, classpath_);
+  auto* reference = reference_loader.loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(reference, nullptr);
+
+  dump();
+  blankClassFiles();
+
+  useArchive(runtime::ShareMode::kOn);
+  class_loader::ClassLoader loader(nullptr, classpath_);
+  auto* klass = loader.loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+  EXPECT_EQ(klass->getName(), reference->getName());
+  EXPECT_EQ(klass->getAccessFlags().getFlags(), reference->getAccessFlags().getFlags());
+  EXPECT_EQ(klass->getInstanceSlotCount(), reference->getInstanceSlotCount());
+  EXPECT_EQ(klass->getStaticSlotCount(), reference->getStaticSlotCount());
+
+  ASSERT_EQ(klass->getMethods().size(), reference->getMethods().size());
+  for (const auto& expected : reference->getMethods()) {
+    auto* method = klass->findMethod(expected.getNameSymbol(), expected.getDescriptorSymbol());
+    ASSERT_NE(method, nullptr) << expected.getName();
+    EXPECT_EQ(method->getOwnerKlass(), klass);
+    EXPECT_TRUE(std::ranges::equal(method->getCode(), expected.getCode()));
+    EXPECT_EQ(method->getMaxStack(), expected.getMaxStack());
+    EXPECT_EQ(method->getMaxLocals(), expected.getMaxLocals());
+    EXPECT_EQ(method->getArgSlotCount(), expected.getArgSlotCount());
+  }
+  auto* field = klass->findField("sd", "D");
+  ASSERT_NE(field, nullptr);
+  EXPECT_TRUE(field->isStatic());
+  EXPECT_EQ(field->getSlotIndex(), reference->findField("sd", "D")->getSlotIndex());
+
+  // the constant pool resolves as if parsed
+  auto& rcp = klass->getRuntimeConstantPool();
+  EXPECT_EQ(rcp.resolveClass(klass->getClassFile()->this_class_index), klass);
+}
+
+TEST_F(SharedArchiveTest, LinksArchivedSuperclass) {
+  dump();
+  blankClassFiles();
+
+  useArchive(runtime::ShareMode::kOn);
+  class_loader::ClassLoader loader(nullptr, classpath_);
+  auto* derived = loader.loadClass("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+  ASSERT_NE(derived->getSuperClass(), nullptr);
+  EXPECT_EQ(derived->getSuperClass(), loader.loadClass("tests.data.java.KlassTestBase"));
+}
+
+TEST_F(SharedArchiveTest, OtherClasspathIsNotServed) {
+  dump();
+
+  useArchive(runtime::ShareMode::kAuto);
+  std::vector<std::string>  other = {TEST_CLASS_PATH};
+  class_loader::ClassLoader loader(nullptr, other);
+  std::filesystem::remove_all(base_ / "classes");
+  // found on its own classpath, not in the archive
+  EXPECT_NE(loader.loadClass("tests.data.java.KlassTestData"), nullptr);
+
+  useArchive(runtime::ShareMode::kOn);
+  EXPECT_THROW(class_loader::ClassLoader(nullptr, other), std::runtime_error);
+}
+
+TEST_F(SharedArchiveTest, ChangedClassFileIsNotServed) {
+  dump();
+  auto class_file = base_ / "classes/tests/data/java/KlassTestData.class";
+  std::filesystem::last_write_time(class_file,
+                                   std::filesystem::last_write_time(class_file) + 1h);
+  auto archive = class_loader::SharedArchive::open(archive_);
+  ASSERT_NE(archive, nullptr);
+  EXPECT_FALSE(archive->matchesClasspath(classpath_));
+
+  useArchive(runtime::ShareMode::kAuto);
+  {
+    // the archive is ignored: the class comes from its class file
+    class_loader::ClassLoader loader(nullptr, classpath_);
+    std::filesystem::remove(class_file);
+    EXPECT_THROW(loader.loadClass("tests.data.java.KlassTestData"), std::runtime_error);
+  }
+
+  useArchive(runtime::ShareMode::kOn);
+  EXPECT_THROW(class_loader::ClassLoader(nullptr, classpath_), std::runtime_error);
+}
+
+TEST_F(SharedArchiveTest, UnusableArchive) {
+  std::ofstream(archive_) << "not an archive";
+
+  useArchive(runtime::ShareMode::kAuto);
+  class_loader::ClassLoader loader(nullptr, classpath_);
+  EXPECT_NE(loader.loadClass("tests.data.java.KlassTestData"), nullptr);
+
+  useArchive(runtime::ShareMode::kOn);
+  EXPECT_THROW(class_loader::ClassLoader(nullptr, classpath_), std::runtime_error);
+  std::filesystem::remove(archive_);
+  EXPECT_THROW(class_loader::ClassLoader(nullptr, classpath_), std::runtime_error);
+}
@@ -45,6 +45,11 @@ TEST_F(InterpreterArithmeticTest, IDIV_DivideByZero) {
   EXPECT_THROW(executeStaticMethod<Jint>(kClassName, "testIDIV", 10, 0), std::runtime_error);
 }
 
+TEST_F(InterpreterArithmeticTest, IDIV_Overflow) {
+  // MIN_VALUE / -1 overflows back to MIN_VALUE instead of trapping
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testIDIV", INT32_MIN, -1), INT32_MIN);
+}
+
 TEST_F(InterpreterArithmeticTest, IREM_Basic) {
   EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testIREM", 20, 5), 0);
   EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testIREM", 21, 5), 1);
@@ -80,6 +85,10 @@ TEST_F(InterpreterArithmeticTest, LMUL_Basic) {
   EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLMUL", -5LL, 6LL), -30LL);
 }
 
+TEST_F(InterpreterArithmeticTest, IREM_Overflow) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testIREM", INT32_MIN, -1), 0);
+}
+
 TEST_F(InterpreterArithmeticTest, LDIV_Basic) {
   EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLDIV", 20LL, 5LL), 4LL);
   EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLDIV", 21LL, 5LL), 4LL);
@@ -89,6 +98,10 @@ TEST_F(InterpreterArithmeticTest, LDIV_DivideByZero) {
   EXPECT_THROW(executeStaticMethod<Jlong>(kClassName, "testLDIV", 10LL, 0LL), std::runtime_error);
 }
 
+TEST_F(InterpreterArithmeticTest, LDIV_Overflow) {
+  EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLDIV", INT64_MIN, Jlong{-1}), INT64_MIN);
+}
+
 TEST_F(InterpreterArithmeticTest, LREM_Basic) {
   EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLREM", 20LL, 5LL), 0LL);
   EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLREM", 21LL, 5LL), 1LL);
@@ -98,6 +111,10 @@ TEST_F(InterpreterArithmeticTest, LREM_DivideByZero) {
   EXPECT_THROW(executeStaticMethod<Jlong>(kClassName, "testLREM", 10LL, 0LL), std::runtime_error);
 }
 
+TEST_F(InterpreterArithmeticTest, LREM_Overflow) {
+  EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLREM", INT64_MIN, Jlong{-1}), 0);
+}
+
 TEST_F(InterpreterArithmeticTest, LNEG_Basic) {
   EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLNEG", 10LL), -10LL);
   EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testLNEG", -10LL), 10LL);
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+#include "engine/opcode.h"
+#include "interpreter_test_base.h"
+#include "runtime/klass.h"
+#include "runtime/method.h"
+
+using namespace jvm;
+
+namespace {
+
+class InterpreterClassInitTest : public InterpreterTestBase {
+ public:
+  static constexpr const char* kClassName = "tests.data.java.ClassInitTest";
+
+  runtime::Klass* loadNested(const char* name) {
+    return loader_->loadClass(std::string(kClassName) + "$" + name);
+  }
+
+  Jint run(const char* method_name) { return executeStaticMethod<Jint>(kClassName, method_name); }
+  Jint runFast(const char* method_name) {
+    return executeStaticMethod<Jint, engine::Fast>(kClassName, method_name);
+  }
+
+  bool hasOpcode(const char* method_name, U1 opcode) {
+    auto code = loader_->loadClass(kClassName)->findMethod(method_name, "()I")->getCode();
+    return std::ranges::find(code, opcode) != code.end();
+  }
+};
+
+// ============================================================================
+// Initialization
+// ============================================================================
+
+TEST_F(InterpreterClassInitTest, LinkedUntilFirstUse) {
+  auto* klass = loadNested("Counted");
+  EXPECT_EQ(klass->getState(), runtime::KlassState::kLinked);
+  EXPECT_EQ(run("readTwice"), 14);
+  EXPECT_EQ(klass->getState(), runtime::KlassState::kInitialized);
+}
+
+TEST_F(InterpreterClassInitTest, SuperclassFirst) {
+  EXPECT_EQ(run("initOrder"), 12);
+  EXPECT_EQ(run("initOrder"), 12);  // only once
+}
+
+TEST_F(InterpreterClassInitTest, RunsOnce) {
+  EXPECT_EQ(run("countedRuns"), 1);
+  EXPECT_EQ(runFast("countedRuns"), 1);
+}
+
+// An inlined static getter must not read its field before the class is initialized
+TEST_F(InterpreterClassInitTest, InvokeStaticInitializesCallee) {
+  EXPECT_EQ(runFast("callGetter"), 42);
+}
+
+TEST_F(InterpreterClassInitTest, FailedInitializationIsPermanent) {
+  EXPECT_EQ(run("initFailure"), 11);
+  EXPECT_EQ(loadNested("Failing")->getState(), runtime::KlassState::kError);
+}
+
+// JVMS §5.5 step 7: a class whose superclass fails to initialize is erroneous as well
+TEST_F(InterpreterClassInitTest, SubclassFailsWithItsSuperclass) {
+  EXPECT_EQ(run("subclassInitFailure"), 11);
+  EXPECT_EQ(loadNested("Failing")->getState(), runtime::KlassState::kError);
+  EXPECT_EQ(loadNested("FailingChild")->getState(), runtime::KlassState::kError);
+}
+
+TEST_F(InterpreterClassInitTest, SubclassOfErroneousClassFails) {
+  EXPECT_EQ(run("initFailure"), 11);
+  EXPECT_EQ(loadNested("FailingChild")->getState(), runtime::KlassState::kLinked);
+  EXPECT_EQ(run("subclassOfErroneous"), -1);
+  EXPECT_EQ(loadNested("FailingChild")->getState(), runtime::KlassState::kError);
+}
+
+TEST_F(InterpreterClassInitTest, ConcurrentFirstUse) {
+  auto* klass = loadNested("Counted");
+  loader_->loadClass(kClassName);
+
+  std::vector<Jint>        runs(8);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < runs.size(); i++) {
+    threads.emplace_back([&, i] { runs[i] = run("countedRuns"); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(std::ranges::all_of(runs, [](Jint count) { return count == 1; }));
+  EXPECT_TRUE(klass->isInitialized());
+}
+
+// ============================================================================
+// Quickening
+// ============================================================================
+
+TEST_F(InterpreterClassInitTest, FastQuickensPastTheBarrier) {
+  EXPECT_EQ(runFast("readTwice"), 14);
+  EXPECT_FALSE(hasOpcode("readTwice", engine::GETSTATIC));
+  EXPECT_TRUE(hasOpcode("readTwice", engine::GETSTATIC_QUICK));
+  // the quick form runs without the barrier, on any interpreter
+  EXPECT_EQ(run("readTwice"), 14);
+}
+
+TEST_F(InterpreterClassInitTest, CheckedKeepsTheBytecode) {
+  EXPECT_EQ(run("readTwice"), 14);
+  EXPECT_TRUE(hasOpcode("readTwice", engine::GETSTATIC));
+  EXPECT_FALSE(hasOpcode("readTwice", engine::GETSTATIC_QUICK));
+}
+
+// A failed class keeps its barrier, so every use raises NoClassDefFoundError
+TEST_F(InterpreterClassInitTest, FailureIsNotQuickened) {
+  EXPECT_EQ(runFast("initFailure"), 11);
+  EXPECT_TRUE(hasOpcode("initFailure", engine::GETSTATIC));
+}
+
+}  // namespace
@@ -0,0 +1,230 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+#include "interpreter_test_base.h"
+#include "runtime/throwable.h"
+#include "runtime/vm_options.h"
+
+using namespace jvm;
+
+namespace {
+
+class InterpreterExceptionTest : public InterpreterTestBase {
+ public:
+  static constexpr const char* kClassName = "tests.data.java.ExceptionTest";
+};
+
+// ============================================================================
+// Handler in the throwing frame
+// ============================================================================
+
+TEST_F(InterpreterExceptionTest, NoExceptionSkipsHandler) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchArithmetic", 10, 2), 5);
+}
+
+TEST_F(InterpreterExceptionTest, CatchArithmeticException) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchArithmetic", 10, 0), -1);
+}
+
+TEST_F(InterpreterExceptionTest, CatchBySuperclass) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchRuntimeException", 10, 0), -2);
+}
+
+TEST_F(InterpreterExceptionTest, CatchLongRemainder) {
+  EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "catchLongRemainder", Jlong{10}, Jlong{0}),
+            -4);
+}
+
+TEST_F(InterpreterExceptionTest, NestedHandlersSkipNonMatching) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "nestedHandlers", 10, 0), -6);
+}
+
+// ============================================================================
+// Unwinding through callee frames
+// ============================================================================
+
+TEST_F(InterpreterExceptionTest, CatchFromCallee) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchFromCallee", 10, 0), -3);
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchFromCallee", 10, 5), 2);
+}
+
+TEST_F(InterpreterExceptionTest, CatchRethrown) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchRethrown", 10, 0), -7);
+}
+
+TEST_F(InterpreterExceptionTest, ThrowNullRaisesNullPointerException) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "throwNull"), -8);
+}
+
+// ============================================================================
+// finally
+// ============================================================================
+
+TEST_F(InterpreterExceptionTest, FinallyRunsOnNormalExit) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "finallyCountAfter", 10, 2), 1);
+}
+
+TEST_F(InterpreterExceptionTest, FinallyRunsOnException) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "finallyCountAfter", 10, 0), 11);
+}
+
+TEST_F(InterpreterExceptionTest, RepeatedThrowsInLoop) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "countZeroDivisors", 100), 50);
+}
+
+// ============================================================================
+// Stack overflow
+// ============================================================================
+
+TEST_F(InterpreterExceptionTest, CatchStackOverflowError) {
+  runtime::VMOptions::getInstance().thread_stack_size = 64 * 1024;
+  auto depth = executeStaticMethod<Jint>(kClassName, "catchStackOverflow");
+  EXPECT_GT(depth, 100);
+  // bounded by -Xss
+  EXPECT_LT(depth, 64 * 1024 / sizeof(runtime::Frame));
+}
+
+TEST_F(InterpreterExceptionTest, StackIsReguardedAfterOverflow) {
+  runtime::VMOptions::getInstance().thread_stack_size = 64 * 1024;
+  EXPECT_GT(executeStaticMethod<Jint>(kClassName, "overflowTwice"), 100);
+}
+
+// ============================================================================
+// instanceof and checkcast on caught exceptions
+// ============================================================================
+
+TEST_F(InterpreterExceptionTest, InstanceOfCaughtException) {
+  // a RuntimeException and an ArithmeticException, but not an Error
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "classifyCaught", 10, 0), -3);
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "classifyCaught", 10, 2), 5);
+}
+
+TEST_F(InterpreterExceptionTest, FailedCastRaisesClassCastException) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "castCaught", 10, 0), -2);
+}
+
+TEST_F(InterpreterExceptionTest, NullPassesCastsAndIsNoInstance) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "castNull"), 0);
+}
+
+TEST_F(InterpreterExceptionTest, ClassCastExceptionNamesBothClasses) {
+  try {
+    executeStaticMethod<Jint>(kClassName, "castUncaught", 10, 0);
+    FAIL() << "expected an uncaught ClassCastException";
+  } catch (const runtime::UncaughtException& e) {
+    EXPECT_NE(std::string(e.what()).find(
+                "java.lang.ClassCastException: class java.lang.ArithmeticException cannot be cast "
+                "to class java.lang.Error"),
+              std::string::npos)
+      << e.what();
+  }
+}
+
+TEST_F(InterpreterExceptionTest, HandlerWithMissingCatchTypeIsPassedOver) {
+  // ExceptionTest alone, without the MissingCatchType class its inner handler catches
+  auto base = std::filesystem::temp_directory_path() / "interpreter_exception_test_missing";
+  std::filesystem::remove_all(base);
+  std::filesystem::create_directories(base / "tests/data/java");
+  std::filesystem::copy_file(
+    std::filesystem::path(TEST_CLASS_PATH) / "tests/data/java/ExceptionTest.class",
+    base / "tests/data/java/ExceptionTest.class");
+  loader_ = std::make_unique<class_loader::ClassLoader>(nullptr,
+                                                        std::vector<std::string>{base.string()});
+
+  // the ArithmeticException reaches the outer handler instead of being lost
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchPastMissingType", 10, 0), -2);
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "catchPastMissingType", 10, 2), 5);
+
+  loader_.reset();
+  std::filesystem::remove_all(base);
+}
+
+// ============================================================================
+// Uncaught exceptions
+// ============================================================================
+
+TEST_F(InterpreterExceptionTest, UncaughtExceptionReachesEmbedder) {
+  try {
+    executeStaticMethod<Jint>(kClassName, "uncaught", 10, 0);
+    FAIL() << "expected an uncaught ArithmeticException";
+  } catch (const runtime::UncaughtException& e) {
+    EXPECT_STREQ(e.what(),
+                 "Uncaught exception: java.lang.ArithmeticException: / by zero\n"
+                 "\tat tests.data.java.ExceptionTest.divide(pc: 2)\n"
+                 "\tat tests.data.java.ExceptionTest.uncaught(pc: 4)\n"
+                 "\tat tests.data.java.ExceptionTest.uncaught(pc: 5)");
+  }
+}
+
+// ============================================================================
+// Fast throw: hot implicit-exception sites reuse a preallocated instance
+// ============================================================================
+
+TEST_F(InterpreterExceptionTest, HotSiteOmitsStackTrace) {
+  runtime::VMOptions::getInstance().fast_throw_threshold = 3;
+  for (int i = 1; i <= 5; i++) {
+    try {
+      executeStaticMethod<Jint>(kClassName, "uncaught", 10, 0);
+      FAIL() << "expected an uncaught ArithmeticException";
+    } catch (const runtime::UncaughtException& e) {
+      std::string what = e.what();
+      if (i <= 3) {
+        EXPECT_NE(what.find("\tat "), std::string::npos);
+      } else {
+        EXPECT_EQ(what, "Uncaught exception: java.lang.ArithmeticException");
+      }
+    }
+  }
+}
+
+TEST_F(InterpreterExceptionTest, ConcurrentThrowsAreAllCounted) {
+  constexpr int kThreads = 4;
+  constexpr int kThrows  = 50;
+  // the site turns fast only once every throw below has been counted
+  runtime::VMOptions::getInstance().fast_throw_threshold = kThreads * kThrows;
+  auto throw_uncaught = [this] {
+    try {
+      executeStaticMethod<Jint>(kClassName, "uncaught", 10, 0);
+    } catch (const runtime::UncaughtException& e) {
+      return std::string(e.what());
+    }
+    return std::string();
+  };
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&throw_uncaught] {
+      for (int i = 0; i < kThrows; i++) {
+        throw_uncaught();
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(throw_uncaught(), "Uncaught exception: java.lang.ArithmeticException");
+}
+
+TEST_F(InterpreterExceptionTest, FastThrowStillDispatchesToHandlers) {
+  runtime::VMOptions::getInstance().fast_throw_threshold = 0;
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "countZeroDivisors", 100), 50);
+}
+
+TEST_F(InterpreterExceptionTest, FastThrowDisabled) {
+  runtime::VMOptions::getInstance().omit_stack_trace_in_fast_throw = false;
+  runtime::VMOptions::getInstance().fast_throw_threshold           = 0;
+  try {
+    executeStaticMethod<Jint>(kClassName, "uncaught", 10, 0);
+    FAIL() << "expected an uncaught ArithmeticException";
+  } catch (const runtime::UncaughtException& e) {
+    EXPECT_NE(std::string(e.what()).find("/ by zero"), std::string::npos);
+  }
+}
+
+}  // namespace
@@ -0,0 +1,126 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "common/types.h"
+#include "interpreter_test_base.h"
+#include "runtime/klass.h"
+#include "runtime/memo_cache.h"
+#include "runtime/method.h"
+#include "runtime/purity.h"
+
+using namespace jvm;
+
+namespace {
+
+class InterpreterMemoizationTest : public InterpreterTestBase {
+ public:
+  static constexpr const char* kClassName = "tests.data.java.MemoizationTest";
+
+  runtime::Method* findMethod(const char* name, const char* descriptor) {
+    return loader_->loadClass(kClassName)->findMethod(name, descriptor);
+  }
+
+  static void enableMemoization(size_t cache_size = 256) {
+    auto& options                = runtime::VMOptions::getInstance();
+    options.memoize_pure_methods = true;
+    options.memo_cache_size      = cache_size;
+  }
+};
+
+// ============================================================================
+// Purity analysis
+// ============================================================================
+
+TEST_F(InterpreterMemoizationTest, PureMethods) {
+  EXPECT_TRUE(runtime::isPure(findMethod("score", "(I)I")));
+  EXPECT_TRUE(runtime::isPure(findMethod("fib", "(I)I")));  // recursion
+  EXPECT_TRUE(runtime::isPure(findMethod("mix", "(JI)J")));
+  EXPECT_TRUE(runtime::isPure(findMethod("testFib", "(I)I")));  // only calls pure methods
+}
+
+TEST_F(InterpreterMemoizationTest, ImpureMethods) {
+  EXPECT_FALSE(runtime::isPure(findMethod("bump", "(I)I")));         // PUTSTATIC
+  EXPECT_FALSE(runtime::isPure(findMethod("readCounter", "(I)I")));  // GETSTATIC
+  EXPECT_FALSE(runtime::isPure(findMethod("callsBump", "(I)I")));    // calls an impure method
+  EXPECT_FALSE(runtime::isPure(findMethod("<init>", "()V")));        // not static
+}
+
+// ============================================================================
+// Memoized calls
+// ============================================================================
+
+TEST_F(InterpreterMemoizationTest, DisabledByDefault) {
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testScoreLoop", 100), 2950);
+  EXPECT_EQ(findMethod("score", "(I)I")->getMemoCache(), nullptr);
+}
+
+TEST_F(InterpreterMemoizationTest, RepeatedArgumentsHit) {
+  enableMemoization();
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testScoreLoop", 100), 2950);
+
+  const auto* cache = findMethod("score", "(I)I")->getMemoCache();
+  ASSERT_NE(cache, nullptr);
+  EXPECT_EQ(cache->getStats().misses, 10U);  // i % 10 takes ten values
+  EXPECT_EQ(cache->getStats().hits, 90U);
+  EXPECT_EQ(cache->getStats().evictions, 0U);
+}
+
+TEST_F(InterpreterMemoizationTest, ConcurrentFirstCallsShareOneCache) {
+  enableMemoization();
+  loader_->loadClass(kClassName);
+
+  std::vector<Jint>        results(4);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < results.size(); i++) {
+    threads.emplace_back(
+      [&, i] { results[i] = executeStaticMethod<Jint>(kClassName, "testScoreLoop", 100); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(results, std::vector<Jint>(results.size(), 2950));
+
+  const auto* cache = findMethod("score", "(I)I")->getMemoCache();
+  ASSERT_NE(cache, nullptr);
+  EXPECT_EQ(cache->getStats().hits + cache->getStats().misses, 100U * results.size());
+}
+
+TEST_F(InterpreterMemoizationTest, RecursiveCalls) {
+  enableMemoization();
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testFib", 25), 75025);
+
+  // fib(n) for each n is computed once, every other call hits
+  const auto* cache = findMethod("fib", "(I)I")->getMemoCache();
+  ASSERT_NE(cache, nullptr);
+  EXPECT_EQ(cache->getStats().misses, 26U);
+  EXPECT_EQ(cache->getStats().hits, 23U);
+}
+
+TEST_F(InterpreterMemoizationTest, WideArguments) {
+  enableMemoization();
+  EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testMix", Jlong{1} << 40U, 5),
+            (Jlong{1} << 40U) * 31 + 5);
+  EXPECT_EQ(executeStaticMethod<Jlong>(kClassName, "testMix", Jlong{2} << 40U, 5),
+            (Jlong{2} << 40U) * 31 + 5);
+}
+
+TEST_F(InterpreterMemoizationTest, SmallCacheEvicts) {
+  enableMemoization(2);
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testScoreLoop", 100), 2950);
+
+  const auto* cache = findMethod("score", "(I)I")->getMemoCache();
+  ASSERT_NE(cache, nullptr);
+  EXPECT_EQ(cache->getCapacity(), 2U);
+  EXPECT_GT(cache->getStats().evictions, 0U);
+}
+
+TEST_F(InterpreterMemoizationTest, ImpureCallsAlwaysRun) {
+  enableMemoization();
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testBumpLoop", 5), 6);
+  EXPECT_EQ(findMethod("callsBump", "(I)I")->getMemoCache(), nullptr);
+  EXPECT_EQ(executeStaticMethod<Jint>(kClassName, "testReadCounter", 1), 6);
+}
+
+}  // namespace
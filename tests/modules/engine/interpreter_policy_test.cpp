@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/types.h"
+#include "interpreter_test_base.h"
+#include "runtime/klass.h"
+#include "runtime/method.h"
+#include "runtime/safepoint.h"
+
+using namespace jvm;
+
+namespace {
+
+class InterpreterPolicyTest : public InterpreterTestBase {
+ public:
+  static constexpr const char* kClassName = "tests.data.java.MethodInvocationTest";
+
+  runtime::Method* findMethod(const char* name, const char* descriptor) {
+    return loader_->loadClass(kClassName)->findMethod(name, descriptor);
+  }
+
+  static inline size_t traced_instructions = 0;
+  static void          countInstruction(const runtime::Method& /*method*/, size_t /*pc*/,
+                                        U1 /*opcode*/) {
+    ++traced_instructions;
+  }
+};
+
+// ============================================================================
+// Every policy runs the same bytecode to the same result
+// ============================================================================
+
+TEST_F(InterpreterPolicyTest, AllPoliciesAgree) {
+  for (Jint n = 0; n <= 7; n++) {
+    auto checked  = executeStaticMethod<Jint, engine::Checked>(kClassName, "factorial", n);
+    auto profiled = executeStaticMethod<Jint, engine::Profiled>(kClassName, "factorial", n);
+    auto fast     = executeStaticMethod<Jint, engine::Fast>(kClassName, "factorial", n);
+    EXPECT_EQ(checked, profiled) << "n = " << n;
+    EXPECT_EQ(checked, fast) << "n = " << n;
+  }
+  auto result = executeStaticMethod<Jint, engine::Fast>(kClassName, "testInvokeStaticFactorial", 5);
+  EXPECT_EQ(result, 120);
+}
+
+// ============================================================================
+// Profiled: invocation and back-edge counters
+// ============================================================================
+
+TEST_F(InterpreterPolicyTest, ProfiledCountsInvocationsAndBackedges) {
+  auto result =
+    executeStaticMethod<Jint, engine::Profiled>(kClassName, "testInvokeStaticFactorial", 5);
+  EXPECT_EQ(result, 120);
+
+  auto* caller = findMethod("testInvokeStaticFactorial", "(I)I");
+  auto* callee = findMethod("factorial", "(I)I");
+  EXPECT_EQ(caller->getInvocationCount(), 1U);
+  EXPECT_EQ(caller->getBackedgeCount(), 0U);
+  EXPECT_EQ(callee->getInvocationCount(), 1U);
+  EXPECT_EQ(callee->getBackedgeCount(), 5U);  // one per loop iteration
+}
+
+TEST_F(InterpreterPolicyTest, OtherPoliciesDoNotProfile) {
+  executeStaticMethod<Jint, engine::Checked>(kClassName, "testInvokeStaticFactorial", 5);
+  executeStaticMethod<Jint, engine::Fast>(kClassName, "testInvokeStaticFactorial", 5);
+
+  auto* callee = findMethod("factorial", "(I)I");
+  EXPECT_EQ(callee->getInvocationCount(), 0U);
+  EXPECT_EQ(callee->getBackedgeCount(), 0U);
+}
+
+// ============================================================================
+// Checked: tracing hook
+// ============================================================================
+
+TEST_F(InterpreterPolicyTest, CheckedCallsTraceHook) {
+  trace_hook_         = &countInstruction;
+  traced_instructions = 0;
+  executeStaticMethod<Jint, engine::Checked>(kClassName, "factorial", 0);
+  // iload_0, ifgt, iconst_1, ireturn
+  EXPECT_EQ(traced_instructions, 4U);
+
+  traced_instructions = 0;
+  executeStaticMethod<Jint, engine::Fast>(kClassName, "factorial", 0);
+  EXPECT_EQ(traced_instructions, 0U);
+}
+
+// ============================================================================
+// Safepoint polls
+// ============================================================================
+
+TEST_F(InterpreterPolicyTest, SafepointOperationRunsAtPoll) {
+  // the operation runs once, on the thread that polls first; nothing else is stopped
+  int             runs = 0;
+  std::thread::id ran_on;
+  runtime::Safepoint::getInstance().request([&runs, &ran_on] {
+    runs++;
+    ran_on = std::this_thread::get_id();
+  });
+
+  executeStaticMethod<Jint, engine::Fast>(kClassName, "factorial", 5);
+  EXPECT_EQ(runs, 0);  // Fast never polls
+  EXPECT_TRUE(runtime::Safepoint::getInstance().isRequested());
+
+  auto result = executeStaticMethod<Jint, engine::Checked>(kClassName, "factorial", 5);
+  EXPECT_EQ(result, 120);
+  EXPECT_EQ(runs, 1);
+  EXPECT_EQ(ran_on, std::this_thread::get_id());
+  EXPECT_FALSE(runtime::Safepoint::getInstance().isRequested());
+}
+
+}  // namespace
@@ -4,13 +4,16 @@
 
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "class_loader/class_loader.h"
 #include "engine/interpreter.h"
 #include "runtime/frame.h"
 #include "runtime/method_area.h"
+#include "runtime/safepoint.h"
 #include "runtime/thread.h"
+#include "runtime/vm_options.h"
 
 using namespace jvm;
 
@@ -43,6 +46,13 @@ struct JvmTraits<Jlong> {
   static Jlong popStack(jvm::runtime::OperandStack& stack) { return stack.popLong(); }
 };
 
+// Specialization: long long literals (e.g. 10LL), which are a distinct type from Jlong on LP64
+// platforms where int64_t is `long`
+using LongLongIfDistinct =
+  std::conditional_t<std::is_same_v<long long, Jlong>, struct JlongIsLongLong, long long>;
+template <>
+struct JvmTraits<LongLongIfDistinct> : JvmTraits<Jlong> {};
+
 // Specialization: Jfloat
 template <>
 struct JvmTraits<Jfloat> {
@@ -78,12 +88,15 @@ class InterpreterTestBase : public ::testing::Test {
   std::unique_ptr<class_loader::ClassLoader> loader_;
   std::vector<std::string>                   classpath_list_;
   std::string                                test_classpath_;
+  engine::Interpreter<>::TraceHook           trace_hook_{nullptr};
 
   void SetUp() override {
     test_classpath_ = TEST_CLASS_PATH;
     classpath_list_ = {test_classpath_};
     loader_         = std::make_unique<class_loader::ClassLoader>(nullptr, classpath_list_);
     runtime::MethodArea::getInstance().reset();
+    runtime::VMOptions::getInstance().reset();
+    runtime::Safepoint::getInstance().reset();
   }
 
   void TearDown() override { loader_.reset(); }
@@ -91,9 +104,10 @@ class InterpreterTestBase : public ::testing::Test {
   /**
    * @brief Generic static method execution helper function
    * @tparam Ret Return value type (explicitly specified, e.g. executeStaticMethod<Jint>(...))
+   * @tparam Policy Interpreter policy (defaults to engine::Checked)
    * @tparam Args Parameter types (automatically deduced by compiler)
    */
-  template <typename Ret, typename... Args>
+  template <typename Ret, typename Policy = engine::Checked, typename... Args>
   Ret executeStaticMethod(const std::string& class_name, const std::string& method_name,
                           Args... args) {
     // 1. Dynamically build method descriptor: (Arg1Arg2...)Ret
@@ -110,8 +124,9 @@ class InterpreterTestBase : public ::testing::Test {
     auto* method = klass->findMethod(method_name, descriptor);
     if (!method) throw std::runtime_error("Method not found: " + method_name + " " + descriptor);
 
-    jvm::runtime::Thread     thread;
-    jvm::engine::Interpreter interpreter;
+    jvm::runtime::Thread             thread;
+    jvm::engine::Interpreter<Policy> interpreter;
+    interpreter.setTraceHook(trace_hook_);
 
     // 3. Prepare caller frame (Caller Frame)
     jvm::runtime::Frame caller_frame(method);
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include "common/types.h"
+#include "interpreter_test_base.h"
+#include "runtime/klass.h"
+#include "runtime/method.h"
+
+using namespace jvm;
+
+namespace {
+
+class InterpreterTrivialMethodTest : public InterpreterTestBase {
+ public:
+  static constexpr const char* kClassName = "tests.data.java.TrivialMethodTest";
+
+  runtime::Method* findMethod(const char* name, const char* descriptor) {
+    return loader_->loadClass(kClassName)->findMethod(name, descriptor);
+  }
+
+  // Runs `method_name` on the frame-per-call Checked interpreter and on the inlining Fast one
+  template <typename... Args>
+  void expectSameResult(const char* method_name, Jint expected, Args... args) {
+    auto checked = executeStaticMethod<Jint, engine::Checked>(kClassName, method_name, args...);
+    auto fast    = executeStaticMethod<Jint, engine::Fast>(kClassName, method_name, args...);
+    EXPECT_EQ(checked, expected) << method_name;
+    EXPECT_EQ(fast, expected) << method_name;
+  }
+};
+
+// ============================================================================
+// Link-time detection
+// ============================================================================
+
+TEST_F(InterpreterTrivialMethodTest, DetectedAtLinkTime) {
+  using Kind = runtime::TrivialMethod::Kind;
+  EXPECT_EQ(findMethod("one", "()I")->getTrivialMethod().kind, Kind::kValue);
+  EXPECT_EQ(findMethod("longOne", "()J")->getTrivialMethod().kind, Kind::kValue);
+  EXPECT_EQ(findMethod("second", "(II)I")->getTrivialMethod().kind, Kind::kValue);
+  EXPECT_EQ(findMethod("add", "(II)I")->getTrivialMethod().kind, Kind::kIntBinaryOp);
+  EXPECT_EQ(findMethod("inc", "(I)I")->getTrivialMethod().kind, Kind::kIntBinaryOp);
+  EXPECT_EQ(findMethod("getCounter", "()I")->getTrivialMethod().kind, Kind::kStaticGetter);
+
+  EXPECT_FALSE(findMethod("div", "(II)I")->getTrivialMethod().isTrivial());
+  EXPECT_FALSE(findMethod("addThree", "(III)I")->getTrivialMethod().isTrivial());
+  EXPECT_FALSE(findMethod("testSumLoop", "(I)I")->getTrivialMethod().isTrivial());
+}
+
+// ============================================================================
+// Inlined calls behave like real ones
+// ============================================================================
+
+TEST_F(InterpreterTrivialMethodTest, Constants) { expectSameResult("testConstants", 1000); }
+
+TEST_F(InterpreterTrivialMethodTest, LongConstant) {
+  auto result = executeStaticMethod<Jlong, engine::Fast>(kClassName, "testLongConstant");
+  EXPECT_EQ(result, 1L);
+}
+
+TEST_F(InterpreterTrivialMethodTest, Arguments) {
+  expectSameResult("testIdentity", 42, 42);
+  expectSameResult("testSecond", 7, 3, 7);
+}
+
+TEST_F(InterpreterTrivialMethodTest, IntOperators) {
+  expectSameResult("testAdd", 5, 2, 3);
+  expectSameResult("testAdd", INT32_MIN, INT32_MAX, 1);  // wraps around
+  expectSameResult("testSub", -1, 2, 3);
+  expectSameResult("testInc", 12, 10);
+  expectSameResult("testShl", 16, 1, 36);  // shift distance is masked to 5 bits
+}
+
+TEST_F(InterpreterTrivialMethodTest, StaticGetter) { expectSameResult("testGetCounter", 0); }
+
+TEST_F(InterpreterTrivialMethodTest, NonTrivialCallees) {
+  expectSameResult("testDiv", 3, 7, 2);
+  expectSameResult("testAddThree", 6, 1, 2, 3);
+}
+
+TEST_F(InterpreterTrivialMethodTest, CallInLoop) { expectSameResult("testSumLoop", 4950, 100); }
+
+// An inlined call still counts as an invocation of the callee
+TEST_F(InterpreterTrivialMethodTest, ProfiledCountsInlinedCalls) {
+  auto result = executeStaticMethod<Jint, engine::Profiled>(kClassName, "testSumLoop", 10);
+  EXPECT_EQ(result, 45);
+  EXPECT_EQ(findMethod("add", "(II)I")->getInvocationCount(), 10U);
+}
+
+}  // namespace
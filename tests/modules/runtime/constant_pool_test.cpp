@@ -5,7 +5,7 @@
 #include <memory>
 #include <optional>
 #include <string>
-#include <variant>
+#include <thread>
 #include <vector>
 
 #include "class_loader/class_file.h"
@@ -31,14 +31,24 @@ class ConstantPoolTest : public ::testing::Test {
                                          const std::string& name, const std::string& descriptor) {
     const auto& cp = class_file->constant_pool;
     for (size_t i = 1; i < cp.size(); i++) {
-      auto* info = dynamic_cast<const class_loader::NameAndTypeInfo*>(cp.getConstantInfo(i));
-      if (info == nullptr) {
+      if (cp.getTag(i) != class_loader::ConstantTag::kNameAndType) {
         continue;
       }
-      // std::cerr << "Name: " << cp.getUtf8String(info->name_index) << std::endl;
-      // std::cerr << "Descriptor: " << cp.getUtf8String(info->descriptor_index) << std::endl;
-      if (cp.getUtf8String(info->name_index) == name &&
-          cp.getUtf8String(info->descriptor_index) == descriptor) {
+      auto info = cp.getNameAndTypeRef(i);
+      if (cp.getUtf8String(info.name_index) == name &&
+          cp.getUtf8String(info.descriptor_index) == descriptor) {
+        return i;
+      }
+    }
+    return std::nullopt;
+  }
+
+  // Index of the `tag` (Fieldref/Methodref) entry whose NameAndType is `nt_index`
+  std::optional<U2> findMemberRefIndex(class_loader::ClassFile* class_file,
+                                       class_loader::ConstantTag tag, U2 nt_index) {
+    const auto& cp = class_file->constant_pool;
+    for (size_t i = 1; i < cp.size(); i++) {
+      if (cp.getTag(i) == tag && cp.getMemberRef(i).name_and_type_index == nt_index) {
         return i;
       }
     }
@@ -56,20 +66,17 @@ TEST_F(ConstantPoolTest, ResolveClassCachesResult) {
   auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
   ASSERT_NE(klass, nullptr);
 
-  auto* class_file = klass->getClassFile();
-  auto* class_info = dynamic_cast<const class_loader::ClassInfo*>(
-    class_file->constant_pool.getConstantInfo(class_file->this_class_index));
-  ASSERT_NE(class_info, nullptr);
-
-  auto& rcp = klass->getRuntimeConstantPool();
-  rcp.setConstant(1, runtime::SymRef_Class{.name_index = class_info->name_index});
+  auto  class_index = klass->getClassFile()->this_class_index;
+  auto& rcp         = klass->getRuntimeConstantPool();
+  EXPECT_EQ(rcp.getTag(class_index), runtime::CpTag::kClass);
+  EXPECT_FALSE(rcp.isResolved(class_index));
 
-  auto* resolved_first  = rcp.resolveClass(1);
-  auto* resolved_second = rcp.resolveClass(1);
+  auto* resolved_first  = rcp.resolveClass(class_index);
+  auto* resolved_second = rcp.resolveClass(class_index);
 
   EXPECT_EQ(resolved_first, klass);
   EXPECT_EQ(resolved_first, resolved_second);
-  EXPECT_TRUE(std::holds_alternative<runtime::Klass*>(rcp.getConstant(1)));
+  EXPECT_TRUE(rcp.isResolved(class_index));
 }
 
 TEST_F(ConstantPoolTest, ResolveNameAndType) {
@@ -81,8 +88,13 @@ TEST_F(ConstantPoolTest, ResolveNameAndType) {
   ASSERT_TRUE(nt_index.has_value());
 
   auto [name, descriptor] = klass->getRuntimeConstantPool().resolveNameAndType(nt_index.value());
-  EXPECT_EQ(name, "add");
-  EXPECT_EQ(descriptor, "(II)I");
+  EXPECT_EQ(name->view(), "add");
+  EXPECT_EQ(descriptor->view(), "(II)I");
+  // interned: the same symbols the method was created with
+  auto* method = klass->findMethod("add", "(II)I");
+  ASSERT_NE(method, nullptr);
+  EXPECT_EQ(name, method->getNameSymbol());
+  EXPECT_EQ(descriptor, method->getDescriptorSymbol());
 }
 
 TEST_F(ConstantPoolTest, ResolveMethodAndCache) {
@@ -95,22 +107,24 @@ TEST_F(ConstantPoolTest, ResolveMethodAndCache) {
   auto nt_index = findNameAndTypeIndex(class_file, "add", "(II)I");
   ASSERT_TRUE(nt_index.has_value());
 
-  // reuse this class's own Class entry for class_index
-  auto class_index = class_file->this_class_index;
+  // main() calls add(II)I
+  auto index =
+    findMemberRefIndex(class_file, class_loader::ConstantTag::kMethodref, nt_index.value());
+  ASSERT_TRUE(index.has_value());
 
   auto& rcp = klass->getRuntimeConstantPool();
-  rcp.setConstant(
-    2, runtime::SymRef_Method{.class_index = class_index, .name_and_type_index = nt_index.value()});
+  EXPECT_EQ(rcp.getTag(index.value()), runtime::CpTag::kMethodref);
+  EXPECT_FALSE(rcp.isResolved(index.value()));
 
-  auto* resolved_first  = rcp.resolveMethod(2);
-  auto* resolved_second = rcp.resolveMethod(2);
+  auto* resolved_first  = rcp.resolveMethod(index.value());
+  auto* resolved_second = rcp.resolveMethod(index.value());
 
   ASSERT_NE(resolved_first, nullptr);
   EXPECT_EQ(resolved_first->getName(), "add");
   EXPECT_EQ(resolved_first->getDescriptor(), "(II)I");
   EXPECT_EQ(resolved_first->getOwnerKlass(), klass);
   EXPECT_EQ(resolved_first, resolved_second);
-  EXPECT_TRUE(std::holds_alternative<runtime::Method*>(rcp.getConstant(2)));
+  EXPECT_TRUE(rcp.isResolved(index.value()));
 }
 
 TEST_F(ConstantPoolTest, ResolveFieldAndCache) {
@@ -123,14 +137,17 @@ TEST_F(ConstantPoolTest, ResolveFieldAndCache) {
   auto nt_index = findNameAndTypeIndex(class_file, "sd", "D");
   ASSERT_TRUE(nt_index.has_value());
 
-  auto class_index = class_file->this_class_index;
+  // the constructor assigns sd
+  auto index =
+    findMemberRefIndex(class_file, class_loader::ConstantTag::kFieldref, nt_index.value());
+  ASSERT_TRUE(index.has_value());
 
   auto& rcp = klass->getRuntimeConstantPool();
-  rcp.setConstant(
-    3, runtime::SymRef_Field{.class_index = class_index, .name_and_type_index = nt_index.value()});
+  EXPECT_EQ(rcp.getTag(index.value()), runtime::CpTag::kFieldref);
+  EXPECT_THROW(rcp.resolveMethod(index.value()), std::runtime_error);
 
-  auto* resolved_first  = rcp.resolveField(3);
-  auto* resolved_second = rcp.resolveField(3);
+  auto* resolved_first  = rcp.resolveField(index.value());
+  auto* resolved_second = rcp.resolveField(index.value());
 
   ASSERT_NE(resolved_first, nullptr);
   EXPECT_EQ(resolved_first->getName(), "sd");
@@ -138,5 +155,63 @@ TEST_F(ConstantPoolTest, ResolveFieldAndCache) {
   EXPECT_TRUE(resolved_first->isStatic());
   EXPECT_EQ(resolved_first->getOwnerKlass(), klass);
   EXPECT_EQ(resolved_first, resolved_second);
-  EXPECT_TRUE(std::holds_alternative<runtime::Field*>(rcp.getConstant(3)));
+  EXPECT_TRUE(rcp.isResolved(index.value()));
+}
+
+TEST_F(ConstantPoolTest, MaterializesLiteralsOnDemand) {
+  auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+
+  // the constructor loads 3.14f widened to a double
+  const auto&       cf_cp = klass->getClassFile()->constant_pool;
+  std::optional<U2> double_index;
+  for (size_t i = 1; i < cf_cp.size(); i++) {
+    if (cf_cp.getTag(i) == class_loader::ConstantTag::kDouble) {
+      double_index = i;
+    }
+  }
+  ASSERT_TRUE(double_index.has_value());
+
+  auto& rcp = klass->getRuntimeConstantPool();
+  EXPECT_EQ(rcp.size(), cf_cp.size());
+  EXPECT_EQ(rcp.getTag(0), runtime::CpTag::kEmpty);
+  EXPECT_EQ(rcp.getTag(double_index.value()), runtime::CpTag::kDouble);
+  EXPECT_DOUBLE_EQ(rcp.getDouble(double_index.value()), static_cast<double>(3.14f));
+  // a double takes two indices
+  EXPECT_EQ(rcp.getTag(double_index.value() + 1), runtime::CpTag::kEmpty);
+  EXPECT_THROW(rcp.getLong(double_index.value()), std::runtime_error);
+  EXPECT_THROW(rcp.getTag(rcp.size()), std::runtime_error);
+}
+
+TEST_F(ConstantPoolTest, ConcurrentResolutionAgrees) {
+  auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+
+  auto* class_file = klass->getClassFile();
+  auto  nt_index   = findNameAndTypeIndex(class_file, "staticAdd", "(II)I");
+  ASSERT_TRUE(nt_index.has_value());
+  auto index =
+    findMemberRefIndex(class_file, class_loader::ConstantTag::kMethodref, nt_index.value());
+  ASSERT_TRUE(index.has_value());
+
+  // the class is loaded already, so resolution only materializes and looks up the member
+  constexpr int                 kThreads = 8;
+  auto&                         rcp      = klass->getRuntimeConstantPool();
+  std::vector<runtime::Method*> resolved(kThreads);
+  std::vector<std::thread>      threads;
+  threads.reserve(kThreads);
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&rcp, &resolved, &index, t] {
+      resolved[t] = rcp.resolveMethod(index.value());
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto* expected = klass->findMethod("staticAdd", "(II)I");
+  ASSERT_NE(expected, nullptr);
+  for (auto* method : resolved) {
+    EXPECT_EQ(method, expected);
+  }
 }
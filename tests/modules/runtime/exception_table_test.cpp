@@ -0,0 +1,58 @@
+#include "runtime/exception_table.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+namespace jvm::runtime {
+
+TEST(ExceptionTableTest, EmptyTable) {
+  ExceptionHandlerTable table;
+  EXPECT_TRUE(table.empty());
+  EXPECT_TRUE(table.findCandidates(0).empty());
+}
+
+TEST(ExceptionTableTest, RangeIsHalfOpen) {
+  std::vector<ExceptionHandler> handlers = {
+    {.start_pc = 2, .end_pc = 6, .handler_pc = 9, .catch_type = 0},
+  };
+  ExceptionHandlerTable table(handlers);
+  EXPECT_TRUE(table.findCandidates(1).empty());
+  EXPECT_EQ(table.findCandidates(2).size(), 1);
+  EXPECT_EQ(table.findCandidates(5).size(), 1);
+  EXPECT_TRUE(table.findCandidates(6).empty());
+}
+
+TEST(ExceptionTableTest, NestedRangesKeepClassFileOrder) {
+  // inner try [4, 8) listed before the outer try [0, 12), as javac emits them
+  std::vector<ExceptionHandler> handlers = {
+    {.start_pc = 4, .end_pc = 8, .handler_pc = 20, .catch_type = 1},
+    {.start_pc = 0, .end_pc = 12, .handler_pc = 30, .catch_type = 2},
+  };
+  ExceptionHandlerTable table(handlers);
+
+  auto outer_only = table.findCandidates(2);
+  ASSERT_EQ(outer_only.size(), 1);
+  EXPECT_EQ(outer_only[0].handler_pc, 30);
+
+  auto both = table.findCandidates(5);
+  ASSERT_EQ(both.size(), 2);
+  EXPECT_EQ(both[0].handler_pc, 20);
+  EXPECT_EQ(both[1].handler_pc, 30);
+
+  EXPECT_EQ(table.findCandidates(10).size(), 1);
+  EXPECT_TRUE(table.findCandidates(12).empty());
+}
+
+TEST(ExceptionTableTest, GapBetweenRanges) {
+  std::vector<ExceptionHandler> handlers = {
+    {.start_pc = 0, .end_pc = 4, .handler_pc = 20, .catch_type = 0},
+    {.start_pc = 8, .end_pc = 12, .handler_pc = 30, .catch_type = 0},
+  };
+  ExceptionHandlerTable table(handlers);
+  EXPECT_EQ(table.findCandidates(3)[0].handler_pc, 20);
+  EXPECT_TRUE(table.findCandidates(6).empty());
+  EXPECT_EQ(table.findCandidates(8)[0].handler_pc, 30);
+}
+
+}  // namespace jvm::runtime
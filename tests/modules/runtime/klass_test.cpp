@@ -2,12 +2,17 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "class_loader/class_loader.h"
 #include "runtime/method_area.h"
+#include "runtime/vm_options.h"
+#include "runtime/well_known_classes.h"
 
 using namespace jvm;
 
@@ -22,6 +27,8 @@ class KlassTest : public ::testing::Test {
     runtime::MethodArea::getInstance().reset();
   }
 
+  void TearDown() override { runtime::VMOptions::getInstance().reset(); }
+
   std::string                                test_classpath_;
   std::vector<std::string>                   classpath_list_;
   std::unique_ptr<class_loader::ClassLoader> loader_;
@@ -64,6 +71,80 @@ TEST_F(KlassTest, FindMethod) {
   EXPECT_EQ(klass->findMethod("notExist", "()V"), nullptr);
 }
 
+TEST_F(KlassTest, DecodesCodeOnFirstUse) {
+  auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+  auto* add_method = klass->findMethod("add", "(II)I");
+  ASSERT_NE(add_method, nullptr);
+  EXPECT_FALSE(add_method->isDecoded());
+
+  // the first callers race to decode it; all of them see the whole body
+  std::vector<std::thread> threads;
+  std::vector<size_t>      code_sizes(4);
+  for (size_t i = 0; i < code_sizes.size(); i++) {
+    threads.emplace_back([&, i] { code_sizes[i] = add_method->getCode().size(); });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_TRUE(add_method->isDecoded());
+  EXPECT_EQ(code_sizes, std::vector<size_t>(4, 4));  // iload_1, iload_2, iadd, ireturn
+  EXPECT_EQ(add_method->getMaxStack(), 2);
+  EXPECT_EQ(add_method->getMaxLocals(), 3);
+  EXPECT_TRUE(add_method->getExceptionTable().getHandlers().empty());
+
+  // untouched methods stay undecoded
+  EXPECT_FALSE(klass->findMethod("staticAdd", "(II)I")->isDecoded());
+}
+
+TEST_F(KlassTest, AllocatesMetadataFromLoaderMetaspace) {
+  auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+
+  // the Klass, its method and field arrays, constant pool entries and static slots are all
+  // carved out of the loader's arena
+  const auto& metaspace = loader_->getMetaspace();
+  EXPECT_GE(metaspace.getUsedBytes(),
+            sizeof(runtime::Klass) + sizeof(runtime::Method) * klass->getMethods().size() +
+              sizeof(runtime::Field) * klass->getFields().size() +
+              (1 + sizeof(U8)) * klass->getRuntimeConstantPool().size() +
+              sizeof(runtime::Slot) * klass->getStaticSlotCount());
+
+  // methods sit in one array, so lookups hand out stable pointers into it
+  auto methods = klass->getMethods();
+  ASSERT_FALSE(methods.empty());
+  const auto* add_method = klass->findMethod("add", "(II)I");
+  ASSERT_NE(add_method, nullptr);
+  EXPECT_GE(add_method, methods.data());
+  EXPECT_LT(add_method, methods.data() + methods.size());
+}
+
+TEST_F(KlassTest, CopiesCodeIntoMetaspace) {
+  auto* klass = loader_->loadClass("tests.data.java.KlassTestData");
+  ASSERT_NE(klass, nullptr);
+
+  // each method starts a cache line, so its hot fields never share one with a neighbour
+  for (const auto& method : klass->getMethods()) {
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(&method) % 64, 0);  // NOLINT
+  }
+
+  auto* add_method = klass->findMethod("add", "(II)I");
+  ASSERT_NE(add_method, nullptr);
+  size_t used = loader_->getMetaspace().getUsedBytes();
+  auto   code = add_method->getCode();
+  ASSERT_FALSE(code.empty());
+  // only the code; the implicit exception counters wait for the first implicit exception
+  EXPECT_EQ(loader_->getMetaspace().getUsedBytes(), used + code.size());
+  EXPECT_EQ(add_method->getCode().data(), code.data());
+
+  used = loader_->getMetaspace().getUsedBytes();
+  EXPECT_EQ(add_method->countImplicitException(2), 1U);
+  EXPECT_EQ(add_method->countImplicitException(2), 2U);
+  EXPECT_EQ(add_method->countImplicitException(0), 1U);
+  // one counter per code byte, allocated once
+  EXPECT_EQ(loader_->getMetaspace().getUsedBytes(), used + code.size() * sizeof(std::atomic<U4>));
+}
+
 TEST_F(KlassTest, FindField) {
   std::string class_name = "tests.data.java.KlassTestData";
   auto*       klass      = loader_->loadClass(class_name);
@@ -124,3 +205,98 @@ TEST_F(KlassTest, InterfacesAndSuperClassDefaults) {
   // Super class is not linked yet by ClassLoader::loadClass
   EXPECT_EQ(klass->getSuperClass(), nullptr);
 }
+
+namespace {
+
+// KlassTestDerived extends KlassTestBase, overriding describe() and hiding `shared`
+void expectInheritedLookups(runtime::Klass* derived) {
+  auto* base = derived->getSuperClass();
+  ASSERT_NE(base, nullptr);
+  EXPECT_EQ(base->getName(), "tests/data/java/KlassTestBase");
+
+  auto* describe = derived->findMethod("describe", "()I");
+  ASSERT_NE(describe, nullptr);
+  EXPECT_EQ(describe->getOwnerKlass(), derived);
+  EXPECT_EQ(base->findMethod("describe", "()I")->getOwnerKlass(), base);
+
+  auto* base_only = derived->findMethod("baseOnly", "()I");
+  ASSERT_NE(base_only, nullptr);
+  EXPECT_EQ(base_only->getOwnerKlass(), base);
+  EXPECT_EQ(base->findMethod("derivedOnly", "()I"), nullptr);
+
+  auto* long_shared = derived->findField("shared", "J");
+  ASSERT_NE(long_shared, nullptr);
+  EXPECT_EQ(long_shared->getOwnerKlass(), derived);
+  auto* int_shared = derived->findField("shared", "I");
+  ASSERT_NE(int_shared, nullptr);
+  EXPECT_EQ(int_shared->getOwnerKlass(), base);
+  EXPECT_EQ(derived->findField("baseStatic", "I"), base->findField("baseStatic", "I"));
+
+  EXPECT_EQ(derived->findMethod("notExist", "()I"), nullptr);
+  EXPECT_EQ(derived->findField("baseField", "J"), nullptr);
+}
+
+}  // namespace
+
+TEST_F(KlassTest, FindInheritedMembers) {
+  auto* derived = loader_->loadClass("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+  expectInheritedLookups(derived);
+}
+
+TEST_F(KlassTest, FindInheritedMembersFlattened) {
+  runtime::VMOptions::getInstance().flatten_member_tables = true;
+  auto* derived = loader_->loadClass("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+  expectInheritedLookups(derived);
+}
+
+TEST_F(KlassTest, SubtypesOfClassesAndInterfaces) {
+  auto* square  = loader_->loadClass("tests.data.java.SubtypeTest$Square");
+  auto* quad    = loader_->loadClass("tests.data.java.SubtypeTest$Quad");
+  auto* polygon = loader_->loadClass("tests.data.java.SubtypeTest$Polygon");
+  auto* shape   = loader_->loadClass("tests.data.java.SubtypeTest$Shape");
+  auto* named   = loader_->loadClass("tests.data.java.SubtypeTest$Named");
+  ASSERT_TRUE(polygon->isInterface());
+  ASSERT_FALSE(quad->isInterface());
+
+  for (auto* super : {square, quad, polygon, shape, named}) {
+    EXPECT_TRUE(square->isSubtypeOf(super)) << super->getName();
+    // the second check hits the secondary super cache of an interface
+    EXPECT_TRUE(square->isSubtypeOf(super)) << super->getName();
+  }
+  EXPECT_TRUE(quad->isSubtypeOf(shape));
+  EXPECT_FALSE(quad->isSubtypeOf(square));
+  EXPECT_FALSE(quad->isSubtypeOf(named));
+  EXPECT_TRUE(polygon->isSubtypeOf(shape));
+  EXPECT_FALSE(shape->isSubtypeOf(polygon));
+  EXPECT_FALSE(named->isSubtypeOf(shape));
+}
+
+TEST_F(KlassTest, SubtypesBeyondPrimaryDisplay) {
+  // D1 is the root of a ten class chain, and D10 also implements Named
+  std::vector<runtime::Klass*> chain;
+  for (int i = 1; i <= 10; i++) {
+    chain.push_back(loader_->loadClass("tests.data.java.SubtypeTest$D" + std::to_string(i)));
+  }
+  for (size_t sub = 0; sub < chain.size(); sub++) {
+    for (size_t super = 0; super < chain.size(); super++) {
+      EXPECT_EQ(chain[sub]->isSubtypeOf(chain[super]), super <= sub)
+        << chain[sub]->getName() << " <: " << chain[super]->getName();
+    }
+  }
+  auto* named = loader_->loadClass("tests.data.java.SubtypeTest$Named");
+  EXPECT_TRUE(chain[9]->isSubtypeOf(named));
+  EXPECT_FALSE(chain[8]->isSubtypeOf(named));
+}
+
+TEST_F(KlassTest, SubtypesOfWellKnownClasses) {
+  using runtime::WellKnownClass;
+  auto* bounds = runtime::getWellKnownClass(WellKnownClass::kArrayIndexOutOfBoundsException);
+  for (auto super : {WellKnownClass::kIndexOutOfBoundsException, WellKnownClass::kRuntimeException,
+                     WellKnownClass::kException, WellKnownClass::kThrowable}) {
+    EXPECT_TRUE(bounds->isSubtypeOf(runtime::getWellKnownClass(super)));
+  }
+  EXPECT_FALSE(bounds->isSubtypeOf(runtime::getWellKnownClass(WellKnownClass::kError)));
+  EXPECT_FALSE(runtime::getWellKnownClass(WellKnownClass::kRuntimeException)->isSubtypeOf(bounds));
+}
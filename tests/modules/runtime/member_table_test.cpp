@@ -0,0 +1,86 @@
+#include "runtime/member_table.h"
+
+#include <gtest/gtest.h>
+
+#include <deque>
+#include <string>
+
+namespace jvm::runtime {
+
+namespace {
+
+struct FakeMember {
+  const Symbol* name;
+  const Symbol* descriptor;
+
+  const Symbol* getNameSymbol() const { return name; }
+  const Symbol* getDescriptorSymbol() const { return descriptor; }
+};
+
+const Symbol* intern(const std::string& string) {
+  return SymbolTable::getInstance().intern(string);
+}
+
+}  // namespace
+
+TEST(MemberTableTest, EmptyTableMisses) {
+  Metaspace               metaspace;
+  MemberTable<FakeMember> table(metaspace);
+  EXPECT_EQ(table.capacity(), 0U);
+  EXPECT_EQ(table.find(intern("run"), intern("()V")), nullptr);
+}
+
+TEST(MemberTableTest, OverloadsAreDistinct) {
+  FakeMember run_void{intern("run"), intern("()V")};
+  FakeMember run_int{intern("run"), intern("(I)V")};
+
+  Metaspace               metaspace;
+  MemberTable<FakeMember> table(metaspace);
+  EXPECT_TRUE(table.insert(&run_void));
+  EXPECT_TRUE(table.insert(&run_int));
+  EXPECT_EQ(table.find(intern("run"), intern("()V")), &run_void);
+  EXPECT_EQ(table.find(intern("run"), intern("(I)V")), &run_int);
+  EXPECT_EQ(table.find(intern("run"), intern("(J)V")), nullptr);
+}
+
+TEST(MemberTableTest, FirstInsertWins) {
+  FakeMember own{intern("describe"), intern("()I")};
+  FakeMember inherited{intern("describe"), intern("()I")};
+
+  Metaspace               metaspace;
+  MemberTable<FakeMember> table(metaspace);
+  EXPECT_TRUE(table.insert(&own));
+  EXPECT_FALSE(table.insert(&inherited));
+  EXPECT_EQ(table.size(), 1U);
+  EXPECT_EQ(table.find(intern("describe"), intern("()I")), &own);
+}
+
+TEST(MemberTableTest, ManyMembers) {
+  // the size of generated classes, e.g. protobuf messages
+  constexpr int kCount = 1000;
+
+  std::deque<FakeMember>  members;
+  Metaspace               metaspace;
+  MemberTable<FakeMember> table(metaspace);
+  table.reserve(kCount);
+  size_t capacity = table.capacity();
+  for (int i = 0; i < kCount; i++) {
+    members.push_back({intern("get" + std::to_string(i)), intern(i % 2 == 0 ? "()I" : "()J")});
+    EXPECT_TRUE(table.insert(&members.back()));
+  }
+  EXPECT_EQ(table.size(), static_cast<size_t>(kCount));
+  EXPECT_EQ(table.capacity(), capacity);  // reserve() made room for all of them
+  EXPECT_LE(table.size() * 2, table.capacity());
+
+  for (int i = 0; i < kCount; i++) {
+    const auto* descriptor = intern(i % 2 == 0 ? "()I" : "()J");
+    EXPECT_EQ(table.find(intern("get" + std::to_string(i)), descriptor), &members[i]);
+  }
+  EXPECT_EQ(table.find(intern("get0"), intern("()J")), nullptr);
+
+  size_t visited = 0;
+  table.forEach([&visited](FakeMember*) { visited++; });
+  EXPECT_EQ(visited, table.size());
+}
+
+}  // namespace jvm::runtime
@@ -0,0 +1,120 @@
+#include "runtime/memo_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace jvm::runtime {
+
+TEST(MemoCacheTest, MissThenHit) {
+  MemoCache      cache(16, "(II)I");
+  LocalVariables args(2);
+  args.setInt(0, 3);
+  args.setInt(1, 4);
+  auto key = cache.makeKey(args);
+
+  EXPECT_FALSE(cache.lookup(key).has_value());
+  cache.insert(key, {.i = 7});
+  auto result = cache.lookup(key);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->i, 7);
+
+  EXPECT_EQ(cache.getStats().hits, 1U);
+  EXPECT_EQ(cache.getStats().misses, 1U);
+  EXPECT_DOUBLE_EQ(cache.getStats().hitRate(), 0.5);
+}
+
+TEST(MemoCacheTest, KeyIgnoresUnusedSlotBytes) {
+  MemoCache      cache(16, "(I)I");
+  LocalVariables a(1);
+  LocalVariables b(1);
+  a.setLong(0, 0x1234'5678'0000'0005LL);  // garbage in the upper half
+  b.setInt(0, 5);
+  EXPECT_EQ(cache.makeKey(a), cache.makeKey(b));
+}
+
+TEST(MemoCacheTest, WideArgumentsAndResult) {
+  MemoCache cache(16, "(JI)D");
+  EXPECT_TRUE(cache.returnsWide());
+
+  LocalVariables a(3);
+  LocalVariables b(3);
+  a.setLong(0, 1LL << 40U);
+  a.setInt(2, 1);
+  b.setLong(0, 2LL << 40U);
+  b.setInt(2, 1);
+  EXPECT_NE(cache.makeKey(a), cache.makeKey(b));
+
+  cache.insert(cache.makeKey(a), {.d = 2.5});
+  EXPECT_DOUBLE_EQ(cache.lookup(cache.makeKey(a))->d, 2.5);
+  EXPECT_FALSE(cache.lookup(cache.makeKey(b)).has_value());
+}
+
+TEST(MemoCacheTest, CapacityIsBoundedAndEvicts) {
+  MemoCache cache(3, "(I)I");
+  EXPECT_EQ(cache.getCapacity(), 4U);  // rounded up to a power of two
+
+  LocalVariables args(1);
+  for (Jint i = 0; i < 100; i++) {
+    args.setInt(0, i);
+    cache.insert(cache.makeKey(args), {.i = i});
+  }
+  // at most one entry per bucket survives
+  EXPECT_GE(cache.getStats().evictions, 96U);
+
+  U8 found = 0;
+  for (Jint i = 0; i < 100; i++) {
+    args.setInt(0, i);
+    if (auto result = cache.lookup(cache.makeKey(args))) {
+      EXPECT_EQ(result->i, i);
+      found++;
+    }
+  }
+  EXPECT_LE(found, 4U);
+  EXPECT_EQ(cache.getStats().hits, found);
+}
+
+TEST(MemoCacheTest, ReinsertingSameKeyIsNotAnEviction) {
+  MemoCache      cache(4, "()I");
+  LocalVariables args(0);
+  cache.insert(cache.makeKey(args), {.i = 1});
+  cache.insert(cache.makeKey(args), {.i = 1});
+  EXPECT_EQ(cache.getStats().evictions, 0U);
+}
+
+TEST(MemoCacheTest, ConcurrentUseNeverReturnsAnotherKeysResult) {
+  constexpr int kThreads = 4;
+  constexpr int kCalls   = 20000;
+  // a few buckets, so that the threads keep overwriting each other's entries
+  MemoCache cache(4, "(I)I");
+
+  std::atomic<int>         wrong{0};
+  std::vector<std::thread> threads;
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&cache, &wrong, t] {
+      LocalVariables args(1);
+      for (int i = 0; i < kCalls; i++) {
+        Jint value = (i * 7 + t) % 64;
+        args.setInt(0, value);
+        auto key = cache.makeKey(args);
+        if (auto result = cache.lookup(key)) {
+          if (result->i != value * 3) {
+            wrong++;
+          }
+        } else {
+          cache.insert(key, {.i = value * 3});
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  EXPECT_EQ(wrong.load(), 0);
+  auto stats = cache.getStats();
+  EXPECT_EQ(stats.hits + stats.misses, U8{kThreads} * kCalls);
+}
+
+}  // namespace jvm::runtime
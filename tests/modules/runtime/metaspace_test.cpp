@@ -0,0 +1,74 @@
+#include "runtime/metaspace.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace jvm;
+
+namespace {
+
+struct Counted {
+  explicit Counted(std::vector<int>& destroyed, int id) : destroyed_(destroyed), id_(id) {}
+  Counted(const Counted&)            = delete;
+  Counted(Counted&&)                 = delete;
+  Counted& operator=(const Counted&) = delete;
+  Counted& operator=(Counted&&)      = delete;
+  ~Counted() { destroyed_.push_back(id_); }
+
+  std::vector<int>& destroyed_;
+  int               id_;
+};
+
+}  // namespace
+
+TEST(MetaspaceTest, AllocatesAlignedAndContiguous) {
+  runtime::Metaspace metaspace;
+  EXPECT_EQ(metaspace.getReservedBytes(), 0);
+
+  auto* byte  = metaspace.allocate<char>();
+  auto* words = metaspace.allocate<std::uint64_t>(4);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(words) % alignof(std::uint64_t), 0);  // NOLINT
+  // both come from the first chunk
+  EXPECT_LT(reinterpret_cast<char*>(words) - byte, 16);  // NOLINT
+  EXPECT_EQ(metaspace.getUsedBytes(), 1 + 4 * sizeof(std::uint64_t));
+  EXPECT_GT(metaspace.getReservedBytes(), 0);
+}
+
+TEST(MetaspaceTest, AlignsOverAlignedTypes) {
+  struct alignas(64) Line {
+    char bytes[64];  // NOLINT(*-avoid-c-arrays)
+  };
+  runtime::Metaspace metaspace;
+  metaspace.allocate<char>();
+  auto* lines = metaspace.allocate<Line>(3);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(lines) % 64, 0);  // NOLINT
+  // past the first chunk
+  auto* more = metaspace.allocate<Line>(1024);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(more) % 64, 0);  // NOLINT
+}
+
+TEST(MetaspaceTest, GrowsForLargeRequests) {
+  runtime::Metaspace metaspace;
+  auto*              small = metaspace.allocate<char>(16);
+  auto*              large = metaspace.allocate<char>(1024 * 1024);
+  large[1024 * 1024 - 1]   = 'x';
+  small[0]                 = 'y';
+  EXPECT_GE(metaspace.getReservedBytes(), 1024 * 1024 + 16);
+  EXPECT_EQ(metaspace.getUsedBytes(), 1024 * 1024 + 16);
+}
+
+TEST(MetaspaceTest, DestroysObjectsMostRecentFirst) {
+  std::vector<int> destroyed;
+  {
+    runtime::Metaspace metaspace;
+    metaspace.create<Counted>(destroyed, 1);
+    metaspace.create<Counted>(destroyed, 2);
+    auto* name = metaspace.create<std::string>(64, 'a');
+    EXPECT_EQ(name->size(), 64);
+    EXPECT_TRUE(destroyed.empty());
+  }
+  EXPECT_EQ(destroyed, (std::vector<int>{2, 1}));
+}
@@ -4,10 +4,13 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <vector>
 
 #include "class_loader/class_loader.h"
 #include "runtime/klass.h"
+#include "runtime/symbol.h"
 
 using namespace jvm;
 
@@ -82,6 +85,35 @@ TEST_F(MethodAreaTest, GetClassReturnsNullptrForNonExistent) {
   EXPECT_EQ(klass, nullptr) << "Non-existent class should return nullptr";
 }
 
+TEST_F(MethodAreaTest, RejectsDuplicateClass) {
+  std::string class_name = "tests.data.java.HelloWorld";
+  auto*       klass      = loader_->loadClass(class_name);
+  ASSERT_NE(klass, nullptr);
+
+  // the first definition stays; the caller learns that its own was dropped
+  auto& method_area = runtime::MethodArea::getInstance();
+  EXPECT_FALSE(method_area.addClass(std::make_pair(loader_.get(), class_name),
+                                    std::make_pair(klass, nullptr)));
+  EXPECT_EQ(method_area.getClass(loader_.get(), class_name), klass);
+  EXPECT_EQ(method_area.getClasses(loader_.get()), std::vector<runtime::Klass*>{klass});
+}
+
+TEST_F(MethodAreaTest, RemoveClass) {
+  auto* derived = loader_->loadClass("tests.data.java.KlassTestDerived");
+  ASSERT_NE(derived, nullptr);
+  auto* base = derived->getSuperClass();
+
+  auto& method_area = runtime::MethodArea::getInstance();
+  method_area.removeClass(loader_.get(), "tests.data.java.KlassTestDerived");
+  EXPECT_EQ(method_area.getClass(loader_.get(), "tests.data.java.KlassTestDerived"), nullptr);
+  EXPECT_EQ(method_area.getClasses(loader_.get()), std::vector<runtime::Klass*>{base});
+  EXPECT_EQ(method_area.size(), 1U);
+
+  // removing an unknown class does nothing
+  method_area.removeClass(loader_.get(), "tests.data.java.KlassTestDerived");
+  EXPECT_EQ(method_area.size(), 1U);
+}
+
 TEST_F(MethodAreaTest, DifferentClassLoadersSameClassName) {
   // Create two different class loaders
   auto loader1 = std::make_unique<class_loader::ClassLoader>(nullptr, classpath_list_);
@@ -108,3 +140,82 @@ TEST_F(MethodAreaTest, DifferentClassLoadersSameClassName) {
   EXPECT_NE(method_area.getClass(id1), method_area.getClass(id2))
     << "Different class loaders should create different class instances";
 }
+
+TEST_F(MethodAreaTest, PerLoaderView) {
+  auto other = std::make_unique<class_loader::ClassLoader>(nullptr, classpath_list_);
+
+  // KlassTestDerived defines its superclass first
+  auto* derived = loader_->loadClass("tests.data.java.KlassTestDerived");
+  auto* hello   = other->loadClass("tests.data.java.HelloWorld");
+  ASSERT_NE(derived, nullptr);
+  ASSERT_NE(hello, nullptr);
+
+  auto& method_area = runtime::MethodArea::getInstance();
+  EXPECT_EQ(method_area.getClasses(loader_.get()),
+            (std::vector<runtime::Klass*>{derived->getSuperClass(), derived}));
+  EXPECT_EQ(method_area.getClasses(other.get()), std::vector<runtime::Klass*>{hello});
+  EXPECT_EQ(method_area.size(), 3U);
+
+  std::string_view name = "tests.data.java.HelloWorld";
+  EXPECT_EQ(method_area.getClass(other.get(), name), hello);
+  EXPECT_EQ(method_area.getClass(loader_.get(), name), nullptr);
+}
+
+TEST_F(MethodAreaTest, ConcurrentLoaders) {
+  constexpr int                                           kThreads = 8;
+  std::vector<std::unique_ptr<class_loader::ClassLoader>> loaders;
+  for (int i = 0; i < kThreads; i++) {
+    loaders.push_back(std::make_unique<class_loader::ClassLoader>(nullptr, classpath_list_));
+  }
+
+  // every thread defines classes through its own loader while the others look theirs up
+  std::vector<runtime::Klass*> klasses(kThreads);
+  std::vector<std::thread>     threads;
+  for (int i = 0; i < kThreads; i++) {
+    threads.emplace_back([&, i] {
+      klasses[i] = loaders[i]->loadClass("tests.data.java.KlassTestDerived");
+      loaders[i]->loadClass("tests.data.java.HelloWorld");
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  auto& method_area = runtime::MethodArea::getInstance();
+  EXPECT_EQ(method_area.size(), 3U * kThreads);
+  for (int i = 0; i < kThreads; i++) {
+    ASSERT_NE(klasses[i], nullptr);
+    EXPECT_EQ(method_area.getClass(loaders[i].get(), "tests.data.java.KlassTestDerived"),
+              klasses[i]);
+    EXPECT_EQ(method_area.getClasses(loaders[i].get()).size(), 3U);
+  }
+}
+
+TEST_F(MethodAreaTest, UnloadsClassesWithTheirLoader) {
+  auto& method_area = runtime::MethodArea::getInstance();
+  auto* kept        = loader_->loadClass("tests.data.java.HelloWorld");
+  ASSERT_NE(kept, nullptr);
+
+  // short-lived loaders, as plugins or generated code would create them: the metadata of each
+  // is released with it, so nothing grows from one round to the next
+  size_t symbols = 0;
+  for (int round = 0; round < 3; round++) {
+    auto plugin = std::make_unique<class_loader::ClassLoader>(nullptr, classpath_list_);
+    ASSERT_NE(plugin->loadClass("tests.data.java.KlassTestDerived"), nullptr);
+    ASSERT_NE(plugin->loadClass("tests.data.java.HelloWorld"), nullptr);
+    EXPECT_EQ(method_area.size(), 4U);
+
+    plugin.reset();
+    EXPECT_EQ(method_area.size(), 1U);
+    if (round == 0) {
+      symbols = runtime::SymbolTable::getInstance().size();
+    }
+    EXPECT_EQ(runtime::SymbolTable::getInstance().size(), symbols);
+  }
+
+  // the surviving loader's classes are untouched
+  EXPECT_EQ(method_area.getClass(loader_.get(), "tests.data.java.HelloWorld"), kept);
+  EXPECT_EQ(method_area.getClasses(loader_.get()), std::vector<runtime::Klass*>{kept});
+  EXPECT_EQ(method_area.unloadClasses(loader_.get()), 1U);
+  EXPECT_EQ(method_area.size(), 0U);
+}
@@ -0,0 +1,76 @@
+#include "runtime/stack.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "class_loader/class_loader.h"
+#include "runtime/klass.h"
+#include "runtime/method_area.h"
+
+using namespace jvm;
+
+namespace {
+
+class StackTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    loader_ = std::make_unique<class_loader::ClassLoader>(
+      nullptr, std::vector<std::string>{TEST_CLASS_PATH});
+    runtime::MethodArea::getInstance().reset();
+    method_ = loader_->loadClass("tests.data.java.KlassTestData")->findMethod("<init>", "()V");
+    ASSERT_NE(method_, nullptr);
+  }
+
+  // pushes frames until the stack refuses one; returns how many fit
+  size_t fill(runtime::Stack& stack) {
+    size_t pushed = 0;
+    while (stack.push(runtime::Frame(method_))) {
+      pushed++;
+    }
+    return pushed;
+  }
+
+  std::unique_ptr<class_loader::ClassLoader> loader_;
+  runtime::Method*                           method_{nullptr};
+};
+
+}  // namespace
+
+TEST_F(StackTest, PushAndPop) {
+  runtime::Stack stack(64 * 1024);
+  EXPECT_TRUE(stack.empty());
+  EXPECT_TRUE(stack.push(runtime::Frame(method_)));
+  EXPECT_EQ(stack.size(), 1);
+  EXPECT_EQ(stack.top().getMethod(), method_);
+  stack.pop();
+  EXPECT_TRUE(stack.empty());
+  EXPECT_THROW(stack.pop(), std::runtime_error);
+}
+
+TEST_F(StackTest, OverflowIsBoundedBySize) {
+  runtime::Stack stack(64 * 1024);
+  size_t         pushed = fill(stack);
+  EXPECT_EQ(pushed, 64 * 1024 / sizeof(runtime::Frame));
+  EXPECT_EQ(stack.size(), pushed);
+}
+
+TEST_F(StackTest, YellowZoneGivesRoomToHandleOverflow) {
+  runtime::Stack stack(64 * 1024);
+  fill(stack);
+  // the zone is open now, a few more frames fit while the error is handled
+  EXPECT_TRUE(stack.push(runtime::Frame(method_)));
+  stack.pop();
+}
+
+TEST_F(StackTest, ReguardAfterUnwinding) {
+  runtime::Stack stack(64 * 1024);
+  size_t         first = fill(stack);
+  while (stack.size() > first / 2) {
+    stack.pop();
+  }
+  stack.reguard();
+  EXPECT_EQ(fill(stack), first - first / 2);
+}
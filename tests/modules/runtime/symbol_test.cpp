@@ -0,0 +1,113 @@
+#include "runtime/symbol.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace jvm::runtime {
+
+TEST(SymbolTableTest, InternReturnsSameSymbol) {
+  auto&       table = SymbolTable::getInstance();
+  const auto* a     = table.intern("SymbolTableTest.same");
+  std::string copy  = "SymbolTableTest.same";
+  const auto* b     = table.intern(copy);
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a->view(), "SymbolTableTest.same");
+  EXPECT_EQ(a->size(), copy.size());
+  EXPECT_NE(a, table.intern("SymbolTableTest.other"));
+}
+
+TEST(SymbolTableTest, LookupDoesNotIntern) {
+  auto& table = SymbolTable::getInstance();
+  EXPECT_EQ(table.lookup("SymbolTableTest.neverInterned"), nullptr);
+  EXPECT_EQ(table.lookup("SymbolTableTest.neverInterned"), nullptr);
+
+  const auto* symbol = table.intern("SymbolTableTest.interned");
+  EXPECT_EQ(table.lookup("SymbolTableTest.interned"), symbol);
+}
+
+TEST(SymbolTableTest, DataIsNulTerminated) {
+  const auto* symbol = SymbolTable::getInstance().intern(std::string_view("(II)Iextra", 5));
+  EXPECT_EQ(symbol->view(), "(II)I");
+  EXPECT_STREQ(symbol->data(), "(II)I");
+  EXPECT_EQ(std::strlen(symbol->data()), symbol->size());
+}
+
+TEST(SymbolTableTest, EmptyAndLongStrings) {
+  auto&       table = SymbolTable::getInstance();
+  const auto* empty = table.intern("");
+  EXPECT_EQ(empty->size(), 0U);
+  EXPECT_EQ(table.intern(""), empty);
+
+  // bigger than an arena chunk
+  std::string big(100 * 1024, 'x');
+  const auto* symbol = table.intern(big);
+  EXPECT_EQ(symbol->view(), big);
+  EXPECT_GE(table.getArenaBytes(), big.size());
+}
+
+TEST(SymbolTableTest, PurgeReclaimsUnreferencedSymbols) {
+  auto&       table = SymbolTable::getInstance();
+  const auto* kept  = table.intern("SymbolTableTest.kept");
+  const auto* twice = table.intern("SymbolTableTest.twice");
+  table.intern("SymbolTableTest.twice");
+  SymbolTable::release(twice);
+  SymbolTable::release(table.intern("SymbolTableTest.dropped"));
+  table.purge();
+  EXPECT_EQ(table.lookup("SymbolTableTest.kept"), kept);
+  EXPECT_EQ(table.lookup("SymbolTableTest.twice"), twice);
+  EXPECT_EQ(table.lookup("SymbolTableTest.dropped"), nullptr);
+}
+
+TEST(SymbolTableTest, FreshNamesReuseStorage) {
+  // classes generated with a new name each time, loaded and unloaded again and again
+  auto& table = SymbolTable::getInstance();
+  auto  round = [&table](int i) {
+    const auto* symbol = table.intern("SymbolTableTest.Generated$" + std::to_string(100000 + i));
+    SymbolTable::release(symbol);
+    table.purge();
+  };
+  // until every shard has storage of that size to spare
+  for (int i = 0; i < 1000; i++) {
+    round(i);
+  }
+  size_t symbols     = table.size();
+  size_t arena_bytes = table.getArenaBytes();
+  for (int i = 1000; i < 10000; i++) {
+    round(i);
+  }
+  EXPECT_EQ(table.size(), symbols);
+  EXPECT_EQ(table.getArenaBytes(), arena_bytes);
+}
+
+TEST(SymbolTableTest, ConcurrentInternAgrees) {
+  constexpr int kThreads = 8;
+  constexpr int kNames   = 500;
+
+  std::vector<std::vector<const Symbol*>> results(kThreads);
+  std::vector<std::thread>                threads;
+  threads.reserve(kThreads);
+  for (int t = 0; t < kThreads; t++) {
+    threads.emplace_back([&results, t] {
+      auto& table = SymbolTable::getInstance();
+      for (int i = 0; i < kNames; i++) {
+        results[t].push_back(table.intern("SymbolTableTest.concurrent" + std::to_string(i)));
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (int t = 1; t < kThreads; t++) {
+    EXPECT_EQ(results[t], results[0]);
+  }
+  for (int i = 0; i < kNames; i++) {
+    EXPECT_EQ(results[0][i]->view(), "SymbolTableTest.concurrent" + std::to_string(i));
+  }
+}
+
+}  // namespace jvm::runtime
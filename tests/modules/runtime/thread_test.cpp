@@ -0,0 +1,81 @@
+#include "runtime/thread.h"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "class_loader/class_loader.h"
+#include "runtime/klass.h"
+#include "runtime/method_area.h"
+#include "runtime/well_known_classes.h"
+
+using namespace jvm;
+
+namespace {
+
+class ThreadTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    loader_ = std::make_unique<class_loader::ClassLoader>(
+      nullptr, std::vector<std::string>{TEST_CLASS_PATH});
+    runtime::MethodArea::getInstance().reset();
+    method_ = loader_->loadClass("tests.data.java.KlassTestData")->findMethod("add", "(II)I");
+    ASSERT_NE(method_, nullptr);
+  }
+
+  runtime::Throwable* newThrowable(runtime::Thread& thread, std::string message) {
+    return thread.newThrowable(
+      runtime::getWellKnownClass(runtime::WellKnownClass::kArithmeticException),
+      std::move(message));
+  }
+
+  std::unique_ptr<class_loader::ClassLoader> loader_;
+  runtime::Method*                           method_{nullptr};
+};
+
+}  // namespace
+
+TEST_F(ThreadTest, FreesThrowablesNothingRefersTo) {
+  // caught and dropped, as a loop validating its input would
+  runtime::Thread thread;
+  for (int i = 0; i < 10000; i++) {
+    thread.setPendingException(newThrowable(thread, "/ by zero"));
+    thread.clearPendingException();
+  }
+  EXPECT_LE(thread.getThrowableCount(), 64U);
+}
+
+TEST_F(ThreadTest, KeepsReachableThrowables) {
+  runtime::Thread thread;
+  ASSERT_TRUE(thread.pushFrame(runtime::Frame(method_)));
+  auto& frame = thread.getCurrentFrame();
+
+  auto* in_local = newThrowable(thread, "local");
+  frame.getLocalVariables().setRef(1, static_cast<runtime::Object*>(in_local));
+  auto* on_stack = newThrowable(thread, "operand");
+  frame.getOperandStack().pushRef(static_cast<runtime::Object*>(on_stack));
+  auto* pinned = newThrowable(thread, "static");
+  pinned->pin();
+  auto* pending = newThrowable(thread, "pending");
+  thread.setPendingException(pending);
+
+  for (int i = 0; i < 1000; i++) {
+    newThrowable(thread, "garbage");
+  }
+  EXPECT_LE(thread.getThrowableCount(), 64U);
+  EXPECT_EQ(in_local->getMessage(), "local");
+  EXPECT_EQ(on_stack->getMessage(), "operand");
+  EXPECT_EQ(pinned->getMessage(), "static");
+  EXPECT_EQ(pending->getMessage(), "pending");
+
+  // once the frame is gone and the exception handled, only the pinned one stays
+  thread.popFrame();
+  thread.clearPendingException();
+  for (int i = 0; i < 1000; i++) {
+    newThrowable(thread, "garbage");
+  }
+  EXPECT_LE(thread.getThrowableCount(), 64U);
+  EXPECT_EQ(pinned->getMessage(), "static");
+}
@@ -0,0 +1,101 @@
+#include "runtime/trivial_method.h"
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "engine/opcode.h"
+
+namespace jvm::runtime {
+
+using namespace jvm::engine;  // NOLINT(google-build-using-namespace)
+using Kind = TrivialMethod::Kind;
+
+namespace {
+
+// takes the code as a braced list
+TrivialMethod match(const std::vector<U1>& code, U2 arg_slot_count) {
+  return TrivialMethod::match(code, arg_slot_count);
+}
+
+}  // namespace
+
+TEST(TrivialMethodTest, IntConstant) {
+  auto trivial = match({ICONST_M1, IRETURN}, 0);
+  EXPECT_EQ(trivial.kind, Kind::kValue);
+  EXPECT_FALSE(trivial.wide);
+  EXPECT_FALSE(trivial.lhs.is_arg);
+  EXPECT_EQ(trivial.lhs.constant.i, -1);
+
+  EXPECT_EQ(match({BIPUSH, 0x80, IRETURN}, 0).lhs.constant.i, -128);
+  EXPECT_EQ(match({SIPUSH, 0x03, 0xE8, IRETURN}, 0).lhs.constant.i, 1000);
+}
+
+TEST(TrivialMethodTest, WideConstant) {
+  auto trivial = match({LCONST_1, LRETURN}, 0);
+  EXPECT_EQ(trivial.kind, Kind::kValue);
+  EXPECT_TRUE(trivial.wide);
+  EXPECT_EQ(trivial.lhs.constant.l, 1);
+
+  EXPECT_EQ(match({DCONST_1, DRETURN}, 2).lhs.constant.d, 1.0);
+}
+
+TEST(TrivialMethodTest, ReturnArgument) {
+  auto trivial = match({ILOAD_1, IRETURN}, 2);
+  EXPECT_EQ(trivial.kind, Kind::kValue);
+  EXPECT_TRUE(trivial.lhs.is_arg);
+  EXPECT_EQ(trivial.lhs.arg_slot, 1);
+
+  EXPECT_EQ(match({ALOAD, 3, ARETURN}, 4).lhs.arg_slot, 3);
+  EXPECT_EQ(match({LLOAD_0, LRETURN}, 2).kind, Kind::kValue);
+}
+
+TEST(TrivialMethodTest, IntBinaryOp) {
+  auto add = match({ILOAD_0, ILOAD_1, IADD, IRETURN}, 2);
+  EXPECT_EQ(add.kind, Kind::kIntBinaryOp);
+  EXPECT_EQ(add.opcode, IADD);
+  EXPECT_EQ(add.lhs.arg_slot, 0);
+  EXPECT_EQ(add.rhs.arg_slot, 1);
+
+  auto inc = match({ILOAD_0, ICONST_1, IADD, IRETURN}, 1);
+  EXPECT_EQ(inc.kind, Kind::kIntBinaryOp);
+  EXPECT_TRUE(inc.lhs.is_arg);
+  EXPECT_FALSE(inc.rhs.is_arg);
+  EXPECT_EQ(inc.rhs.constant.i, 1);
+}
+
+TEST(TrivialMethodTest, StaticGetter) {
+  auto getter = match({GETSTATIC, 0x01, 0x02, IRETURN}, 0);
+  EXPECT_EQ(getter.kind, Kind::kStaticGetter);
+  EXPECT_EQ(getter.field_index, 0x0102);
+
+  // the interpreter keeps long and double statics in a single slot
+  EXPECT_FALSE(match({GETSTATIC, 0x00, 0x01, LRETURN}, 0).isTrivial());
+}
+
+TEST(TrivialMethodTest, RejectsOtherShapes) {
+  // may throw
+  EXPECT_FALSE(match({ILOAD_0, ILOAD_1, IDIV, IRETURN}, 2).isTrivial());
+  // two operators
+  EXPECT_FALSE(match({ILOAD_0, ILOAD_1, IADD, ILOAD_2, IADD, IRETURN}, 3).isTrivial());
+  // return type does not match the pushed value
+  EXPECT_FALSE(match({ICONST_0, LRETURN}, 0).isTrivial());
+  // long operands are not int operators
+  EXPECT_FALSE(match({LLOAD_0, LLOAD_2, LADD, LRETURN}, 4).isTrivial());
+  // reads a local that is not an argument
+  EXPECT_FALSE(match({ILOAD_1, IRETURN}, 1).isTrivial());
+  EXPECT_FALSE(match({LLOAD_1, LRETURN}, 2).isTrivial());
+  // trailing code, truncated code, no code
+  EXPECT_FALSE(match({ICONST_0, IRETURN, NOP}, 0).isTrivial());
+  EXPECT_FALSE(match({SIPUSH, 0x00}, 0).isTrivial());
+  EXPECT_FALSE(match({}, 0).isTrivial());
+  // void methods are never trivial
+  EXPECT_FALSE(match({RETURN}, 0).isTrivial());
+}
+
+TEST(TrivialMethodTest, RejectsTooManyArguments) {
+  EXPECT_TRUE(match({ICONST_0, IRETURN}, TrivialMethod::kMaxArgSlots).isTrivial());
+  EXPECT_FALSE(match({ICONST_0, IRETURN}, TrivialMethod::kMaxArgSlots + 1).isTrivial());
+}
+
+}  // namespace jvm::runtime
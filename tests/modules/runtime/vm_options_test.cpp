@@ -0,0 +1,82 @@
+#include "runtime/vm_options.h"
+
+#include <gtest/gtest.h>
+
+namespace jvm::runtime {
+
+TEST(VMOptionsTest, ParseThreadStackSize) {
+  VMOptions options;
+  EXPECT_TRUE(options.parse("-Xss512k"));
+  EXPECT_EQ(options.thread_stack_size, 512 * 1024);
+  EXPECT_TRUE(options.parse("-Xss4M"));
+  EXPECT_EQ(options.thread_stack_size, 4 * 1024 * 1024);
+  EXPECT_TRUE(options.parse("-Xss65536"));
+  EXPECT_EQ(options.thread_stack_size, 65536);
+}
+
+TEST(VMOptionsTest, MalformedThreadStackSize) {
+  VMOptions options;
+  EXPECT_THROW(options.parse("-Xss"), std::invalid_argument);
+  EXPECT_THROW(options.parse("-Xss12q"), std::invalid_argument);
+  EXPECT_THROW(options.parse("-Xss0"), std::invalid_argument);
+  // more than a size_t holds once scaled
+  EXPECT_THROW(options.parse("-Xss99999999999g"), std::invalid_argument);
+  EXPECT_THROW(options.parse("-Xss18014398509481984k"), std::invalid_argument);
+}
+
+TEST(VMOptionsTest, ParseMemoization) {
+  VMOptions options;
+  EXPECT_FALSE(options.memoize_pure_methods);
+  EXPECT_TRUE(options.parse("-XX:+MemoizePureMethods"));
+  EXPECT_TRUE(options.memoize_pure_methods);
+  EXPECT_TRUE(options.parse("-XX:-MemoizePureMethods"));
+  EXPECT_FALSE(options.memoize_pure_methods);
+  EXPECT_TRUE(options.parse("-XX:MemoCacheSize=64"));
+  EXPECT_EQ(options.memo_cache_size, 64);
+
+  EXPECT_THROW(options.parse("-XX:MemoCacheSize=0"), std::invalid_argument);
+  EXPECT_THROW(options.parse("-XX:MemoCacheSize=4k"), std::invalid_argument);
+}
+
+TEST(VMOptionsTest, ParseFlattenMemberTables) {
+  VMOptions options;
+  EXPECT_FALSE(options.flatten_member_tables);
+  EXPECT_TRUE(options.parse("-XX:+FlattenMemberTables"));
+  EXPECT_TRUE(options.flatten_member_tables);
+  EXPECT_TRUE(options.parse("-XX:-FlattenMemberTables"));
+  EXPECT_FALSE(options.flatten_member_tables);
+}
+
+TEST(VMOptionsTest, ParseParallelClassLoading) {
+  VMOptions options;
+  EXPECT_TRUE(options.parallel_class_loading);
+  EXPECT_EQ(options.class_loading_threads, 0U);
+  EXPECT_TRUE(options.parse("-XX:-ParallelClassLoading"));
+  EXPECT_FALSE(options.parallel_class_loading);
+  EXPECT_TRUE(options.parse("-XX:ClassLoadingThreads=3"));
+  EXPECT_EQ(options.class_loading_threads, 3U);
+  EXPECT_TRUE(options.parse("-XX:ClassLoadingThreads=0"));
+  EXPECT_EQ(options.class_loading_threads, 0U);
+  EXPECT_THROW(options.parse("-XX:ClassLoadingThreads=-1"), std::invalid_argument);
+  EXPECT_THROW(options.parse("-XX:ClassLoadingThreads="), std::invalid_argument);
+}
+
+TEST(VMOptionsTest, ParseShare) {
+  VMOptions options;
+  EXPECT_EQ(options.share_mode, ShareMode::kAuto);
+  EXPECT_TRUE(options.shared_archive_file.empty());
+  EXPECT_TRUE(options.parse("-Xshare:dump"));
+  EXPECT_EQ(options.share_mode, ShareMode::kDump);
+  EXPECT_TRUE(options.parse("-Xshare:off"));
+  EXPECT_EQ(options.share_mode, ShareMode::kOff);
+  EXPECT_TRUE(options.parse("-XX:SharedArchiveFile=/tmp/app.jsa"));
+  EXPECT_EQ(options.shared_archive_file, "/tmp/app.jsa");
+  EXPECT_THROW(options.parse("-Xshare:always"), std::invalid_argument);
+}
+
+TEST(VMOptionsTest, UnknownOption) {
+  VMOptions options;
+  EXPECT_FALSE(options.parse("-verbose"));
+}
+
+}  // namespace jvm::runtime